@@ -0,0 +1,1321 @@
+/**
+ * benchmark.c
+ * Leistungsmessungen für die Bibliotheksverwaltung
+ *
+ * Bindet main.c mit gesetztem TEST_MODE ein und misst einzelne Operationen.
+ * Aufruf: ./library_bench [messung]   (ohne Argument werden alle Messungen ausgeführt)
+ *
+ * Kompilieren: gcc -O2 -pthread -o library_bench benchmark.c -lm
+ */
+
+#define TEST_MODE
+#include "main.c"
+
+#include <sys/resource.h>
+
+#define SKALIERT_DATEI "/tmp/books_skaliert.csv" // Erzeugte, vergrößerte CSV-Datei
+#define SKALIERT_SCHNAPPSCHUSS "/tmp/books_skaliert.snap" // Schnappschuss der vergrößerten Datei
+
+/* Datensatz für die Messungen (unabhängig vom Baum gespeichert) */
+typedef struct BenchBuch {
+    uint64_t isbn;
+    char* titel;                  // Eigene Kopie des Titels (mit free freizugeben)
+} BenchBuch;
+
+/**
+ * Liefert eine monotone Zeit in Sekunden
+ */
+double zeitInSekunden() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Einfacher deterministischer Zufallsgenerator (xorshift64), damit jede
+ * Messung dieselbe Reihenfolge verwendet
+ */
+unsigned long long zufallsZustand = 88172645463325252ULL;
+unsigned long long zufallsZahl() {
+    zufallsZustand ^= zufallsZustand << 13;
+    zufallsZustand ^= zufallsZustand >> 7;
+    zufallsZustand ^= zufallsZustand << 17;
+    return zufallsZustand;
+}
+
+/**
+ * Liefert den bisherigen Spitzenwert des belegten Arbeitsspeichers in KiB
+ */
+long spitzenSpeicherKiB() {
+    struct rusage nutzung;
+    getrusage(RUSAGE_SELF, &nutzung);
+    return nutzung.ru_maxrss;
+}
+
+/**
+ * Erzeugt eine gültige ISBN-13 mit dem Präfix 978 aus einer laufenden Nummer
+ */
+void isbnAusNummer(char* isbn, long nummer) {
+    char puffer[32];
+    snprintf(puffer, sizeof(puffer), "978%09ld", nummer % 1000000000L);
+
+    // Prüfziffer: Gewichte abwechselnd 1 und 3
+    int summe = 0;
+    for (int i = 0; i < 12; i++) {
+        summe += (puffer[i] - '0') * (i % 2 == 0 ? 1 : 3);
+    }
+    puffer[12] = (char)('0' + (10 - summe % 10) % 10);
+    puffer[13] = '\0';
+    memcpy(isbn, puffer, LEN_ISBN);
+}
+
+/**
+ * Liest die CSV-Datei über den normalen Ladepfad ein und kopiert alle Bücher
+ * in ISBN-Reihenfolge in ein Array
+ * @param anzahl Ausgabe: Anzahl der Bücher
+ * @return Neu reserviertes Array der Bücher (vom Aufrufer freizugeben)
+ */
+BenchBuch* buecherSortiertLaden(int* anzahl) {
+    csvDateiEinlesen();
+
+    int kapazitaet = 1024;
+    BenchBuch* buecher = malloc(kapazitaet * sizeof(BenchBuch));
+    *anzahl = 0;
+
+    // In-Order-Durchlauf mit eigenem Stapel
+    Buch* stapel[128];
+    int tiefe = 0;
+    Buch* knoten = wurzel;
+    while (knoten != NULL || tiefe > 0) {
+        while (knoten != NULL) {
+            stapel[tiefe++] = knoten;
+            knoten = knotenZeiger(knoten->links);
+        }
+        knoten = stapel[--tiefe];
+
+        if (*anzahl == kapazitaet) {
+            kapazitaet *= 2;
+            buecher = realloc(buecher, kapazitaet * sizeof(BenchBuch));
+        }
+        buecher[*anzahl].isbn = knoten->isbn;
+        buecher[*anzahl].titel = strdup(buchTitel(knoten));
+        (*anzahl)++;
+
+        knoten = knotenZeiger(knoten->rechts);
+    }
+
+    katalogFreigeben();
+    return buecher;
+}
+
+/**
+ * Misst Einfüge- und Suchdauer für eine gegebene Einfügereihenfolge
+ */
+void einfuegenMessen(const char* name, BenchBuch* buecher, int anzahl, BenchBuch* suchReihenfolge) {
+    double start = zeitInSekunden();
+    for (int i = 0; i < anzahl; i++) {
+        wurzel = buchEinfuegen(wurzel, buecher[i].isbn, buecher[i].titel);
+    }
+    double einfuegeZeit = zeitInSekunden() - start;
+
+    int gefunden = 0;
+    start = zeitInSekunden();
+    for (int i = 0; i < anzahl; i++) {
+        if (buchNachIsbnSuchen(wurzel, suchReihenfolge[i].isbn) != NULL) {
+            gefunden++;
+        }
+    }
+    double suchZeit = zeitInSekunden() - start;
+
+    printf("%-12s Höhe %3d  Einfügen %8.1f ns/Buch  Suche %8.1f ns/Buch  (%d/%d gefunden)\n",
+           name, knotenHoehe(wurzel), einfuegeZeit * 1e9 / anzahl, suchZeit * 1e9 / anzahl,
+           gefunden, anzahl);
+
+    katalogFreigeben();
+}
+
+/**
+ * Lädt books.csv in sortierter, umgekehrter und gemischter Reihenfolge
+ */
+void messungEinfuegen() {
+    int anzahl = 0;
+    BenchBuch* sortiert = buecherSortiertLaden(&anzahl);
+
+    BenchBuch* umgekehrt = malloc(anzahl * sizeof(BenchBuch));
+    BenchBuch* gemischt = malloc(anzahl * sizeof(BenchBuch));
+    for (int i = 0; i < anzahl; i++) {
+        umgekehrt[i] = sortiert[anzahl - 1 - i];
+        gemischt[i] = sortiert[i];
+    }
+    for (int i = anzahl - 1; i > 0; i--) {
+        int j = (int)(zufallsZahl() % (unsigned long long)(i + 1));
+        BenchBuch tmp = gemischt[i];
+        gemischt[i] = gemischt[j];
+        gemischt[j] = tmp;
+    }
+
+    printf("\n--- Einfügen und ISBN-Suche (%d Bücher) ---\n", anzahl);
+    einfuegenMessen("sortiert", sortiert, anzahl, gemischt);
+    einfuegenMessen("umgekehrt", umgekehrt, anzahl, gemischt);
+    einfuegenMessen("gemischt", gemischt, anzahl, gemischt);
+
+    for (int i = 0; i < anzahl; i++) {
+        free(sortiert[i].titel);
+    }
+    free(sortiert);
+    free(umgekehrt);
+    free(gemischt);
+}
+
+/**
+ * Größter gemeinsamer Teiler (euklidischer Algorithmus)
+ */
+long ggT(long a, long b) {
+    while (b != 0) {
+        long rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+/**
+ * Schreibt eine CSV-Datei mit faktor Kopien aller Titel aus books.csv unter
+ * fortlaufenden, gültigen ISBNs
+ * @param gemischt Wenn ungleich 0, werden die ISBNs durch Multiplikation mit
+ *                 einer zur Zeilenzahl teilerfremden Zahl vertauscht, sodass
+ *                 die Datei nicht nach ISBN sortiert ist
+ * @return Anzahl der geschriebenen Zeilen
+ */
+long skalierteCsvSchreiben(const char* pfad, int faktor, int gemischt) {
+    int anzahl = 0;
+    BenchBuch* buecher = buecherSortiertLaden(&anzahl);
+
+    FILE* datei = fopen(pfad, "w");
+    if (datei == NULL) {
+        printf("Fehler beim Anlegen von %s\n", pfad);
+        for (int i = 0; i < anzahl; i++) {
+            free(buecher[i].titel);
+        }
+        free(buecher);
+        return 0;
+    }
+
+    fprintf(datei, "\"isbn\",\"title\"\n");
+    long nummer = 0;
+    long gesamt = (long)faktor * anzahl;
+    long multiplikator = 1;
+    if (gemischt && gesamt > 1) {
+        multiplikator = 1000003;
+        while (ggT(multiplikator, gesamt) != 1) {
+            multiplikator += 2;
+        }
+    }
+    char isbn[LEN_ISBN];
+    for (int kopie = 0; kopie < faktor; kopie++) {
+        for (int i = 0; i < anzahl; i++) {
+            isbnAusNummer(isbn, nummer * multiplikator % gesamt);
+            nummer++;
+            fprintf(datei, "\"%s\",\"", isbn);
+            // Anführungszeichen im Titel nach CSV-Regeln verdoppeln
+            for (const char* c = buecher[i].titel; *c; c++) {
+                if (*c == '"') {
+                    fputc('"', datei);
+                }
+                fputc(*c, datei);
+            }
+            fprintf(datei, "\",\"%d\"\n", kopie);
+        }
+    }
+
+    fclose(datei);
+    for (int i = 0; i < anzahl; i++) {
+        free(buecher[i].titel);
+    }
+    free(buecher);
+    return nummer;
+}
+
+/**
+ * Bisheriger CSV-Lader (zeilenweise mit fgets und 1024-Byte-Puffer, ohne
+ * Aufbau des Titel-Index), nur zum Vergleich
+ */
+int csvDateiLadenAlt(const char* pfad) {
+    FILE* datei = fopen(pfad, "r");
+
+    // Prüfen, ob die Datei geöffnet werden konnte
+    if (datei == NULL) {
+        printf("Fehler beim Öffnen der CSV-Datei: %s\n", pfad);
+        return 0;
+    }
+
+    char zeile[1024];  // Puffer für eine Zeile aus der CSV-Datei
+
+    // Die erste Zeile (Header) überspringen
+    if (fgets(zeile, sizeof(zeile), datei) == NULL) {
+        printf("CSV-Datei ist leer oder fehlerhaft\n");
+        fclose(datei);
+        return 0;
+    }
+
+    int anzahlBücher = 0; // Zähler für erfolgreiche Einträge
+
+    // Zeile für Zeile einlesen
+    while (fgets(zeile, sizeof(zeile), datei) != NULL) {
+        char isbn[LEN_ISBN] = "";
+        char titel[sizeof(zeile)] = ""; // Titel werden nicht gekürzt
+
+        // CSV-Format verarbeiten: "isbn","titel",...
+        // Die ISBN ist das erste Feld, der Titel das zweite
+
+        // Verbesserter CSV-Parser zur korrekten Extraktion der Felder
+        int feldNummer = 0;
+        int inAnführungszeichen = 0;
+
+        char tempFeld[sizeof(zeile)] = ""; // Temporärer Puffer für das aktuelle Feld
+        int tempIndex = 0;
+
+        // Zeichen für Zeichen verarbeiten
+        for (int i = 0; zeile[i] != '\0' && zeile[i] != '\n'; i++) {
+            char c = zeile[i];
+
+            if (c == '"') {
+                // Anfang oder Ende von Anführungszeichen
+                inAnführungszeichen = !inAnführungszeichen;
+
+                // Wenn Anführungszeichen geschlossen werden, feld könnte vollständig sein
+                if (!inAnführungszeichen) {
+                    tempFeld[tempIndex] = '\0';
+
+                    if (feldNummer == 0) {
+                        // ISBN speichern
+                        strncpy(isbn, tempFeld, LEN_ISBN - 1);
+                        isbn[LEN_ISBN - 1] = '\0';
+                    } else if (feldNummer == 1) {
+                        // Titel speichern
+                        strcpy(titel, tempFeld);
+
+                        // Nach dem Titel können wir aufhören, wir benötigen keine weiteren Felder
+                        break;
+                    }
+
+                    // Nächstes Feld vorbereiten
+                    feldNummer++;
+                    tempIndex = 0;
+                    tempFeld[0] = '\0';
+                }
+            } else if (inAnführungszeichen) {
+                // Zeichen innerhalb von Anführungszeichen zum temporären Feld hinzufügen
+                if (tempIndex < (int)sizeof(tempFeld) - 1) {
+                    tempFeld[tempIndex++] = c;
+                }
+            }
+        }
+
+        // Buch in den Binärbaum einfügen, wenn die ISBN gültig und der Titel nicht leer ist
+        uint64_t schluessel;
+        if (isbnLesen(isbn, strlen(isbn), &schluessel) && strlen(titel) > 0) {
+            wurzel = buchEinfuegen(wurzel, schluessel, titel);
+            anzahlBücher++;
+        }
+    }
+
+    fclose(datei);
+    return anzahlBücher;
+}
+
+/**
+ * Entfernt eine Datei aus dem Seitencache, damit der nächste Ladevorgang
+ * wie nach einem Neustart von der Platte lesen muss
+ */
+void seitencacheLeeren(const char* pfad) {
+    int datei = open(pfad, O_RDONLY);
+    if (datei >= 0) {
+        fdatasync(datei);
+        posix_fadvise(datei, 0, 0, POSIX_FADV_DONTNEED);
+        close(datei);
+    }
+}
+
+/**
+ * Vergleicht die Ladezeit (kalter Seitencache) des bisherigen zeilenweisen
+ * Laders mit dem abbildenden Lader mit 1, 2, 4 und 8 Threads auf einer um
+ * faktor vergrößerten CSV-Datei (Standard 480, etwa 10 Millionen Zeilen)
+ */
+void messungCsv(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    struct stat info;
+    double megabyte = stat(SKALIERT_DATEI, &info) == 0 ? info.st_size / 1e6 : 0;
+    int threadAnzahlen[] = { 0, 1, 2, 4, 8 };   // 0 = bisheriger Lader
+
+    printf("\n--- CSV laden, kalter Seitencache (%ld Zeilen, %.0f MB, %d Prozessoren) ---\n",
+           zeilen, megabyte, prozessorAnzahl());
+    printf("%-16s %12s %12s %12s %12s\n", "Lader", "Bücher", "Zeit [s]", "MB/s", "ns/Zeile");
+    for (int i = 0; i < (int)(sizeof(threadAnzahlen) / sizeof(threadAnzahlen[0])); i++) {
+        seitencacheLeeren(SKALIERT_DATEI);
+        double start = zeitInSekunden();
+        int geladen = threadAnzahlen[i] == 0 ? csvDateiLadenAlt(SKALIERT_DATEI)
+                                             : csvDatenEinlesenParallel(SKALIERT_DATEI, threadAnzahlen[i]);
+        double zeit = zeitInSekunden() - start;
+
+        char name[32];
+        if (threadAnzahlen[i] == 0) {
+            snprintf(name, sizeof(name), "fgets");
+        } else {
+            snprintf(name, sizeof(name), "mmap, %d Thr.", threadAnzahlen[i]);
+        }
+        printf("%-16s %12d %12.3f %12.1f %12.1f\n", name, geladen, zeit,
+               megabyte / zeit, zeit * 1e9 / (zeilen > 0 ? zeilen : 1));
+        katalogFreigeben();
+    }
+
+    remove(SKALIERT_DATEI);
+}
+
+/**
+ * Vergleicht den Aufbau des Katalogs in einem Schritt (leerer Katalog) mit dem
+ * Einfügen jeder Zeile in den AVL-Baum, jeweils für eine nach ISBN sortierte
+ * und eine gemischte CSV-Datei (Standard faktor 480, etwa 10 Millionen Zeilen).
+ * Für das zeilenweise Einfügen enthält der Katalog vorab ein Platzhalterbuch.
+ */
+void messungMassenaufbau(int faktor) {
+    const char* reihenfolgen[] = { "sortiert", "gemischt" };
+
+    printf("\n--- Katalogaufbau aus CSV (Faktor %d) ---\n", faktor);
+    printf("%-10s %-14s %12s %12s %12s %8s\n", "Datei", "Aufbau", "Zeilen", "Zeit [s]", "ns/Zeile", "Höhe");
+    for (int r = 0; r < 2; r++) {
+        long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, r);
+        for (int zeilenweise = 0; zeilenweise < 2; zeilenweise++) {
+            if (zeilenweise) {
+                wurzel = buchEinfuegen(wurzel, 0, "Platzhalter");
+            }
+            double start = zeitInSekunden();
+            int geladen = csvDatenEinlesen(SKALIERT_DATEI);
+            double zeit = zeitInSekunden() - start;
+
+            printf("%-10s %-14s %12d %12.3f %12.1f %8d\n", reihenfolgen[r],
+                   zeilenweise ? "zeilenweise" : "ein Schritt", geladen, zeit,
+                   zeit * 1e9 / (zeilen > 0 ? zeilen : 1), knotenHoehe(wurzel));
+            katalogFreigeben();
+        }
+        remove(SKALIERT_DATEI);
+    }
+}
+
+/**
+ * Vergleicht den Programmstart aus der CSV-Datei (Zerlegen, Baum und Titel-Index)
+ * mit dem Laden des Schnappschusses bei kaltem und warmem Seitencache, jeweils
+ * bis zur ersten beantworteten ISBN-Suche (Standard faktor 480, etwa 10 Millionen Zeilen)
+ */
+void messungSchnappschuss(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    char text[LEN_ISBN];
+    uint64_t isbn = 0;
+    isbnAusNummer(text, zeilen / 2);
+    isbnLesen(text, strlen(text), &isbn);
+    remove(SKALIERT_SCHNAPPSCHUSS);
+
+    printf("\n--- Programmstart mit Schnappschuss (%ld Zeilen) ---\n", zeilen);
+    double start = zeitInSekunden();
+    csvDateiLaden(SKALIERT_DATEI);
+    int gefunden = buchNachIsbnSuchen(wurzel, isbn) != NULL;
+    double csvZeit = zeitInSekunden() - start;
+
+    start = zeitInSekunden();
+    int geschrieben = schnappschussSchreiben(SKALIERT_SCHNAPPSCHUSS, SKALIERT_DATEI);
+    double schreibZeit = zeitInSekunden() - start;
+    katalogFreigeben();
+
+    struct stat info;
+    double megabyte = stat(SKALIERT_SCHNAPPSCHUSS, &info) == 0 ? info.st_size / 1e6 : 0;
+    printf("%-28s %10.3f s  (ISBN-Suche %s)\n", "CSV, Baum und Titel-Index", csvZeit, gefunden ? "ok" : "FEHLER");
+    printf("%-28s %10.3f s  (%.0f MB%s)\n", "Schnappschuss schreiben", schreibZeit, megabyte,
+           geschrieben ? "" : ", FEHLER");
+
+    const char* zustaende[] = { "Schnappschuss, kalt", "Schnappschuss, warm" };
+    for (int warm = 0; warm < 2; warm++) {
+        if (!warm) {
+            seitencacheLeeren(SKALIERT_SCHNAPPSCHUSS);
+        }
+        start = zeitInSekunden();
+        int geladen = schnappschussLaden(SKALIERT_SCHNAPPSCHUSS, SKALIERT_DATEI);
+        gefunden = geladen && buchNachIsbnSuchen(wurzel, isbn) != NULL;
+        double ladeZeit = zeitInSekunden() - start;
+        printf("%-28s %10.3f s  (ISBN-Suche %s)\n", zustaende[warm], ladeZeit, gefunden ? "ok" : "FEHLER");
+        katalogFreigeben();
+    }
+
+    remove(SKALIERT_SCHNAPPSCHUSS);
+    remove(SKALIERT_DATEI);
+}
+
+/**
+ * Misst die ISBN-Suche im Katalog aus einer um faktor vergrößerten CSV-Datei
+ * (Standard 100, etwa 2 Millionen Bücher): Treffer in zufälliger Reihenfolge,
+ * Fehlschläge (ISBN eines vorhandenen Buches mit anderer Prüfziffer) und
+ * Treffer über den Text einschließlich Prüfung und Umwandlung der ISBN
+ */
+void messungIsbnsuche(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 1);
+    csvDatenEinlesen(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+
+    int anzahl = 1000000;
+    uint64_t* treffer = malloc(anzahl * sizeof(uint64_t));
+    uint64_t* fehlschlaege = malloc(anzahl * sizeof(uint64_t));
+    char (*texte)[LEN_ISBN] = malloc(anzahl * sizeof(*texte));
+    for (int i = 0; i < anzahl; i++) {
+        isbnAusNummer(texte[i], (long)(zufallsZahl() % (unsigned long long)(zeilen > 0 ? zeilen : 1)));
+        isbnLesen(texte[i], LEN_ISBN - 1, &treffer[i]);
+        fehlschlaege[i] = treffer[i] / 10 * 10 + (treffer[i] % 10 + 1) % 10;
+    }
+
+    printf("\n--- ISBN-Suche (%ld Bücher, Baumhöhe %d, %d Suchen) ---\n", zeilen, knotenHoehe(wurzel), anzahl);
+    printf("%-28s %12s %12s\n", "Suche", "ns/Suche", "gefunden");
+    const char* namen[] = { "Treffer", "Fehlschlag", "Treffer über Text" };
+    for (int art = 0; art < 3; art++) {
+        int gefunden = 0;
+        double start = zeitInSekunden();
+        for (int i = 0; i < anzahl; i++) {
+            Buch* buch = art == 0 ? buchNachIsbnSuchen(wurzel, treffer[i])
+                       : art == 1 ? buchNachIsbnSuchen(wurzel, fehlschlaege[i])
+                                  : buchNachIsbnTextSuchen(texte[i]);
+            gefunden += buch != NULL;
+        }
+        double zeit = zeitInSekunden() - start;
+        printf("%-28s %12.1f %12d\n", namen[art], zeit * 1e9 / anzahl, gefunden);
+    }
+
+    free(treffer);
+    free(fehlschlaege);
+    free(texte);
+    katalogFreigeben();
+}
+
+/**
+ * Vergleichsfunktion für qsort: aufsteigende Laufzeiten
+ */
+int laufzeitVergleichen(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+/* Verfahren für die exakte ISBN-Suche in den Messungen */
+enum { SUCHE_BAUM, SUCHE_HASH, SUCHE_FOLGE, SUCHE_BINAER, SUCHE_FOLGE_OHNE_VORAUS };
+
+/**
+ * Binäre Suche über die Bücher des Titel-Index (bisheriges titelIndexPosition),
+ * nur zum Vergleich
+ */
+unsigned int binaereUntergrenze(uint64_t isbn) {
+    unsigned int unten = 0;
+    unsigned int oben = titelIndex.anzahlBuecher;
+    while (unten < oben) {
+        unsigned int mitte = unten + (oben - unten) / 2;
+        if (titelIndex.buecher[mitte]->isbn < isbn) {
+            unten = mitte + 1;
+        } else {
+            oben = mitte;
+        }
+    }
+    return unten;
+}
+
+/**
+ * isbnFolgeUntergrenze ohne Vorabladen, nur zum Vergleich
+ */
+unsigned int folgeUntergrenzeOhneVoraus(uint64_t isbn) {
+    size_t k = 1;
+    while (k <= isbnFolge.anzahl) {
+        k = 2 * k + (isbnFolge.schluessel[k] < isbn);
+    }
+    k >>= __builtin_ffsll((long long)~k);
+    return isbnFolge.nummer[k];
+}
+
+/**
+ * Sucht ein Buch mit dem angegebenen Verfahren (SUCHE_...)
+ */
+Buch* mitVerfahrenSuchen(int verfahren, uint64_t isbn) {
+    unsigned int nummer;
+    switch (verfahren) {
+    case SUCHE_HASH:
+        return isbnHashSuchen(isbn);
+    case SUCHE_FOLGE:
+        nummer = isbnFolgeUntergrenze(isbn);
+        break;
+    case SUCHE_BINAER:
+        nummer = binaereUntergrenze(isbn);
+        break;
+    case SUCHE_FOLGE_OHNE_VORAUS:
+        nummer = folgeUntergrenzeOhneVoraus(isbn);
+        break;
+    default:
+        return buchNachIsbnSuchen(wurzel, isbn);
+    }
+    return nummer < titelIndex.anzahlBuecher && titelIndex.buecher[nummer]->isbn == isbn ? titelIndex.buecher[nummer] : NULL;
+}
+
+/**
+ * Misst die Laufzeit jeder einzelnen Suche und gibt Median und 99. Perzentil
+ * aus (abzüglich des Medians einer leeren Zeitmessung)
+ * @param verfahren Suchverfahren (SUCHE_...)
+ * @param isbns Zu suchende ISBNs (alle vorhanden)
+ * @param anzahl Anzahl der Suchen
+ */
+void suchLatenzMessen(const char* name, int verfahren, const uint64_t* isbns, int anzahl, long long leer) {
+    long long* laufzeiten = malloc(anzahl * sizeof(long long));
+    int gefunden = 0;
+    for (int i = 0; i < anzahl; i++) {
+        struct timespec vorher, nachher;
+        clock_gettime(CLOCK_MONOTONIC, &vorher);
+        Buch* buch = mitVerfahrenSuchen(verfahren, isbns[i]);
+        clock_gettime(CLOCK_MONOTONIC, &nachher);
+        gefunden += buch != NULL && buch->isbn == isbns[i];
+        laufzeiten[i] = (nachher.tv_sec - vorher.tv_sec) * 1000000000LL + (nachher.tv_nsec - vorher.tv_nsec) - leer;
+    }
+    qsort(laufzeiten, anzahl, sizeof(long long), laufzeitVergleichen);
+    printf("%-30s %10lld %10lld %12d\n", name, laufzeiten[anzahl / 2], laufzeiten[anzahl - anzahl / 100 - 1], gefunden);
+    free(laufzeiten);
+}
+
+/**
+ * Misst die Laufzeit einer leeren Zeitmessung (Median)
+ */
+long long leereZeitmessung() {
+    int anzahl = 1000000;
+    long long* leer = malloc(anzahl * sizeof(long long));
+    for (int i = 0; i < anzahl; i++) {
+        struct timespec vorher, nachher;
+        clock_gettime(CLOCK_MONOTONIC, &vorher);
+        clock_gettime(CLOCK_MONOTONIC, &nachher);
+        leer[i] = (nachher.tv_sec - vorher.tv_sec) * 1000000000LL + (nachher.tv_nsec - vorher.tv_nsec);
+    }
+    qsort(leer, anzahl, sizeof(long long), laufzeitVergleichen);
+    long long median = leer[anzahl / 2];
+    free(leer);
+    return median;
+}
+
+/**
+ * Erzeugt anzahl zufällige ISBNs vorhandener Bücher einer skalierten CSV-Datei
+ * @param zeilen Anzahl der Zeilen der Datei
+ * @return Neu reserviertes Array (vom Aufrufer freizugeben)
+ */
+uint64_t* zufaelligeIsbns(long zeilen, int anzahl) {
+    uint64_t* isbns = malloc(anzahl * sizeof(uint64_t));
+    char text[LEN_ISBN];
+    for (int i = 0; i < anzahl; i++) {
+        isbnAusNummer(text, (long)(zufallsZahl() % (unsigned long long)zeilen));
+        isbnLesen(text, LEN_ISBN - 1, &isbns[i]);
+    }
+    return isbns;
+}
+
+/**
+ * Vergleicht die exakte ISBN-Suche im Baum und im Hashindex auf einem Katalog,
+ * der größer als der Cache ist (Standard faktor 480, etwa 10 Millionen Bücher):
+ * Median und 99. Perzentil je Suche für wenige, ständig wiederholte ISBNs (warm)
+ * und für zufällige ISBNs aus dem gesamten Katalog (kalt)
+ */
+void messungHashsuche(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 1);
+    csvDatenEinlesen(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+    double start = zeitInSekunden();
+    isbnHashAufbauen();
+    double aufbauZeit = zeitInSekunden() - start;
+
+    int anzahl = 1000000;
+    long long leerMedian = leereZeitmessung();
+
+    // Warm: 1024 ISBNs immer wieder; kalt: zufällig aus allen Büchern
+    uint64_t* warm = malloc(anzahl * sizeof(uint64_t));
+    uint64_t* haeufige = zufaelligeIsbns(zeilen, 1024);
+    uint64_t* kalt = zufaelligeIsbns(zeilen, anzahl);
+    for (int i = 0; i < anzahl; i++) {
+        warm[i] = haeufige[i % 1024];
+    }
+    free(haeufige);
+
+    printf("\n--- Exakte ISBN-Suche: Baum gegen Hashindex (%ld Bücher) ---\n", zeilen);
+    printf("Baumhöhe %d, Hashindex %zu Plätze (%.0f MB, Aufbau %.3f s), leere Zeitmessung %lld ns\n",
+           knotenHoehe(wurzel), isbnHash.maske + 1, (isbnHash.maske + 1) * sizeof(IsbnHashEintrag) / 1e6,
+           aufbauZeit, leerMedian);
+    printf("%-30s %10s %10s %12s\n", "Suche", "p50 [ns]", "p99 [ns]", "gefunden");
+    suchLatenzMessen("Baum, warm", SUCHE_BAUM, warm, anzahl, leerMedian);
+    suchLatenzMessen("Hashindex, warm", SUCHE_HASH, warm, anzahl, leerMedian);
+    suchLatenzMessen("Baum, kalt", SUCHE_BAUM, kalt, anzahl, leerMedian);
+    suchLatenzMessen("Hashindex, kalt", SUCHE_HASH, kalt, anzahl, leerMedian);
+
+    free(warm);
+    free(kalt);
+    katalogFreigeben();
+}
+
+/**
+ * Vergleicht geordnete ISBN-Suchen (erstes Buch mit mindestens der ISBN) auf
+ * einem Katalog größer als der Cache (Standard faktor 480, etwa 10 Millionen
+ * Bücher): Baum, binäre Suche über den Titel-Index und die ISBN-Folge in
+ * Eytzinger-Reihenfolge mit und ohne Vorabladen; der Hashindex zum Vergleich.
+ * Angegeben werden die mittlere Zeit je Suche bei unabhängigen Suchen
+ * hintereinander sowie Median und 99. Perzentil je einzelner Suche.
+ */
+void messungEytzinger(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 1);
+    csvDatenEinlesen(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+    titelIndexAufbauen();
+    isbnHashAufbauen();
+
+    int anzahl = 1000000;
+    long long leerMedian = leereZeitmessung();
+    uint64_t* isbns = zufaelligeIsbns(zeilen, anzahl);
+
+    printf("\n--- Geordnete ISBN-Suche (%ld Bücher, ISBN-Folge %.0f MB) ---\n", zeilen,
+           (isbnFolge.anzahl + 1) * (sizeof(uint64_t) + sizeof(unsigned int)) / 1e6);
+    printf("%-30s %12s\n", "Suche (hintereinander)", "ns/Suche");
+    const char* namen[] = { "Baum", "Hashindex (nur exakt)", "ISBN-Folge", "Binäre Suche Titel-Index",
+                            "ISBN-Folge ohne Vorabladen" };
+    int reihenfolge[] = { SUCHE_BAUM, SUCHE_BINAER, SUCHE_FOLGE_OHNE_VORAUS, SUCHE_FOLGE, SUCHE_HASH };
+    for (int v = 0; v < 5; v++) {
+        int verfahren = reihenfolge[v];
+        int gefunden = 0;
+        double start = zeitInSekunden();
+        for (int i = 0; i < anzahl; i++) {
+            gefunden += mitVerfahrenSuchen(verfahren, isbns[i]) != NULL;
+        }
+        double zeit = zeitInSekunden() - start;
+        printf("%-30s %12.1f%s\n", namen[verfahren], zeit * 1e9 / anzahl, gefunden == anzahl ? "" : "  (FEHLER)");
+    }
+
+    printf("%-30s %10s %10s %12s\n", "Suche (einzeln)", "p50 [ns]", "p99 [ns]", "gefunden");
+    suchLatenzMessen("Baum", SUCHE_BAUM, isbns, anzahl, leerMedian);
+    suchLatenzMessen("Binäre Suche Titel-Index", SUCHE_BINAER, isbns, anzahl, leerMedian);
+    suchLatenzMessen("ISBN-Folge", SUCHE_FOLGE, isbns, anzahl, leerMedian);
+    suchLatenzMessen("Hashindex (nur exakt)", SUCHE_HASH, isbns, anzahl, leerMedian);
+
+    free(isbns);
+    katalogFreigeben();
+}
+
+/**
+ * Lädt books.csv in 100-facher Größe und misst Ladezeit und Spitzenspeicher
+ */
+void messungLaden(int faktor) {
+    long zeilen = skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    long speicherVorher = spitzenSpeicherKiB();
+
+    printf("\n--- Katalog laden (%ld Zeilen, Faktor %d) ---\n", zeilen, faktor);
+    double start = zeitInSekunden();
+    int geladen = csvDateiLaden(SKALIERT_DATEI);
+    double ladeZeit = zeitInSekunden() - start;
+    long speicherNachher = spitzenSpeicherKiB();
+
+    start = zeitInSekunden();
+    katalogFreigeben();
+    double freigabeZeit = zeitInSekunden() - start;
+
+    printf("Ladezeit %.3f s (%.0f ns/Buch), Freigabe %.3f ms\n",
+           ladeZeit, ladeZeit * 1e9 / (geladen > 0 ? geladen : 1), freigabeZeit * 1e3);
+    printf("Spitzenspeicher %ld MiB (vor dem Laden %ld MiB)\n",
+           speicherNachher / 1024, speicherVorher / 1024);
+
+    remove(SKALIERT_DATEI);
+}
+
+/**
+ * Misst die Dauer einzelner Titelsuchen mit Trigramm-Index und mit
+ * vollständiger Baumtraversierung auf einem vergrößerten Katalog
+ */
+void messungTitelsuche(int faktor) {
+    skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    csvDateiLaden(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+
+    const char* suchbegriffe[] = { "science", "harry potter", "mathématiques", "introduction to management", "xyzzy", "zzq" };
+    char isbnListe[MAXRESULTS][LEN_ISBN];
+
+    printf("\n--- Titelsuche (%zu Bücher) ---\n", buchArena.anzahlKnoten);
+    printf("%-28s %8s %14s %14s\n", "Suchbegriff", "Treffer", "Index [ms]", "Baum [ms]");
+    for (int i = 0; i < (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0])); i++) {
+        int wiederholungen = 20;
+        int treffer = 0;
+
+        double start = zeitInSekunden();
+        for (int w = 0; w < wiederholungen; w++) {
+            treffer = trigrammTitelSuchen(suchbegriffe[i], isbnListe, MAXRESULTS);
+        }
+        double indexZeit = (zeitInSekunden() - start) / wiederholungen;
+
+        start = zeitInSekunden();
+        for (int w = 0; w < 3; w++) {
+            büchernachTitelSuchenIterativ(wurzel, suchbegriffe[i], isbnListe, MAXRESULTS);
+        }
+        double baumZeit = (zeitInSekunden() - start) / 3;
+
+        printf("%-28s %8d %14.3f %14.3f\n", suchbegriffe[i], treffer, indexZeit * 1e3, baumZeit * 1e3);
+    }
+
+    katalogFreigeben();
+}
+
+/**
+ * Misst den Durchsatz der Suchkerne (skalar, SSE2, AVX2) beim vollständigen
+ * Durchlauf des flachen Titelpuffers mit Suchbegriffen ohne Treffer
+ */
+void messungFlachsuche(int faktor) {
+    skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    csvDateiLaden(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+
+    const char* suchbegriffe[] = { "xyzzy", "jq", "introduction to zzq" };
+    const char* stufenNamen[] = { "skalar", "SSE2", "AVX2" };
+    SimdStufe hoechsteStufe = simdStufeErmitteln();
+    int wiederholungen = 5;
+
+    printf("\n--- Flache Titelsuche (%zu Bücher, %.1f MiB Titel) ---\n",
+           buchArena.anzahlKnoten, titelPool.laenge / (1024.0 * 1024.0));
+    printf("%-22s %8s %12s %12s\n", "Suchbegriff", "Kern", "Zeit [ms]", "GB/s");
+    for (int i = 0; i < (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0])); i++) {
+        Suchmuster muster;
+        musterVorbereiten(&muster, suchbegriffe[i]);
+
+        for (int stufe = SIMD_SKALAR; stufe <= (int)hoechsteStufe; stufe++) {
+            simdStufeSetzen((SimdStufe)stufe);
+            size_t treffer = 0;
+            double start = zeitInSekunden();
+            for (int w = 0; w < wiederholungen; w++) {
+                treffer = musterFindenVektor(&muster, titelPool.daten, titelPool.laenge);
+            }
+            double zeit = (zeitInSekunden() - start) / wiederholungen;
+
+            printf("%-22s %8s %12.2f %12.2f%s\n", suchbegriffe[i], stufenNamen[stufe], zeit * 1e3,
+                   titelPool.laenge / zeit / 1e9, treffer == KEIN_TREFFER ? "" : "  (TREFFER!)");
+        }
+
+        double start = zeitInSekunden();
+        char isbnListe[MAXRESULTS][LEN_ISBN];
+        büchernachTitelSuchenIterativ(wurzel, suchbegriffe[i], isbnListe, MAXRESULTS);
+        double baumZeit = zeitInSekunden() - start;
+        printf("%-22s %8s %12.2f\n", suchbegriffe[i], "Baum", baumZeit * 1e3);
+    }
+
+    simdStufeSetzen(hoechsteStufe);
+    katalogFreigeben();
+}
+
+/**
+ * Misst den Durchsatz der flachen Titelsuche mit 1, 2, 4, 8 und 16 Threads.
+ * Die Suchbegriffe haben keine oder nur späte Treffer, sodass jeweils (fast)
+ * der gesamte Titelpuffer durchsucht wird.
+ */
+void messungParallel(int faktor) {
+    skalierteCsvSchreiben(SKALIERT_DATEI, faktor, 0);
+    csvDateiLaden(SKALIERT_DATEI);
+    remove(SKALIERT_DATEI);
+
+    const char* suchbegriffe[] = { "xyzzy", "jq", "introduction to zzq", "zq" };
+    int anzahlBegriffe = (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0]));
+    int threadAnzahlen[] = { 1, 2, 4, 8, 16 };
+    int wiederholungen = 5;
+    char isbnListe[MAXRESULTS][LEN_ISBN];
+
+    printf("\n--- Parallele Titelsuche (%zu Bücher, %.1f MiB Titel, %ld Prozessoren) ---\n",
+           buchArena.anzahlKnoten, titelPool.laenge / (1024.0 * 1024.0), sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%8s %14s %12s %12s\n", "Threads", "Suchen/s", "GB/s", "Speedup");
+
+    double basis = 0;
+    for (int t = 0; t < (int)(sizeof(threadAnzahlen) / sizeof(threadAnzahlen[0])); t++) {
+        suchThreadsSetzen(threadAnzahlen[t]);
+        flachTitelSuchen(suchbegriffe[0], isbnListe, MAXRESULTS); // Pool starten
+
+        double start = zeitInSekunden();
+        for (int w = 0; w < wiederholungen; w++) {
+            for (int i = 0; i < anzahlBegriffe; i++) {
+                flachTitelSuchen(suchbegriffe[i], isbnListe, MAXRESULTS);
+            }
+        }
+        double zeit = zeitInSekunden() - start;
+        double suchenProSekunde = wiederholungen * anzahlBegriffe / zeit;
+        if (t == 0) {
+            basis = suchenProSekunde;
+        }
+
+        printf("%8d %14.1f %12.2f %12.2f\n", threadAnzahlen[t], suchenProSekunde,
+               suchenProSekunde * titelPool.laenge / 1e9, suchenProSekunde / basis);
+    }
+
+    suchPoolBeenden();
+    katalogFreigeben();
+}
+
+/* Auftrag eines Threads der Group-Commit-Messung */
+typedef struct GruppenAuftrag {
+    int nummer;                   // Nummer des Threads (bestimmt die ISBNs)
+    int vorgaenge;                // Auszuführende Ausleihen und Rückgaben
+    double latenz;                // Summe der Wartezeiten in Sekunden
+} GruppenAuftrag;
+
+/**
+ * Thread der Group-Commit-Messung: Leiht als eigener Leser abwechselnd ein
+ * Buch aus und gibt es wieder zurück, jeder Vorgang wartet auf das fsync
+ */
+void* gruppenAuftragAusfuehren(void* argument) {
+    GruppenAuftrag* auftrag = (GruppenAuftrag*)argument;
+    uint64_t isbn = 9780000000000ULL + (uint64_t)auftrag->nummer * 10;
+    for (int i = 0; i < auftrag->vorgaenge; i++) {
+        double start = zeitInSekunden();
+        if (i % 2 == 0) {
+            ausleiheAnlegen(isbn, 1700000000 + i, (unsigned int)auftrag->nummer);
+        } else {
+            rueckgabeBuchen((unsigned int)auftrag->nummer, isbn);
+        }
+        auftrag->latenz += zeitInSekunden() - start;
+    }
+    return NULL;
+}
+
+/**
+ * Misst Vorgänge pro Sekunde, fsync-Aufrufe und mittlere Wartezeit beim
+ * gleichzeitigen Ausleihen aus vielen Threads für verschiedene Sammelfenster
+ * des Group Commit. Die Ausleihdateien liegen in einem temporären Verzeichnis.
+ */
+void messungGruppenCommit(int anzahlThreads) {
+    char verzeichnis[] = "/tmp/bib_gruppenXXXXXX";
+    char bisher[4096];
+    if (anzahlThreads < 1 || anzahlThreads > 256 || getcwd(bisher, sizeof(bisher)) == NULL ||
+        mkdtemp(verzeichnis) == NULL || chdir(verzeichnis) != 0) {
+        printf("Fehler: Temporäres Verzeichnis konnte nicht angelegt werden!\n");
+        return;
+    }
+    ausleihenLaden();
+
+    unsigned int fenster[] = { 0, 50, 200, 1000, 5000 };
+    int threadAnzahlen[] = { 1, anzahlThreads };
+    double dauer = 1.0;           // Ungefähre Dauer je Messung in Sekunden
+    pthread_t threads[256];
+    GruppenAuftrag auftraege[256];
+
+    printf("\n--- Group Commit beim Ausleihen (Vorgang = Ausleihe oder Rückgabe mit fsync) ---\n");
+    printf("%8s %12s %14s %14s %14s\n", "Threads", "Fenster [µs]", "Vorgänge/s", "Vorgänge/fsync", "Wartezeit [µs]");
+    for (int t = 0; t < 2; t++) {
+        for (int f = 0; f < (int)(sizeof(fenster) / sizeof(fenster[0])); f++) {
+            if (threadAnzahlen[t] == 1 && f > 0) {
+                break;
+            }
+            journalFensterSetzen(fenster[f]);
+
+            // Vorgänge je Thread aus einer kurzen Probemessung für die gewünschte Dauer abschätzen
+            int vorgaenge = 16;
+            double zeit = 0;
+            unsigned long long schreibvorgaenge = 0;
+            for (int runde = 0; runde < 2; runde++) {
+                if (runde == 1) {
+                    vorgaenge = (int)(vorgaenge * dauer / (zeit > 1e-6 ? zeit : 1e-6));
+                    vorgaenge = vorgaenge < 16 ? 16 : vorgaenge - vorgaenge % 2;
+                }
+                unsigned long long vorher = gruppenCommit.schreibvorgaenge;
+                double start = zeitInSekunden();
+                for (int i = 0; i < threadAnzahlen[t]; i++) {
+                    auftraege[i].nummer = i;
+                    auftraege[i].vorgaenge = vorgaenge;
+                    auftraege[i].latenz = 0;
+                    pthread_create(&threads[i], NULL, gruppenAuftragAusfuehren, &auftraege[i]);
+                }
+                for (int i = 0; i < threadAnzahlen[t]; i++) {
+                    pthread_join(threads[i], NULL);
+                }
+                zeit = zeitInSekunden() - start;
+                schreibvorgaenge = gruppenCommit.schreibvorgaenge - vorher;
+            }
+
+            double latenz = 0;
+            for (int i = 0; i < threadAnzahlen[t]; i++) {
+                latenz += auftraege[i].latenz;
+            }
+            double gesamt = (double)vorgaenge * threadAnzahlen[t];
+            printf("%8d %12u %14.0f %14.1f %14.1f\n", threadAnzahlen[t], fenster[f], gesamt / zeit,
+                   gesamt / (double)(schreibvorgaenge > 0 ? schreibvorgaenge : 1), latenz / gesamt * 1e6);
+        }
+    }
+
+    journalFensterSetzen(0);
+    ausleihenFreigeben();
+    remove(AUSLEIHDATEI);
+    remove(AUSLEIHJOURNAL);
+    if (chdir(bisher) != 0 || rmdir(verzeichnis) != 0) {
+        printf("Hinweis: Temporäres Verzeichnis %s wurde nicht entfernt.\n", verzeichnis);
+    }
+}
+
+/**
+ * Vergleicht das Laden von anzahl Ausleihen (Standard 1 Million) aus der
+ * früheren Textdatei und aus der binären Ausleihdatei, jeweils mit kaltem und
+ * warmem Seitencache, sowie den anschließenden Aufbau des Ausleih-Index.
+ */
+void messungAusleihLaden(int anzahl) {
+    char verzeichnis[] = "/tmp/bib_ausleihenXXXXXX";
+    char bisher[4096];
+    if (anzahl < 1 || getcwd(bisher, sizeof(bisher)) == NULL || mkdtemp(verzeichnis) == NULL ||
+        chdir(verzeichnis) != 0) {
+        printf("Fehler: Temporäres Verzeichnis konnte nicht angelegt werden!\n");
+        return;
+    }
+
+    // Textdatei im früheren Format schreiben (ISBNs aus 20 000 Büchern, aufsteigende Daten)
+    FILE* text = fopen(AUSLEIHTEXTDATEI, "w");
+    char isbn[LEN_ISBN];
+    for (int i = 0; text != NULL && i < anzahl; i++) {
+        isbnAusNummer(isbn, (long)(zufallsZahl() % 20000));
+        fprintf(text, "%s\n%lld\n", isbn, 1700000000LL + i);
+    }
+    if (text == NULL || fclose(text) != 0) {
+        printf("Fehler: Textdatei konnte nicht geschrieben werden!\n");
+        return;
+    }
+
+    // Übernahme in die binäre Ausleihdatei
+    double start = zeitInSekunden();
+    ausleihenLaden();
+    double umwandlung = zeitInSekunden() - start;
+    ausleihJournalSchliessen();
+    struct stat textInfo;
+    struct stat binaerInfo;
+    stat(AUSLEIHTEXTDATEI, &textInfo);
+    stat(AUSLEIHDATEI, &binaerInfo);
+
+    printf("\n--- Laden von %d Ausleihen ---\n", anzahlAusleihen);
+    printf("Übernahme der Textdatei (Zerlegen, Index, Schreiben mit fsync): %.1f ms\n", umwandlung * 1e3);
+    printf("%-8s %10s %14s %14s %14s\n", "Format", "MiB", "kalt [ms]", "warm [ms]", "+ Index [ms]");
+    const char* namen[] = { "Text", "binär" };
+    const char* pfade[] = { AUSLEIHTEXTDATEI, AUSLEIHDATEI };
+    double groessen[] = { (double)textInfo.st_size, (double)binaerInfo.st_size };
+    for (int format = 0; format < 2; format++) {
+        double zeiten[2];
+        double indexZeit = 0;
+        for (int warm = 0; warm < 2; warm++) {
+            if (!warm) {
+                seitencacheLeeren(pfade[format]);
+            }
+            unsigned long long groesse;
+            unsigned long long pruefsumme;
+            start = zeitInSekunden();
+            int ok = format == 0 ? ausleihTextdateiLesen(pfade[format], &groesse, &pruefsumme) == 1
+                                 : ausleihDateiLesen(pfade[format], &groesse, &pruefsumme) == 1;
+            zeiten[warm] = zeitInSekunden() - start;
+            start = zeitInSekunden();
+            ok = ok && ausleihIndexAufbauen();
+            indexZeit = zeitInSekunden() - start;
+            if (!ok || anzahlAusleihen != anzahl) {
+                printf("Fehler: Nur %d Ausleihen geladen!\n", anzahlAusleihen);
+            }
+        }
+        printf("%-8s %10.1f %14.1f %14.1f %14.1f\n", namen[format], groessen[format] / (1024.0 * 1024.0),
+               zeiten[0] * 1e3, zeiten[1] * 1e3, indexZeit * 1e3);
+    }
+
+    ausleihenFreigeben();
+    remove(AUSLEIHTEXTDATEI);
+    remove(AUSLEIHDATEI);
+    remove(AUSLEIHJOURNAL);
+    if (chdir(bisher) != 0 || rmdir(verzeichnis) != 0) {
+        printf("Hinweis: Temporäres Verzeichnis %s wurde nicht entfernt.\n", verzeichnis);
+    }
+}
+
+/**
+ * Misst die Leserkonten mit durchschnittlich drei Ausleihen je Leser: Aufbau des
+ * Leser-Index, Speichern und Laden der Ausleihen und Aufzählen eines Kontos
+ * über den Leser-Index gegen das Durchsuchen aller Ausleihen
+ */
+void messungLeserkonten(int anzahlLeser) {
+    char verzeichnis[] = "/tmp/bib_leserXXXXXX";
+    char bisher[4096];
+    if (anzahlLeser < 1 || getcwd(bisher, sizeof(bisher)) == NULL || mkdtemp(verzeichnis) == NULL ||
+        chdir(verzeichnis) != 0) {
+        printf("Fehler: Temporäres Verzeichnis konnte nicht angelegt werden!\n");
+        return;
+    }
+
+    int anzahl = anzahlLeser * 3;
+    anzahlAusleihen = 0;
+    for (int i = 0; i < anzahl; i++) {
+        if (!ausleiheAnhaengen(9780000000000ULL + zufallsZahl() % 20000, 1700000000 + i,
+                               (unsigned int)(zufallsZahl() % (uint64_t)anzahlLeser))) {
+            printf("Fehler: Zu wenig Speicher!\n");
+            return;
+        }
+    }
+
+    // Index nach ISBN allein gegen beide Indizes
+    double start = zeitInSekunden();
+    ausleihIndexLeeren(&ausleihIndex);
+    for (int i = 0; i < anzahl; i++) {
+        ausleihIndexEintragen(&ausleihIndex, i);
+    }
+    double nurIsbn = zeitInSekunden() - start;
+    start = zeitInSekunden();
+    ausleihIndexAufbauen();
+    double beide = zeitInSekunden() - start;
+
+    start = zeitInSekunden();
+    int gespeichert = ausleihenSpeichern();
+    double speichern = zeitInSekunden() - start;
+    ausleihJournalSchliessen();
+    start = zeitInSekunden();
+    ausleihenLaden();
+    double laden = zeitInSekunden() - start;
+    ausleihJournalSchliessen();
+
+    printf("\n--- Leserkonten (%d Ausleihen von %zu Lesern) ---\n", anzahlAusleihen, leserIndex.anzahl);
+    if (!gespeichert || anzahlAusleihen != anzahl) {
+        printf("Fehler: Nur %d Ausleihen geladen!\n", anzahlAusleihen);
+    }
+    printf("Index aufbauen: nur ISBN %.1f ms, ISBN und Leser %.1f ms\n", nurIsbn * 1e3, beide * 1e3);
+    printf("Speichern (mit fsync) %.1f ms, Laden mit beiden Indizes %.1f ms\n", speichern * 1e3, laden * 1e3);
+    printf("Leser-Index: %.1f MiB (Tabelle %zu Plätze, 8 Byte Verkettung je Ausleihe)\n",
+           ((double)(leserIndex.maske + 1) * sizeof(AusleihIndexEintrag) + (double)leserIndex.kapazitaet * 2 * sizeof(int)) /
+               (1024.0 * 1024.0),
+           leserIndex.maske + 1);
+
+    // Konto aufzählen: über den Leser-Index und durch Durchsuchen aller Ausleihen
+    int abfragenIndex = 100000;
+    int abfragenSuche = 20;
+    long long summe = 0;
+    start = zeitInSekunden();
+    for (int a = 0; a < abfragenIndex; a++) {
+        unsigned int leser = (unsigned int)(zufallsZahl() % (uint64_t)anzahlLeser);
+        for (int i = leserAusleiheErste(leser); i >= 0; i = leserAusleiheNaechste(i)) {
+            summe += ausleihen[i].ausleihDatum & 1;
+        }
+    }
+    double zeitIndex = (zeitInSekunden() - start) / abfragenIndex;
+    start = zeitInSekunden();
+    for (int a = 0; a < abfragenSuche; a++) {
+        unsigned int leser = (unsigned int)(zufallsZahl() % (uint64_t)anzahlLeser);
+        for (int i = 0; i < anzahlAusleihen; i++) {
+            if (ausleihen[i].leser == leser) {
+                summe += ausleihen[i].ausleihDatum & 1;
+            }
+        }
+    }
+    double zeitSuche = (zeitInSekunden() - start) / abfragenSuche;
+    printf("Konto aufzählen: Leser-Index %.0f ns, alle Ausleihen durchsuchen %.1f ms (Prüfsumme %lld)\n",
+           zeitIndex * 1e9, zeitSuche * 1e3, summe);
+
+    ausleihenFreigeben();
+    remove(AUSLEIHDATEI);
+    remove(AUSLEIHJOURNAL);
+    if (chdir(bisher) != 0 || rmdir(verzeichnis) != 0) {
+        printf("Hinweis: Temporäres Verzeichnis %s wurde nicht entfernt.\n", verzeichnis);
+    }
+}
+
+/**
+ * Misst die Suche überfälliger Ausleihen über den Fälligkeits-Heap gegen das
+ * Durchsuchen und Sortieren aller Ausleihen sowie die Kosten des Heaps beim
+ * Ausleihen und Zurückgeben
+ */
+void messungMahnliste(int anzahl) {
+    if (anzahl < 1) {
+        return;
+    }
+
+    // Ausleihdaten gleichmäßig über ein Jahr verteilt, in zufälliger Reihenfolge
+    time_t basis = 1700000000;
+    time_t jahr = 365 * 24 * 60 * 60;
+    anzahlAusleihen = 0;
+    for (int i = 0; i < anzahl; i++) {
+        if (!ausleiheAnhaengen(9780000000000ULL + zufallsZahl() % 20000, basis + (time_t)(zufallsZahl() % (uint64_t)jahr),
+                               (unsigned int)(zufallsZahl() % 100000))) {
+            printf("Fehler: Zu wenig Speicher!\n");
+            return;
+        }
+    }
+
+    double start = zeitInSekunden();
+    faelligkeitenAufbauen();
+    double aufbau = zeitInSekunden() - start;
+
+    // Austragen und wieder Eintragen an zufälligen Stellen (wie Rückgabe und Ausleihe)
+    int vorgaenge = 1000000;
+    start = zeitInSekunden();
+    for (int i = 0; i < vorgaenge; i++) {
+        int position = (int)(zufallsZahl() % (uint64_t)anzahl);
+        faelligkeitAustragen(position);
+        faelligkeitEintragen(position);
+    }
+    double aendern = (zeitInSekunden() - start) / vorgaenge;
+
+    printf("\n--- Mahnliste (%d Ausleihen über ein Jahr) ---\n", anzahlAusleihen);
+    printf("Heap aufbauen %.1f ms, Austragen und Eintragen %.0f ns je Ausleihe\n", aufbau * 1e3, aendern * 1e9);
+    printf("%12s %16s %22s\n", "überfällig", "Heap [µs]", "alle durchsuchen [µs]");
+
+    double anteile[] = { 0.00001, 0.001, 0.01, 0.1, 1.0 };
+    int* alle = malloc((size_t)anzahl * sizeof(int));
+    for (int a = 0; alle != NULL && a < 5; a++) {
+        time_t stichtag = basis + (time_t)AUSLEIHDAUER * 24 * 60 * 60 + (time_t)(anteile[a] * (double)jahr);
+        int wiederholungen = anteile[a] < 0.01 ? 100 : 5;
+
+        int* positionen = NULL;
+        int gefunden = 0;
+        start = zeitInSekunden();
+        for (int w = 0; w < wiederholungen; w++) {
+            free(positionen);
+            gefunden = ueberfaelligeSuchen(stichtag, &positionen);
+        }
+        double zeitHeap = (zeitInSekunden() - start) / wiederholungen;
+        free(positionen);
+
+        int gezaehlt = 0;
+        start = zeitInSekunden();
+        for (int w = 0; w < wiederholungen; w++) {
+            gezaehlt = 0;
+            for (int i = 0; i < anzahlAusleihen; i++) {
+                if (ausleiheFaelligkeit(&ausleihen[i]) < stichtag) {
+                    alle[gezaehlt++] = i;
+                }
+            }
+            qsort(alle, (size_t)gezaehlt, sizeof(int), faelligkeitVergleichen);
+        }
+        double zeitSuche = (zeitInSekunden() - start) / wiederholungen;
+        if (gefunden != gezaehlt) {
+            printf("Fehler: Heap liefert %d statt %d überfällige Ausleihen!\n", gefunden, gezaehlt);
+        }
+        printf("%12d %16.1f %22.1f\n", gefunden, zeitHeap * 1e6, zeitSuche * 1e6);
+    }
+    free(alle);
+
+    ausleihenFreigeben();
+}
+
+/**
+ * Bisherige Implementierung von enthältTeilstring (kopiert und klein geschrieben
+ * beide Strings pro Aufruf), nur zum Vergleich
+ */
+int enthältTeilstringAlt(const char* quelle, const char* teilstring) {
+    if (teilstring == NULL || teilstring[0] == '\0') {
+        return 1;
+    }
+    if (quelle == NULL || quelle[0] == '\0') {
+        return 0;
+    }
+
+    char quelleKlein[MAX_TITEL_LAENGE];
+    char teilstringKlein[MAX_TITEL_LAENGE];
+    strncpy(quelleKlein, quelle, MAX_TITEL_LAENGE - 1);
+    quelleKlein[MAX_TITEL_LAENGE - 1] = '\0';
+    strncpy(teilstringKlein, teilstring, MAX_TITEL_LAENGE - 1);
+    teilstringKlein[MAX_TITEL_LAENGE - 1] = '\0';
+    zuKleinbuchstaben(quelleKlein);
+    zuKleinbuchstaben(teilstringKlein);
+    return strstr(quelleKlein, teilstringKlein) != NULL;
+}
+
+/**
+ * Misst die Kosten des Teilstring-Vergleichs pro Titel: bisheriges Verfahren
+ * gegen einmal vorbereitetes Suchmuster mit Horspool-Suche
+ */
+void messungTeilstring() {
+    int anzahl = 0;
+    BenchBuch* buecher = buecherSortiertLaden(&anzahl);
+    size_t* laengen = malloc(anzahl * sizeof(size_t));
+    for (int i = 0; i < anzahl; i++) {
+        laengen[i] = strlen(buecher[i].titel);
+    }
+
+    const char* suchbegriffe[] = { "e", "science", "Introduction to Management", "xyzzy" };
+    int durchlaeufe = 20;
+
+    printf("\n--- Teilstring-Vergleich pro Titel (%d Titel) ---\n", anzahl);
+    printf("%-28s %8s %14s %14s\n", "Suchbegriff", "Treffer", "alt [ns]", "neu [ns]");
+    for (int s = 0; s < (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0])); s++) {
+        int trefferAlt = 0;
+        double start = zeitInSekunden();
+        for (int d = 0; d < durchlaeufe; d++) {
+            for (int i = 0; i < anzahl; i++) {
+                trefferAlt += enthältTeilstringAlt(buecher[i].titel, suchbegriffe[s]);
+            }
+        }
+        double zeitAlt = zeitInSekunden() - start;
+
+        int trefferNeu = 0;
+        start = zeitInSekunden();
+        for (int d = 0; d < durchlaeufe; d++) {
+            Suchmuster muster;
+            musterVorbereiten(&muster, suchbegriffe[s]);
+            for (int i = 0; i < anzahl; i++) {
+                trefferNeu += musterSuchen(&muster, buecher[i].titel, laengen[i]);
+            }
+        }
+        double zeitNeu = zeitInSekunden() - start;
+
+        printf("%-28s %8d %14.1f %14.1f%s\n", suchbegriffe[s], trefferNeu / durchlaeufe,
+               zeitAlt * 1e9 / ((double)anzahl * durchlaeufe), zeitNeu * 1e9 / ((double)anzahl * durchlaeufe),
+               trefferAlt == trefferNeu ? "" : "  (ABWEICHUNG!)");
+    }
+
+    for (int i = 0; i < anzahl; i++) {
+        free(buecher[i].titel);
+    }
+    free(buecher);
+    free(laengen);
+}
+
+int main(int argc, char* argv[]) {
+    const char* messung = argc > 1 ? argv[1] : "alle";
+    int alle = strcmp(messung, "alle") == 0;
+
+    if (alle || strcmp(messung, "einfuegen") == 0) {
+        messungEinfuegen();
+    }
+    if (alle || strcmp(messung, "teilstring") == 0) {
+        messungTeilstring();
+    }
+    if (alle || strcmp(messung, "csv") == 0) {
+        messungCsv(argc > 2 ? atoi(argv[2]) : 480);
+    }
+    if (alle || strcmp(messung, "massenaufbau") == 0) {
+        messungMassenaufbau(argc > 2 ? atoi(argv[2]) : 480);
+    }
+    if (alle || strcmp(messung, "schnappschuss") == 0) {
+        messungSchnappschuss(argc > 2 ? atoi(argv[2]) : 480);
+    }
+    if (alle || strcmp(messung, "isbnsuche") == 0) {
+        messungIsbnsuche(argc > 2 ? atoi(argv[2]) : 100);
+    }
+    if (alle || strcmp(messung, "hashsuche") == 0) {
+        messungHashsuche(argc > 2 ? atoi(argv[2]) : 480);
+    }
+    if (alle || strcmp(messung, "eytzinger") == 0) {
+        messungEytzinger(argc > 2 ? atoi(argv[2]) : 480);
+    }
+    if (alle || strcmp(messung, "laden") == 0) {
+        messungLaden(argc > 2 ? atoi(argv[2]) : 100);
+    }
+    if (alle || strcmp(messung, "titelsuche") == 0) {
+        messungTitelsuche(argc > 2 ? atoi(argv[2]) : 100);
+    }
+    if (alle || strcmp(messung, "flachsuche") == 0) {
+        messungFlachsuche(argc > 2 ? atoi(argv[2]) : 100);
+    }
+    if (alle || strcmp(messung, "parallel") == 0) {
+        messungParallel(argc > 2 ? atoi(argv[2]) : 100);
+    }
+    if (alle || strcmp(messung, "ausleihladen") == 0) {
+        messungAusleihLaden(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+    if (alle || strcmp(messung, "gruppencommit") == 0) {
+        messungGruppenCommit(argc > 2 ? atoi(argv[2]) : 16);
+    }
+    if (alle || strcmp(messung, "leserkonten") == 0) {
+        messungLeserkonten(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+    if (alle || strcmp(messung, "mahnliste") == 0) {
+        messungMahnliste(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+
+    return 0;
+}
@@ -9,387 +9,5051 @@
 
  #include <stdio.h>
  #include <stdlib.h>
+ #include <stddef.h>
+ #include <stdint.h>
  #include <string.h>
  #include <ctype.h>
+ #include <errno.h>
+ #include <limits.h>
  #include <time.h>
+ #include <pthread.h>
+ #include <stdatomic.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+
+ #if defined(__x86_64__) || defined(__i386__)
+ #include <immintrin.h>
+ #define SIMD_VERFUEGBAR 1          // SSE2-/AVX2-Suchkerne werden mitkompiliert
+ #endif
 
  /* Konstanten */
- #define LEN_ISBN 14          // Maximale Länge einer ISBN
+ #define LEN_ISBN 14          // Maximale Länge einer ISBN als Text (13 Ziffern und '\0')
  #define MAXRESULTS 10        // Maximale Anzahl von Suchergebnissen
- #define MAX_TITEL_LAENGE 256 // Maximale Länge eines Buchtitels
- #define MAX_AUSLEIHEN 100    // Maximale Anzahl von ausgeliehenen Büchern
+ #define MAX_TITEL_LAENGE 256 // Maximale Länge eines Suchbegriffs für Titel
+ #define AUSLEIHEN_START 64   // Anfangskapazität des Ausleihspeichers
  #define AUSLEIHDAUER 28      // Ausleihdauer in Tagen
+ #define MAX_BAUMHOEHE 96     // Obergrenze der AVL-Höhe (1,44 · log2(n) für jede adressierbare Knotenzahl)
+ #define ARENA_BLOCK_BITS 16        // Jeder Block der Buch-Arena fasst 2^16 Knoten
+ #define ARENA_BLOCK_GROESSE (1u << ARENA_BLOCK_BITS)
+ #define KEIN_KNOTEN 0u             // Knotennummer für einen leeren Teilbaum
+ #define TITELPOOL_START 65536      // Anfangsgröße des Titel-Pools in Bytes
+ #define KEIN_TITEL ((size_t)-1)    // Titel-Offset für Ausleihen unbekannter Bücher
+ #define TRIGRAMM_BITS 18           // Der Trigramm-Index verwendet 2^18 Postinglisten
+ #define TRIGRAMM_LISTEN (1u << TRIGRAMM_BITS)
+ #define TRIGRAMM_SELEKTIVITAET 8   // Index nur nutzen, wenn die kürzeste Liste höchstens 1/8 des Katalogs umfasst
+ #define KEIN_TREFFER ((size_t)-1)  // Rückgabewert der Mustersuche, wenn nichts gefunden wurde
+ #define MAX_SUCH_THREADS 16        // Höchstzahl der Threads für die parallele Titelsuche
+ #define PARTITIONEN_PRO_THREAD 4   // Partitionen je Thread, damit schnelle Threads weitere übernehmen
+ #define MAX_LADE_THREADS 64        // Höchstzahl der Threads zum Zerlegen der CSV-Datei
+ #define CSV_MIN_ABSCHNITT (1 << 20) // Mindestgröße eines Abschnitts je Lade-Thread in Bytes
  #define CSV_DATEI "attached_assets/books.csv" // Pfad zur CSV-Datei
- #define AUSLEIHDATEI "ausleihen.txt"          // Datei zum Speichern der Ausleihvorgänge
+ #define AUSLEIHDATEI "ausleihen.dat"          // Binäre Datei zum Speichern der Ausleihvorgänge
+ #define AUSLEIHTEXTDATEI "ausleihen.txt"      // Frühere Textdatei der Ausleihen, wird beim Laden übernommen
+ #define AUSLEIHDATEI_VERSION 1     // Wird bei jeder Änderung des Formats der Ausleihdatei erhöht
+ #define AUSLEIHJOURNAL "ausleihen.log"        // Journal der Ausleihen und Rückgaben seit dem letzten Speichern
+ #define JOURNAL_VERSION 1          // Wird bei jeder Änderung des Journalformats erhöht
+ #define JOURNAL_AUSLEIHE 1         // Art eines Journaleintrags: Ausleihe
+ #define JOURNAL_RUECKGABE 2        // Art eines Journaleintrags: Rückgabe
+ #define JOURNAL_VERDICHTEN_AB 4096 // Mindestanzahl an Journaleinträgen vor dem Verdichten
+ #define JOURNAL_STAPEL_START 64    // Anfangskapazität des Stapels gesammelter Journaleinträge
+ #define JOURNAL_MAX_FENSTER 1000000 // Obergrenze des Sammelfensters beim Group Commit in Mikrosekunden
+ #define SCHNAPPSCHUSS_DATEI "attached_assets/books.snap" // Binärer Schnappschuss des aufgebauten Katalogs
+ #define SCHNAPPSCHUSS_VERSION 2    // Wird bei jeder Änderung des Dateiformats erhöht
+ #define SCHNAPPSCHUSS_ISBN_BREITE 8 // Bytes je ISBN-Schlüssel im Schnappschuss (uint64_t)
+ #define SCHNAPPSCHUSS_BYTEFOLGE 0x01020304u // Erkennt Schnappschüsse einer anderen Bytereihenfolge
+ #define ISBN_HASH_FUELLUNG 8      // Der ISBN-Hashindex ist höchstens zu 7/8 gefüllt
+ #define EYTZINGER_VORAUS 8        // Schlüssel je Cache-Zeile: Vorabladen der Enkel-Ebene 3 Stufen tiefer
 
  /* Datenstrukturen */
 
- // Struktur für ein Buch
+ // Struktur für ein Buch. Der Knoten enthält nur, was Suche und Balancierung
+ // brauchen (24 Bytes, also fast drei Knoten je Cache-Zeile); die Teilbäume werden
+ // über 32-Bit-Knotennummern der Buch-Arena statt über Zeiger verknüpft. Selten
+ // benötigte Daten wie der Titel liegen getrennt in BuchDaten (siehe buchDaten).
  typedef struct Buch {
-     char isbn[LEN_ISBN];        // ISBN des Buches
-     char titel[MAX_TITEL_LAENGE]; // Titel des Buches
-     struct Buch* links;         // Zeiger auf linken Teilbaum (kleinere ISBN)
-     struct Buch* rechts;        // Zeiger auf rechten Teilbaum (größere ISBN)
+     uint64_t isbn;              // ISBN-13 des Buches als Zahl (siehe isbnLesen)
+     unsigned int links;         // Knotennummer des linken Teilbaums (kleinere ISBN, KEIN_KNOTEN wenn leer)
+     unsigned int rechts;        // Knotennummer des rechten Teilbaums (größere ISBN, KEIN_KNOTEN wenn leer)
+     unsigned int nummer;        // Eigene Knotennummer in der Buch-Arena
+     int hoehe;                  // Höhe des Teilbaums (für die AVL-Balancierung)
  } Buch;
 
- // Struktur für ein ausgeliehenes Buch
+ // Daten eines Buches, die bei der ISBN-Suche nicht gebraucht werden. Sie liegen
+ // unter derselben Knotennummer wie der Knoten in eigenen Blöcken der Buch-Arena.
+ typedef struct BuchDaten {
+     size_t titelOffset;         // Position des Titels im Titel-Pool
+     unsigned int titelLaenge;   // Länge des Titels in Bytes (ohne Nullterminator)
+ } BuchDaten;
+
+ // Struktur für ein ausgeliehenes Buch (24 Bytes). Der Titel wird nicht
+ // gespeichert; die Ausleihe verweist nur auf den Knoten des Buches im Katalog,
+ // der erst bei der ersten Anzeige über die ISBN nachgeschlagen wird.
  typedef struct Ausleihe {
-     char isbn[LEN_ISBN];          // ISBN des ausgeliehenen Buches
-     char titel[MAX_TITEL_LAENGE]; // Titel des ausgeliehenen Buches
-     time_t ausleihDatum;         // Datum der Ausleihe
+     uint64_t isbn;                // ISBN-13 des ausgeliehenen Buches als Zahl
+     time_t ausleihDatum;          // Datum der Ausleihe
+     unsigned int leser;           // Nummer des Lesers, dessen Konto die Ausleihe gehört
+     unsigned int buch;            // Knotennummer des Buches (KEIN_KNOTEN = noch nicht nachgeschlagen)
  } Ausleihe;
 
+ // Zusammenhängender Speicher für alle Buchtitel. Jeder Titel wird genau einmal
+ // nullterminiert abgelegt; die Bücher verweisen per Offset darauf,
+ // da sich die Adresse des Pools beim Vergrößern ändern kann.
+ typedef struct TitelPool {
+     char* daten;                  // Titel, jeweils mit '\0' abgeschlossen
+     size_t laenge;                // Belegte Bytes
+     size_t kapazitaet;            // Reservierte Bytes
+ } TitelPool;
+
+ // Für die Teilstringsuche vorbereiteter Suchbegriff: einmal pro Suche in
+ // Kleinbuchstaben umgewandelt, mit Sprungtabelle nach Boyer-Moore-Horspool
+ typedef struct Suchmuster {
+     unsigned char muster[MAX_TITEL_LAENGE]; // Suchbegriff in Kleinbuchstaben
+     size_t laenge;                          // Länge des Suchbegriffs (höchstens MAX_TITEL_LAENGE - 1)
+     unsigned char sprung[256];              // Verschiebung je (kleingeschriebenem) Textzeichen
+ } Suchmuster;
+
+ // Expliziter Stapel für iterative Baumdurchläufe. Die ersten MAX_BAUMHOEHE Einträge
+ // liegen im Objekt selbst, nur bei entarteten Bäumen wird auf dem Heap vergrößert.
+ typedef struct KnotenStapel {
+     Buch** eintraege;             // Aktueller Speicher (lokal oder auf dem Heap)
+     int anzahl;                   // Anzahl der abgelegten Knoten
+     int kapazitaet;               // Kapazität von eintraege
+     Buch* lokal[MAX_BAUMHOEHE];   // Startspeicher ohne Heap-Reservierung
+ } KnotenStapel;
+
+ // Arena für alle Buch-Knoten des Katalogs: Knoten werden fortlaufend ab 1
+ // nummeriert und aus Blöcken zu je ARENA_BLOCK_GROESSE Knoten vergeben. Knoten
+ // und BuchDaten einer Nummer liegen im gleichnamigen Block an derselben Stelle;
+ // die Blöcke werden nie verschoben und nur mit katalogFreigeben() freigegeben.
+ // Die Nummer 0 (KEIN_KNOTEN) wird nicht vergeben.
+ typedef struct BuchArena {
+     Buch** bloecke;                // Knotenblöcke
+     BuchDaten** datenBloecke;      // Blöcke der Buchdaten (gleiche Aufteilung)
+     size_t anzahlBloecke;          // Anzahl angelegter Blöcke
+     size_t kapazitaetBloecke;      // Kapazität der beiden Blocktabellen
+     size_t anzahlKnoten;           // Anzahl aller vergebenen Knoten
+ } BuchArena;
+
+ // Nach dem Einlesen aufgebauter Index für die Titelsuche. Die Bücher werden in
+ // ISBN-Reihenfolge nummeriert und ihre Titel in dieser Reihenfolge lückenlos im
+ // Titel-Pool abgelegt, sodass der Pool als flacher Puffer durchsucht werden kann.
+ // Zusätzlich gibt es einen invertierten Index über die Trigramme (3 aufeinander-
+ // folgende Zeichen, klein geschrieben) aller Titel: Jedes Trigramm wird auf eine
+ // von TRIGRAMM_LISTEN Postinglisten abgebildet, die aufsteigend die Nummern aller
+ // Bücher enthält, deren Titel ein solches Trigramm enthält. Treffer fallen damit
+ // in beiden Verfahren ohne Nachsortieren in ISBN-Reihenfolge an.
+ typedef struct TitelIndex {
+     Buch** buecher;               // Alle Bücher in ISBN-Reihenfolge (Index = Buchnummer)
+     unsigned int anzahlBuecher;   // Anzahl der Bücher im Index
+     size_t* listenAnfang;         // Beginn jeder Postingliste (TRIGRAMM_LISTEN + 1 Einträge)
+     unsigned int* postings;       // Buchnummern aller Postinglisten hintereinander
+     int gueltig;                  // 0, wenn der Baum seit dem Aufbau verändert wurde
+ } TitelIndex;
+
+ // Eintrag des ISBN-Hashindex; die ISBN liegt im Eintrag, damit eine Suche nur
+ // die Tabelle und erst beim Treffer den Knoten selbst liest
+ typedef struct IsbnHashEintrag {
+     uint64_t isbn;                // ISBN des Buches
+     Buch* buch;                   // Das Buch (NULL = freier Platz)
+ } IsbnHashEintrag;
+
+ // Hashindex für die exakte Suche nach ISBN (offene Adressierung mit Robin-Hood-
+ // Verdrängung): Jedes Buch liegt höchstens so weit hinter seinem Heimatplatz wie
+ // die Bücher davor hinter ihrem, daher endet eine Suche, sobald ein Eintrag
+ // näher an seinem Heimatplatz liegt als der gesuchte es an dieser Stelle wäre.
+ // Der Baum bleibt für die geordnete Traversierung bestehen.
+ typedef struct IsbnHash {
+     IsbnHashEintrag* eintraege;   // Tabelle mit maske + 1 Plätzen (Zweierpotenz)
+     size_t maske;                 // Anzahl der Plätze - 1
+     int verschiebung;             // 64 - log2(Anzahl der Plätze) für die Hashfunktion
+     size_t anzahl;                // Anzahl der eingetragenen Bücher
+     int gueltig;                  // 0, wenn der Baum seit dem Aufbau verändert wurde
+ } IsbnHash;
+
+ // Unveränderliche, cachefreundliche Anordnung aller ISBNs für geordnete Suchen
+ // (Eytzinger-Reihenfolge): Der implizite Suchbaum liegt ebenenweise in einem
+ // Array, die Kinder von Position k liegen bei 2k und 2k + 1. Die ersten Ebenen
+ // teilen sich wenige Cache-Zeilen, und die 8 Urenkel einer Position liegen in
+ // einer einzigen Cache-Zeile, die beim Abstieg vorab geladen werden kann.
+ typedef struct IsbnFolge {
+     uint64_t* schluessel;         // ISBNs ab Position 1 in Eytzinger-Reihenfolge (auf 64 Bytes ausgerichtet)
+     unsigned int* nummer;         // Buchnummer im Titel-Index je Position
+     unsigned int anzahl;          // Anzahl der ISBNs
+     int gueltig;                  // 0, wenn der Baum seit dem Aufbau verändert wurde
+ } IsbnFolge;
+
+ // Eintrag eines Ausleih-Index: ein Schlüssel (ISBN oder Leser) und die älteste
+ // und jüngste Ausleihe mit diesem Schlüssel
+ typedef struct AusleihIndexEintrag {
+     uint64_t schluessel;          // ISBN bzw. Lesernummer + 1 der Ausleihen (0 = freier Platz)
+     int erste;                    // Position der ältesten Ausleihe mit diesem Schlüssel in ausleihen
+     int letzte;                   // Position der jüngsten Ausleihe mit diesem Schlüssel
+ } AusleihIndexEintrag;
+
+ // Index der Ausleihen nach ISBN oder nach Leser: Eine Robin-Hood-Hashtabelle
+ // (wie beim ISBN-Hashindex) führt jeden Schlüssel genau einmal; mehrere
+ // Ausleihen mit demselben Schlüssel sind über naechste/vorherige in
+ // Ausleihreihenfolge doppelt verkettet. Ausleihen, die Prüfung auf eine
+ // bestehende Ausleihe und die Rückgabe samt Umsetzen der letzten Ausleihe in
+ // die Lücke kosten damit O(1); die Ausleihen eines Lesers werden in
+ // O(Ausleihen dieses Lesers) aufgezählt.
+ typedef struct AusleihIndex {
+     AusleihIndexEintrag* eintraege; // Tabelle mit maske + 1 Plätzen (Zweierpotenz)
+     size_t maske;                 // Anzahl der Plätze - 1
+     int verschiebung;             // 64 - log2(Anzahl der Plätze) für die Hashfunktion
+     size_t anzahl;                // Anzahl verschiedener Schlüssel
+     int* naechste;                // Je Ausleihe: nächste Ausleihe mit demselben Schlüssel (-1 = keine)
+     int* vorherige;               // Je Ausleihe: vorherige Ausleihe mit demselben Schlüssel (-1 = keine)
+     size_t kapazitaet;            // Einträge in naechste und vorherige
+     int nachLeser;                // 1: Schlüssel ist die Lesernummer + 1, 0: die ISBN
+ } AusleihIndex;
+
+ // Fälligkeiten der Ausleihen als binärer Min-Heap nach Ausleihdatum (alle
+ // Ausleihen sind AUSLEIHDAUER Tage nach dem Ausleihdatum fällig). Die Wurzel
+ // ist die nächste Fälligkeit; die zum Stichtag überfälligen Ausleihen bilden
+ // einen zusammenhängenden Teilbaum ab der Wurzel und werden ohne Durchsuchen
+ // aller Ausleihen in O(k log k) gefunden. platz verfolgt, wo jede Ausleihe im
+ // Heap steht, damit Rückgaben und das Umsetzen der letzten Ausleihe in die
+ // Lücke O(log n) kosten.
+ typedef struct FaelligkeitsHeap {
+     int* eintraege;               // Heap aus Positionen in ausleihen, früheste Fälligkeit an der Wurzel
+     int* platz;                   // Je Ausleihe: ihr Platz in eintraege
+     int anzahl;                   // Ausleihen im Heap
+     size_t kapazitaet;            // Einträge in eintraege und platz
+ } FaelligkeitsHeap;
+
+ // Stufen der Vektorisierung für die Suche im flachen Titelpuffer
+ typedef enum SimdStufe {
+     SIMD_SKALAR = 0,              // Horspool-Suche ohne Vektorbefehle
+     SIMD_SSE2 = 1,                // 16 Bytes pro Schritt
+     SIMD_AVX2 = 2                 // 32 Bytes pro Schritt
+ } SimdStufe;
+
+ // Eine parallele Titelsuche: Der flache Titelpuffer wird in Partitionen aus
+ // aufeinanderfolgenden Büchern zerlegt, die die Threads nacheinander abholen.
+ // Jede Partition sammelt höchstens maxResults Treffer in ISBN-Reihenfolge.
+ typedef struct SuchAuftrag {
+     const Suchmuster* muster;     // Vorbereiteter Suchbegriff
+     unsigned int ab;              // Nummer des ersten zu durchsuchenden Buches
+     unsigned int anzahlPartitionen;
+     unsigned int buecherProPartition;
+     int maxResults;
+     Buch** treffer;               // Gefundene Bücher, maxResults Einträge je Partition
+     int* trefferAnzahl;           // Anzahl der Treffer je Partition
+     atomic_uint naechstePartition; // Nächste noch nicht vergebene Partition
+     atomic_uint abbruchAb;        // Erste Partition mit maxResults Treffern; spätere werden nicht mehr gebraucht
+ } SuchAuftrag;
+
+ // Thread-Pool für die parallele Titelsuche. Der aufrufende Thread arbeitet selbst
+ // mit, daher werden nur anzahlThreads - 1 Arbeiter gestartet.
+ typedef struct SuchPool {
+     pthread_t arbeiter[MAX_SUCH_THREADS];
+     int anzahlArbeiter;           // Gestartete Arbeiter-Threads
+     int gestartet;                // 1, solange die Arbeiter laufen
+     int beenden;                  // Fordert die Arbeiter zum Beenden auf
+     unsigned long generation;     // Wird für jeden neuen Auftrag erhöht
+     int aktiveArbeiter;           // Arbeiter, die den aktuellen Auftrag noch bearbeiten
+     SuchAuftrag* auftrag;         // Aktueller Auftrag
+     pthread_mutex_t sperre;
+     pthread_cond_t neuerAuftrag;
+     pthread_cond_t auftragErledigt;
+ } SuchPool;
+
+ // Position einer seitenweisen Titelsuche. Jede Seite setzt hinter der ISBN des
+ // letzten Treffers der vorigen Seite fort, sodass die Treffer unabhängig vom
+ // Suchverfahren lückenlos in ISBN-Reihenfolge geliefert werden.
+ typedef struct TitelCursor {
+     Suchmuster muster;            // Vorbereiteter Suchbegriff
+     char titel[MAX_TITEL_LAENGE]; // Suchbegriff für die Ausgabe
+     uint64_t abIsbn;              // Kleinste ISBN der nächsten Seite (0 vor der ersten Seite)
+     int anzahlGeliefert;          // Anzahl bisher gelieferter Treffer
+     int erschoepft;               // 1, wenn es keine weiteren Treffer gibt
+ } TitelCursor;
+
+ // Eine Datei, die zum Einlesen vollständig in den Speicher abgebildet wurde
+ typedef struct DateiAbbild {
+     const char* daten;            // Inhalt der Datei (nicht nullterminiert)
+     size_t groesse;               // Größe in Bytes
+     int abgebildet;               // 1 bei mmap, 0 wenn der Inhalt eingelesen wurde
+ } DateiAbbild;
+
+ // Ein Feld eines CSV-Datensatzes als Ausschnitt der abgebildeten Datei (ohne Kopie)
+ typedef struct CsvFeld {
+     const char* anfang;           // Erstes Zeichen des Feldinhalts (ohne Anführungszeichen)
+     size_t laenge;                // Länge des Feldinhalts in der Datei
+     int maskiert;                 // 1, wenn der Inhalt verdoppelte Anführungszeichen ("") enthält
+ } CsvFeld;
+
+ // Ein zerlegter CSV-Datensatz; der Titel verweist in die abgebildete Datei
+ typedef struct CsvZeile {
+     uint64_t isbn;                // Bereits geprüfte und in ISBN-13 umgewandelte ISBN
+     const char* titel;            // Titel-Feld (bei maskiert noch mit "")
+     unsigned int titelLaenge;     // Länge des Titel-Feldes
+     unsigned char maskiert;       // 1, wenn der Titel "" enthält
+ } CsvZeile;
+
+ // Ein Abschnitt der CSV-Datei, den ein Lade-Thread zerlegt
+ typedef struct CsvAbschnitt {
+     const char* anfang;           // Erster Datensatz des Abschnitts
+     const char* ende;             // Erster Datensatz des nächsten Abschnitts
+     const char* dateiEnde;        // Ende der abgebildeten Datei
+     size_t anfuehrungszeichen;    // Anzahl der Anführungszeichen im Rohabschnitt
+     CsvZeile* zeilen;             // Zerlegte Datensätze in Dateireihenfolge
+     size_t anzahlZeilen;
+     size_t kapazitaet;
+     size_t ungueltig;             // Übersprungene Datensätze mit ungültiger ISBN
+     int fehler;                   // 1 bei Speichermangel
+ } CsvAbschnitt;
+
+ /* Sortierschlüssel eines Datensatzes für csvZeilenSortieren */
+ typedef struct CsvSortierSchluessel {
+     uint64_t isbn;                // ISBN des Datensatzes
+     unsigned int position;        // Position des Datensatzes in der Datei
+ } CsvSortierSchluessel;
+
+ // Kopf eines Katalog-Schnappschusses. Die Datei enthält danach ohne Zeiger, je
+ // auf 8 Bytes ausgerichtet: die ISBN-Schlüssel in aufsteigender Reihenfolge
+ // (uint64_t), anzahlBuecher + 1 Titel-Offsets, den
+ // Titel-Pool in ISBN-Reihenfolge sowie Listenanfänge und Postings des Trigramm-
+ // Index. Die Abschnittspositionen sind Byte-Offsets ab Dateianfang.
+ typedef struct SchnappschussKopf {
+     char kennung[8];                   // "BIBSNAP" mit '\0'
+     unsigned int version;              // SCHNAPPSCHUSS_VERSION
+     unsigned int bytefolge;            // SCHNAPPSCHUSS_BYTEFOLGE
+     unsigned int isbnBreite;           // SCHNAPPSCHUSS_ISBN_BREITE
+     unsigned int trigrammBits;         // TRIGRAMM_BITS beim Schreiben
+     unsigned long long anzahlBuecher;
+     unsigned long long poolLaenge;     // Bytes im Titel-Pool
+     unsigned long long anzahlPostings;
+     unsigned long long csvGroesse;     // Größe der CSV-Datei beim Schreiben
+     long long csvSekunden;             // Änderungszeit der CSV-Datei
+     long long csvNanosekunden;
+     unsigned long long csvPruefsumme;  // Prüfsumme über den Inhalt der CSV-Datei
+     unsigned long long schluesselAnfang;
+     unsigned long long offsetsAnfang;
+     unsigned long long poolAnfang;
+     unsigned long long listenAnfang;
+     unsigned long long postingsAnfang;
+     unsigned long long dateiGroesse;
+     unsigned long long kopfPruefsumme; // Prüfsumme über alle vorigen Felder des Kopfes
+ } SchnappschussKopf;
+
+ // Kopf der binären Ausleihdatei. Danach folgen anzahl Datensätze fester Größe
+ // (AusleihDatensatz) ohne Lücken.
+ typedef struct AusleihDateiKopf {
+     char kennung[8];                    // "BIBAUSL" mit '\0'
+     unsigned int version;               // AUSLEIHDATEI_VERSION
+     unsigned int bytefolge;             // SCHNAPPSCHUSS_BYTEFOLGE
+     unsigned int eintragGroesse;        // sizeof(AusleihDatensatz)
+     unsigned int reserviert;            // 0
+     unsigned long long anzahl;          // Anzahl der Datensätze
+     unsigned long long datenPruefsumme; // Prüfsumme über alle Datensätze
+     unsigned long long kopfPruefsumme;  // Prüfsumme über alle vorigen Felder des Kopfes
+ } AusleihDateiKopf;
+
+ // Eine Ausleihe in der Ausleihdatei (24 Bytes, Speicherlayout wie Ausleihe)
+ typedef struct AusleihDatensatz {
+     uint64_t isbn;                      // ISBN-13 des Buches
+     long long ausleihDatum;             // Datum der Ausleihe
+     unsigned int leser;                 // Nummer des Lesers
+     unsigned int reserviert;            // 0 (wird beim Laden zu Ausleihe.buch = KEIN_KNOTEN)
+ } AusleihDatensatz;
+
+ // Kopf des Ausleihjournals. Ein Journal gilt nur für die Ausleihdatei, deren
+ // Größe und Prüfsumme im Kopf stehen.
+ typedef struct JournalKopf {
+     char kennung[8];                    // "BIBJRNL" mit '\0'
+     unsigned int version;               // JOURNAL_VERSION
+     unsigned int eintragGroesse;        // sizeof(JournalEintrag)
+     unsigned long long basisGroesse;    // Größe der Ausleihdatei
+     unsigned long long basisPruefsumme; // Kopfprüfsumme der Ausleihdatei (bei der Textdatei über den Inhalt)
+ } JournalKopf;
+
+ // Ein Eintrag des Ausleihjournals (32 Bytes). Die Prüfsumme erkennt Einträge,
+ // die bei einem Absturz nur teilweise geschrieben wurden.
+ typedef struct JournalEintrag {
+     uint64_t isbn;                      // ISBN-13 des Buches
+     long long ausleihDatum;             // Datum der Ausleihe
+     unsigned int leser;                 // Nummer des Lesers
+     unsigned int art;                   // JOURNAL_AUSLEIHE oder JOURNAL_RUECKGABE
+     unsigned long long pruefsumme;      // Prüfsumme über die vorigen Felder
+ } JournalEintrag;
+
+ // Group Commit für das Ausleihjournal: Ausleihen und Rückgaben mehrerer Threads
+ // werden gesammelt und gemeinsam mit einem write und einem fsync gespeichert.
+ // Der erste wartende Aufrufer schreibt als Schreiber den ganzen Stapel; jeder
+ // Aufrufer kehrt erst zurück, wenn sein Eintrag dauerhaft gespeichert ist.
+ typedef struct GruppenCommit {
+     pthread_mutex_t sperre;             // Schützt Ausleihen, Ausleih-Index, Journal und Stapel
+     pthread_cond_t geschrieben;         // Signalisiert das Ende eines Schreibvorgangs
+     JournalEintrag* stapel;             // Gesammelte, noch nicht geschriebene Einträge
+     size_t anzahl;                      // Einträge in stapel
+     size_t kapazitaet;                  // Platz in stapel
+     JournalEintrag* schreibStapel;      // Zweiter Stapel, der während des Schreibens getauscht wird
+     size_t schreibKapazitaet;           // Platz in schreibStapel
+     unsigned long long vergeben;        // Laufende Nummer des zuletzt gesammelten Eintrags
+     unsigned long long dauerhaft;       // Laufende Nummer des letzten dauerhaft gespeicherten Eintrags
+     int schreibend;                     // 1, solange ein Schreiber einen Stapel schreibt
+     int fehler;                         // 1 nach einem Schreib- oder Ladefehler; weitere Änderungen werden abgelehnt
+     unsigned int fensterMikrosekunden;  // Wartezeit des Schreibers auf Einträge anderer Threads
+     unsigned long long schreibvorgaenge; // Anzahl geschriebener Stapel (= fsync-Aufrufe)
+ } GruppenCommit;
+
  /* Globale Variablen */
  Buch* wurzel = NULL;                // Wurzel des Binärbaums
- Ausleihe ausleihen[MAX_AUSLEIHEN];  // Array der ausgeliehenen Bücher
+ BuchArena buchArena = { NULL, NULL, 0, 0, 0 };  // Speicher für alle Knoten des Binärbaums
+ TitelPool titelPool = { NULL, 0, 0 };  // Speicher für alle Buchtitel
+ TitelIndex titelIndex = { NULL, 0, NULL, NULL, 0 }; // Index für die Titelsuche
+ IsbnHash isbnHash = { NULL, 0, 0, 0, 0 }; // Hashindex für die exakte ISBN-Suche
+ IsbnFolge isbnFolge = { NULL, NULL, 0, 0 }; // ISBNs in Eytzinger-Reihenfolge für geordnete Suchen
+ SimdStufe simdStufe = SIMD_SKALAR;  // Für die flache Titelsuche verwendeter Suchkern
+ int simdStufeGewaehlt = 0;          // 1, sobald simdStufe ermittelt wurde
+ int suchThreads = 0;                // Threads für die flache Titelsuche (0 = Anzahl der Prozessoren)
+ SuchPool suchPool = { .gestartet = 0, .sperre = PTHREAD_MUTEX_INITIALIZER,
+                       .neuerAuftrag = PTHREAD_COND_INITIALIZER, .auftragErledigt = PTHREAD_COND_INITIALIZER };
+ DateiAbbild katalogAbbild = { NULL, 0, 0 }; // Geladener Schnappschuss (Titel-Pool und Postings verweisen hinein)
+ Ausleihe* ausleihen = NULL;         // Array der ausgeliehenen Bücher (wächst bei Bedarf)
  int anzahlAusleihen = 0;            // Anzahl der aktuellen Ausleihen
+ int kapazitaetAusleihen = 0;        // Reservierte Einträge in ausleihen
+ AusleihIndex ausleihIndex = { NULL, 0, 0, 0, NULL, NULL, 0, 0 }; // Ausleihen nach ISBN
+ AusleihIndex leserIndex = { NULL, 0, 0, 0, NULL, NULL, 0, 1 };   // Ausleihen nach Leser
+ FaelligkeitsHeap faelligkeiten = { NULL, NULL, 0, 0 };            // Ausleihen nach Fälligkeit
+ unsigned int aktuellerLeser = 0;    // Leser, für den ausgeliehen, zurückgegeben und das Konto angezeigt wird
+ int ausleihJournal = -1;            // Zum Anhängen geöffnetes Ausleihjournal (-1 = keins)
+ size_t journalEintraege = 0;        // Einträge im Ausleihjournal seit dem letzten Verdichten
+ GruppenCommit gruppenCommit = { .sperre = PTHREAD_MUTEX_INITIALIZER, .geschrieben = PTHREAD_COND_INITIALIZER };
 
  /* Funktionen */
  void init();
  void nachTitelSuchen(char* titel, char isbnListe[][LEN_ISBN], int maxResults);
+ void nachTitelSuchenSeitenweise(char* titel);
  void nachIsbnSuchen(char* isbn, char isbnListe[][LEN_ISBN], int maxResults);
  int buchAusleihen(char* isbn);
  int kontoAnzeigen();
  int buchZurueckgeben(char* isbn);
+ int leserWechseln(const char* nummer);
+ int mahnlisteAusgeben(time_t stichtag);
+ int datumLesen(const char* text, time_t* zeit);
 
  /* Hilfsfunktionen */
- Buch* neuesBuchErstellen(const char* isbn, const char* titel);
- Buch* buchEinfuegen(Buch* wurzelKnoten, const char* isbn, const char* titel);
- Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, const char* isbn);
+ Buch* arenaKnotenAnfordern();
+ Buch* knotenZeiger(unsigned int nummer);
+ unsigned int knotenNummer(const Buch* knoten);
+ BuchDaten* buchDaten(const Buch* buch);
+ size_t titelAnhaengen(const char* titel, size_t laenge);
+ const char* buchTitel(const Buch* buch);
+ const char* ausleiheTitel(Ausleihe* ausleihe);
+ int isbnLesen(const char* text, size_t laenge, uint64_t* isbn);
+ int isbn13Pruefziffer(uint64_t ersteZwoelf);
+ void isbnFormatieren(uint64_t isbn, char* text);
+ Buch* neuesBuchErstellen(uint64_t isbn, const char* titel, size_t titelLaenge);
+ Buch* buchEinfuegen(Buch* wurzelKnoten, uint64_t isbn, const char* titel);
+ Buch* buchEinfuegenMitLaenge(Buch* wurzelKnoten, uint64_t isbn, const char* titel, size_t titelLaenge);
+ int knotenHoehe(Buch* knoten);
+ void hoeheAktualisieren(Buch* knoten);
+ Buch* rotiereLinks(Buch* knoten);
+ Buch* rotiereRechts(Buch* knoten);
+ Buch* knotenAusbalancieren(Buch* knoten);
+ Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, uint64_t isbn);
+ Buch* buchNachIsbnTextSuchen(const char* isbn);
+ size_t isbnHashPlatz(uint64_t isbn);
+ void isbnHashEintragen(IsbnHashEintrag neu);
+ int isbnHashAufbauen();
+ void isbnHashFreigeben();
+ Buch* isbnHashSuchen(uint64_t isbn);
+ Buch* katalogBuchSuchen(uint64_t isbn);
+ int isbnFolgeAufbauen();
+ void isbnFolgeFreigeben();
+ unsigned int isbnFolgeUntergrenze(uint64_t isbn);
  void zuKleinbuchstaben(char* str);
  int enthältTeilstring(const char* quelle, const char* teilstring);
- int büchernachTitelSuchenRekursiv(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults, int aktuelleAnzahl);
+ unsigned char zeichenFalten(unsigned char zeichen);
+ void musterVorbereiten(Suchmuster* muster, const char* teilstring);
+ int musterSuchen(const Suchmuster* muster, const char* text, size_t laenge);
+ size_t musterFinden(const Suchmuster* muster, const char* text, size_t laenge);
+ int musterMitteVergleichen(const Suchmuster* muster, const unsigned char* stelle);
+ unsigned char zeichenGross(unsigned char zeichen);
+ size_t musterFindenSse2(const Suchmuster* muster, const char* text, size_t laenge);
+ size_t musterFindenAvx2(const Suchmuster* muster, const char* text, size_t laenge);
+ size_t musterFindenVektor(const Suchmuster* muster, const char* text, size_t laenge);
+ SimdStufe simdStufeErmitteln();
+ void simdStufeSetzen(SimdStufe stufe);
+ int büchernachTitelSuchenIterativ(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults);
+ int baumTitelSuchenAb(Buch* wurzelKnoten, const Suchmuster* muster, uint64_t abIsbn, Buch** treffer, int maxResults);
+ void stapelInitialisieren(KnotenStapel* stapel);
+ int stapelAblegen(KnotenStapel* stapel, Buch* knoten);
+ Buch* stapelEntnehmen(KnotenStapel* stapel);
+ void stapelFreigeben(KnotenStapel* stapel);
+ unsigned int trigrammListe(const unsigned char* zeichen);
+ void trigrammeEintragen(unsigned int buchNummer, const char* titel, unsigned int* letztesBuch,
+                         size_t* position, unsigned int* postings);
+ size_t postingGaloppieren(const unsigned int* liste, size_t laenge, unsigned int ziel);
+ int titelIndexAufbauen();
+ void titelIndexFreigeben();
+ int trigrammKandidatenSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults);
+ int trigrammTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults);
+ int titelPoolOrdnen(Buch** buecher, unsigned int anzahl);
+ int flachTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults);
+ int titelBereichDurchsuchen(const Suchmuster* muster, unsigned int von, unsigned int bis,
+                             Buch** treffer, int maxResults, const atomic_uint* abbruchAb, unsigned int partition);
+ int flachBereichSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults);
+ void partitionenAbarbeiten(SuchAuftrag* auftrag);
+ void* suchArbeiter(void* argument);
+ int suchPoolStarten(int anzahlThreads);
+ void suchPoolBeenden();
+ void suchThreadsSetzen(int anzahl);
+ int suchThreadsErmitteln();
+ int parallelTitelSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults);
+ unsigned int titelIndexPosition(uint64_t abIsbn);
+ void trefferAlsIsbnListe(Buch** treffer, int anzahl, char isbnListe[][LEN_ISBN]);
+ void titelSucheStarten(TitelCursor* cursor, const char* titel);
+ int titelSucheFortsetzen(TitelCursor* cursor, Buch** treffer, int maxResults);
+ int titelSeiteAnzeigen(TitelCursor* cursor, char isbnListe[][LEN_ISBN], int maxResults);
+ int katalogTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults);
  void csvDateiEinlesen();
+ int csvDateiLaden(const char* pfad);
+ int csvDatenEinlesen(const char* pfad);
+ int csvDatenEinlesenParallel(const char* pfad, int anzahlThreads);
+ int prozessorAnzahl();
+ void* csvAnfuehrungszeichenZaehlen(void* argument);
+ void* csvAbschnittZerlegen(void* argument);
+ void csvAbschnitteBearbeiten(CsvAbschnitt* abschnitte, int anzahl, void* (*bearbeiten)(void*));
+ const char* csvDatensatzAnfangSuchen(const char* position, int inAnfuehrungszeichen, const char* ende);
+ int csvZeilenEinfuegen(CsvAbschnitt* abschnitte, int anzahl);
+ int csvZeilenMassenEinfuegen(CsvAbschnitt* abschnitte, int anzahl);
+ unsigned int* csvZeilenSortieren(CsvZeile** zeilen, size_t anzahl, size_t* eindeutig);
+ Buch* baumAusSortiertenKnotenAufbauen(Buch** knoten, size_t anzahl);
+ int hoeheFuerAnzahl(size_t anzahl);
+ int titelPoolReservieren(size_t zusaetzlich);
+ int titelPoolVergroessern(size_t kapazitaet);
+ int imKatalogAbbild(const void* zeiger);
+ unsigned long long datenPruefsumme(const char* daten, size_t laenge);
+ unsigned long long schnappschussKopfPruefsumme(const SchnappschussKopf* kopf);
+ int schnappschussSchreiben(const char* pfad, const char* csvPfad);
+ int schnappschussLaden(const char* pfad, const char* csvPfad);
+ int katalogLaden(const char* csvPfad, const char* schnappschussPfad);
+ int dateiAbbilden(const char* pfad, DateiAbbild* abbild);
+ void dateiAbbildFreigeben(DateiAbbild* abbild);
+ const char* csvFeldLesen(const char* position, const char* ende, CsvFeld* feld);
+ const char* csvDatensatzEnde(const char* position, const char* ende);
+ size_t csvFeldEntmaskieren(const CsvFeld* feld, char* ziel);
+ uint64_t ausleiheSchluessel(const AusleihIndex* index, int position);
+ size_t ausleihIndexPlatz(const AusleihIndex* index, uint64_t schluessel);
+ AusleihIndexEintrag* ausleihIndexFinden(const AusleihIndex* index, uint64_t schluessel);
+ void ausleihIndexTabelleEintragen(AusleihIndex* index, AusleihIndexEintrag neu);
+ int ausleihIndexVergroessern(AusleihIndex* index);
+ int ausleihIndexEintragen(AusleihIndex* index, int position);
+ void ausleihIndexAustragen(AusleihIndex* index, int position);
+ void ausleihIndexVerschieben(AusleihIndex* index, int von, int nach);
+ void ausleihIndexLeeren(AusleihIndex* index);
+ int ausleiheIndizieren(int position);
+ int ausleihIndexAufbauen();
+ void ausleihIndexFreigeben();
+ int ausleiheSuchen(uint64_t isbn);
+ int leserAusleiheErste(unsigned int leser);
+ int leserAusleiheNaechste(int position);
+ int leserAusleiheSuchen(unsigned int leser, uint64_t isbn);
+ time_t ausleiheFaelligkeit(const Ausleihe* ausleihe);
+ int faelligkeitFrueher(int positionA, int positionB);
+ void faelligkeitSetzen(int platz, int position);
+ void faelligkeitHochschieben(int platz);
+ void faelligkeitHinunterschieben(int platz);
+ int faelligkeitenReservieren(size_t anzahl);
+ int faelligkeitEintragen(int position);
+ void faelligkeitAustragen(int position);
+ void faelligkeitVerschieben(int von, int nach);
+ int faelligkeitenAufbauen();
+ void faelligkeitenFreigeben();
+ int naechsteFaelligkeit();
+ int faelligkeitVergleichen(const void* a, const void* b);
+ int ueberfaelligeSuchen(time_t stichtag, int** ergebnis);
+ void ausleiheEntfernen(int position);
+ int ausleihenReservieren(int anzahl);
+ void ausleihenFreigeben();
+ int ausleiheAnhaengen(uint64_t isbn, time_t ausleihDatum, unsigned int leser);
+ int ausleiheAnlegen(uint64_t isbn, time_t ausleihDatum, unsigned int leser);
+ int rueckgabeBuchen(unsigned int leser, uint64_t isbn);
+ int journalEintragSchreiben(unsigned int art, const Ausleihe* ausleihe);
+ void ausleiheAenderungZuruecknehmen(unsigned int art, const Ausleihe* ausleihe);
+ void journalStapelZuruecknehmen(const JournalEintrag* stapel, size_t anzahl);
+ int journalStapelReservieren();
+ void journalStapelSchreiben();
+ void journalFensterSetzen(unsigned int mikrosekunden);
+ int journalEintragAnwenden(const JournalEintrag* eintrag);
+ int ausleihJournalAnlegen(unsigned long long basisGroesse, unsigned long long basisPruefsumme);
+ int ausleihJournalEinspielen(unsigned long long basisGroesse, unsigned long long basisPruefsumme);
+ void ausleihJournalSchliessen();
  void ausleihenLaden();
- void ausleihenSpeichern();
+ void ausleihenSperren(const char* meldung);
+ int ausleihDateiLesen(const char* pfad, unsigned long long* groesse, unsigned long long* pruefsumme);
+ int ausleihTextdateiLesen(const char* pfad, unsigned long long* groesse, unsigned long long* pruefsumme);
+ const char* ausleihFeldLesen(const char* position, const char* ende, const char** anfang, size_t* laenge);
+ int ausleihenSpeichern();
  void eingabePufferLeeren();
  int menüAnzeigen();
- void baumFreigeben(Buch* node);
-
- #ifndef TEST_MODE
+ void katalogFreigeben();
 
  /* Hilfsfunktionen für Binärbaum-Operationen */
 
+ /**
+  * Vergibt einen Knoten aus der Buch-Arena und trägt seine Knotennummer ein. Ist
+  * der letzte Block voll, werden ein neuer Knotenblock und ein neuer Datenblock
+  * angelegt; bestehende Knoten behalten dabei ihre Adresse.
+  * @return Zeiger auf den (sonst uninitialisierten) Knoten oder NULL bei Fehler
+  */
+ Buch* arenaKnotenAnfordern() {
+     size_t nummer = buchArena.anzahlKnoten + 1;
+     size_t block = nummer >> ARENA_BLOCK_BITS;
+
+     // Knotennummern müssen in unsigned int passen
+     if (nummer > 0xFFFFFFFFu) {
+         return NULL;
+     }
+
+     if (block == buchArena.anzahlBloecke) {
+         if (buchArena.anzahlBloecke == buchArena.kapazitaetBloecke) {
+             size_t kapazitaet = buchArena.kapazitaetBloecke > 0 ? buchArena.kapazitaetBloecke * 2 : 16;
+             Buch** bloecke = (Buch**)realloc(buchArena.bloecke, kapazitaet * sizeof(Buch*));
+             if (bloecke == NULL) {
+                 return NULL;
+             }
+             buchArena.bloecke = bloecke;
+             BuchDaten** datenBloecke = (BuchDaten**)realloc(buchArena.datenBloecke, kapazitaet * sizeof(BuchDaten*));
+             if (datenBloecke == NULL) {
+                 return NULL;
+             }
+             buchArena.datenBloecke = datenBloecke;
+             buchArena.kapazitaetBloecke = kapazitaet;
+         }
+
+         Buch* knoten = (Buch*)malloc(ARENA_BLOCK_GROESSE * sizeof(Buch));
+         BuchDaten* daten = (BuchDaten*)malloc(ARENA_BLOCK_GROESSE * sizeof(BuchDaten));
+         if (knoten == NULL || daten == NULL) {
+             free(knoten);
+             free(daten);
+             return NULL;
+         }
+         buchArena.bloecke[block] = knoten;
+         buchArena.datenBloecke[block] = daten;
+         buchArena.anzahlBloecke++;
+     }
+
+     buchArena.anzahlKnoten = nummer;
+     Buch* knoten = &buchArena.bloecke[block][nummer & (ARENA_BLOCK_GROESSE - 1)];
+     knoten->nummer = (unsigned int)nummer;
+     return knoten;
+ }
+
+ /**
+  * Liefert den Knoten zu einer Knotennummer der Buch-Arena
+  * @param nummer Knotennummer (KEIN_KNOTEN für einen leeren Teilbaum)
+  * @return Zeiger auf den Knoten oder NULL für KEIN_KNOTEN
+  */
+ Buch* knotenZeiger(unsigned int nummer) {
+     if (nummer == KEIN_KNOTEN) {
+         return NULL;
+     }
+     return &buchArena.bloecke[nummer >> ARENA_BLOCK_BITS][nummer & (ARENA_BLOCK_GROESSE - 1)];
+ }
+
+ /**
+  * Liefert die Knotennummer eines Knotens
+  * @param knoten Der Knoten (darf NULL sein)
+  * @return Knotennummer oder KEIN_KNOTEN für NULL
+  */
+ unsigned int knotenNummer(const Buch* knoten) {
+     return knoten != NULL ? knoten->nummer : KEIN_KNOTEN;
+ }
+
+ /**
+  * Liefert die getrennt abgelegten Daten (Titel) eines Buches
+  * @param buch Das Buch
+  * @return Zeiger auf die Buchdaten
+  */
+ BuchDaten* buchDaten(const Buch* buch) {
+     return &buchArena.datenBloecke[buch->nummer >> ARENA_BLOCK_BITS][buch->nummer & (ARENA_BLOCK_GROESSE - 1)];
+ }
+
+ /**
+  * Legt einen Titel am Ende des Titel-Pools ab und vergrößert den Pool bei Bedarf
+  * @param titel Der abzulegende Titel
+  * @param laenge Länge des Titels in Bytes
+  * @return Offset des Titels im Pool oder KEIN_TITEL bei Fehler
+  */
+ size_t titelAnhaengen(const char* titel, size_t laenge) {
+     if (titelPool.laenge + laenge + 1 > titelPool.kapazitaet) {
+         size_t kapazitaet = titelPool.kapazitaet > 0 ? titelPool.kapazitaet : TITELPOOL_START;
+         while (titelPool.laenge + laenge + 1 > kapazitaet) {
+             kapazitaet *= 2;
+         }
+
+         if (!titelPoolVergroessern(kapazitaet)) {
+             return KEIN_TITEL;
+         }
+     }
+
+     size_t offset = titelPool.laenge;
+     memcpy(titelPool.daten + offset, titel, laenge);
+     titelPool.daten[offset + laenge] = '\0';
+     titelPool.laenge += laenge + 1;
+     return offset;
+ }
+
+ /**
+  * Vergrößert den Titel-Pool im Voraus, sodass weitere Titel mit zusammen
+  * zusaetzlich Bytes (einschließlich '\0') ohne erneutes realloc passen
+  * @return 1 bei Erfolg, 0 bei Speichermangel
+  */
+ int titelPoolReservieren(size_t zusaetzlich) {
+     if (titelPool.laenge + zusaetzlich <= titelPool.kapazitaet) {
+         return 1;
+     }
+
+     return titelPoolVergroessern(titelPool.laenge + zusaetzlich);
+ }
+
+ /**
+  * Setzt die Kapazität des Titel-Pools auf kapazitaet Bytes. Liegt der Pool noch
+  * im abgebildeten Schnappschuss, wird er dabei in eigenen Speicher kopiert.
+  * @return 1 bei Erfolg, 0 bei Speichermangel (der bisherige Pool bleibt erhalten)
+  */
+ int titelPoolVergroessern(size_t kapazitaet) {
+     char* daten;
+     if (imKatalogAbbild(titelPool.daten)) {
+         daten = (char*)malloc(kapazitaet);
+         if (daten != NULL) {
+             memcpy(daten, titelPool.daten, titelPool.laenge);
+         }
+     } else {
+         daten = (char*)realloc(titelPool.daten, kapazitaet);
+     }
+     if (daten == NULL) {
+         return 0;
+     }
+     titelPool.daten = daten;
+     titelPool.kapazitaet = kapazitaet;
+     return 1;
+ }
+
+ /**
+  * Prüft, ob ein Zeiger in den abgebildeten Schnappschuss zeigt (solcher Speicher
+  * darf weder verändert noch mit free freigegeben werden)
+  * @return 1, wenn zeiger im Schnappschuss liegt, sonst 0
+  */
+ int imKatalogAbbild(const void* zeiger) {
+     const char* position = (const char*)zeiger;
+     return katalogAbbild.daten != NULL && position >= katalogAbbild.daten &&
+            position < katalogAbbild.daten + katalogAbbild.groesse;
+ }
+
+ /**
+  * Liefert den Titel eines Buches aus dem Titel-Pool
+  * @param buch Das Buch
+  * @return Nullterminierter Titel
+  */
+ const char* buchTitel(const Buch* buch) {
+     return titelPool.daten + buchDaten(buch)->titelOffset;
+ }
+
+ /**
+  * Liefert den Titel eines ausgeliehenen Buches. Das Buch wird erst hier über
+  * die ISBN im Katalog nachgeschlagen und seine Knotennummer in der Ausleihe
+  * gemerkt; sie gilt nur, solange der Knoten noch diese ISBN trägt (nach einem
+  * erneuten Laden des Katalogs wird wieder nachgeschlagen).
+  * @param ausleihe Die Ausleihe
+  * @return Nullterminierter Titel oder "Unbekanntes Buch"
+  */
+ const char* ausleiheTitel(Ausleihe* ausleihe) {
+     if (ausleihe->buch == KEIN_KNOTEN || ausleihe->buch > buchArena.anzahlKnoten ||
+         knotenZeiger(ausleihe->buch)->isbn != ausleihe->isbn) {
+         Buch* buch = katalogBuchSuchen(ausleihe->isbn);
+         if (buch == NULL) {
+             return "Unbekanntes Buch";
+         }
+         ausleihe->buch = knotenNummer(buch);
+     }
+     return buchTitel(knotenZeiger(ausleihe->buch));
+ }
+
+ /**
+  * Liest eine ISBN-10 oder ISBN-13 (Bindestriche und Leerzeichen sind erlaubt)
+  * und prüft ihre Prüfziffer. ISBN-10 werden mit dem Präfix 978 und neu
+  * berechneter Prüfziffer in ISBN-13 umgewandelt, sodass jedes Buch genau einen
+  * Schlüssel hat und ISBNs mit einem einzigen Ganzzahlvergleich verglichen werden.
+  * @param text Die ISBN (muss nicht nullterminiert sein)
+  * @param laenge Länge von text in Bytes
+  * @param isbn Nimmt die ISBN-13 als Zahl auf
+  * @return 1 bei gültiger ISBN, sonst 0
+  */
+ int isbnLesen(const char* text, size_t laenge, uint64_t* isbn) {
+     unsigned char ziffern[13];
+     int anzahl = 0;
+     for (size_t i = 0; i < laenge; i++) {
+         char zeichen = text[i];
+         if (zeichen == '-' || zeichen == ' ') {
+             continue;
+         }
+         if (anzahl == 13) {
+             return 0;
+         }
+         if (zeichen >= '0' && zeichen <= '9') {
+             ziffern[anzahl++] = (unsigned char)(zeichen - '0');
+         } else if ((zeichen == 'X' || zeichen == 'x') && anzahl == 9) {
+             ziffern[anzahl++] = 10;   // Prüfziffer 10 einer ISBN-10
+         } else {
+             return 0;
+         }
+     }
+
+     uint64_t zahl = 0;
+     if (anzahl == 10) {
+         // ISBN-10: Gewichte 10 bis 1, die Summe muss durch 11 teilbar sein
+         int summe = 0;
+         for (int i = 0; i < 10; i++) {
+             summe += ziffern[i] * (10 - i);
+         }
+         if (summe % 11 != 0) {
+             return 0;
+         }
+         zahl = 978;
+         for (int i = 0; i < 9; i++) {
+             zahl = zahl * 10 + ziffern[i];
+         }
+         *isbn = zahl * 10 + (uint64_t)isbn13Pruefziffer(zahl);
+         return 1;
+     }
+
+     if (anzahl != 13) {
+         return 0;
+     }
+     for (int i = 0; i < 12; i++) {
+         if (ziffern[i] > 9) {
+             return 0;
+         }
+         zahl = zahl * 10 + ziffern[i];
+     }
+     // ISBN-13 beginnen mit 978 oder 979
+     if (zahl / 1000000000ULL != 978 && zahl / 1000000000ULL != 979) {
+         return 0;
+     }
+     if (ziffern[12] != isbn13Pruefziffer(zahl)) {
+         return 0;
+     }
+     *isbn = zahl * 10 + ziffern[12];
+     return 1;
+ }
+
+ /**
+  * Berechnet die Prüfziffer einer ISBN-13 (Gewichte abwechselnd 1 und 3)
+  * @param ersteZwoelf Die ersten 12 Ziffern als Zahl
+  * @return Prüfziffer 0 bis 9
+  */
+ int isbn13Pruefziffer(uint64_t ersteZwoelf) {
+     int summe = 0;
+     for (int i = 0; i < 12; i++) {
+         // Von rechts gezählt hat die letzte der zwölf Ziffern das Gewicht 3
+         summe += (int)(ersteZwoelf % 10) * (i % 2 == 0 ? 3 : 1);
+         ersteZwoelf /= 10;
+     }
+     return (10 - summe % 10) % 10;
+ }
+
+ /**
+  * Schreibt eine ISBN als 13-stelligen Text (mit führenden Nullen)
+  * @param isbn Die ISBN als Zahl
+  * @param text Puffer mit mindestens LEN_ISBN Bytes
+  */
+ void isbnFormatieren(uint64_t isbn, char* text) {
+     snprintf(text, LEN_ISBN, "%013llu", (unsigned long long)isbn);
+ }
+
  /**
   * Erstellt ein neues Buch mit den gegebenen Daten
   * @param isbn ISBN des Buches
   * @param titel Titel des Buches
+  * @param titelLaenge Länge des Titels in Bytes
   * @return Zeiger auf das neue Buch oder NULL bei Fehler
   */
- Buch* neuesBuchErstellen(const char* isbn, const char* titel) {
-     // Speicher für das neue Buch reservieren
-     Buch* neuesBuch = (Buch*)malloc(sizeof(Buch));
-
-     // Prüfen, ob die Speicherreservierung erfolgreich war
-     if (neuesBuch == NULL) {
+ Buch* neuesBuchErstellen(uint64_t isbn, const char* titel, size_t titelLaenge) {
+     // Speicher für das neue Buch aus der Arena holen und den Titel im Pool ablegen
+     Buch* neuesBuch = arenaKnotenAnfordern();
+     size_t titelOffset = neuesBuch != NULL ? titelAnhaengen(titel, titelLaenge) : KEIN_TITEL;
+
+     // Prüfen, ob die Speicherreservierung erfolgreich war. Ein bereits
+     // vergebener Knoten wird zurückgegeben, da jeder gezählte Knoten der Arena
+     // zum Katalog gehören muss (isbnHashAufbauen, Schnappschuss).
+     if (neuesBuch == NULL || titelOffset == KEIN_TITEL) {
+         if (neuesBuch != NULL) {
+             buchArena.anzahlKnoten--;
+         }
          printf("Fehler bei der Speicherreservierung!\n");
          return NULL;
      }
 
      // Daten in das neue Buch kopieren
-     strncpy(neuesBuch->isbn, isbn, LEN_ISBN - 1);
-     neuesBuch->isbn[LEN_ISBN - 1] = '\0'; // Sicherstellen, dass die ISBN nullterminiert ist
-
-     strncpy(neuesBuch->titel, titel, MAX_TITEL_LAENGE - 1);
-     neuesBuch->titel[MAX_TITEL_LAENGE - 1] = '\0'; // Sicherstellen, dass der Titel nullterminiert ist
+     neuesBuch->isbn = isbn;
+     BuchDaten* daten = buchDaten(neuesBuch);
+     daten->titelOffset = titelOffset;
+     daten->titelLaenge = (unsigned int)titelLaenge;
 
      // Teilbäume initialisieren
-     neuesBuch->links = NULL;
-     neuesBuch->rechts = NULL;
+     neuesBuch->links = KEIN_KNOTEN;
+     neuesBuch->rechts = KEIN_KNOTEN;
+     neuesBuch->hoehe = 1; // Ein neuer Knoten ist immer ein Blatt
 
      return neuesBuch;
  }
 
  /**
-  * Fügt ein Buch in den Binärbaum ein
+  * Liefert die Höhe eines Teilbaums
+  * @param knoten Wurzel des Teilbaums (darf NULL sein)
+  * @return Höhe des Teilbaums, 0 für einen leeren Baum
+  */
+ int knotenHoehe(Buch* knoten) {
+     return knoten != NULL ? knoten->hoehe : 0;
+ }
+
+ /**
+  * Berechnet die Höhe eines Knotens aus den Höhen seiner Teilbäume neu
+  * @param knoten Der zu aktualisierende Knoten
+  */
+ void hoeheAktualisieren(Buch* knoten) {
+     int hoeheLinks = knotenHoehe(knotenZeiger(knoten->links));
+     int hoeheRechts = knotenHoehe(knotenZeiger(knoten->rechts));
+     knoten->hoehe = 1 + (hoeheLinks > hoeheRechts ? hoeheLinks : hoeheRechts);
+ }
+
+ /**
+  * Dreht einen Teilbaum nach links (der rechte Nachfolger wird zur neuen Wurzel)
+  * @param knoten Wurzel des Teilbaums
+  * @return Neue Wurzel des Teilbaums
+  */
+ Buch* rotiereLinks(Buch* knoten) {
+     Buch* neueWurzel = knotenZeiger(knoten->rechts);
+     knoten->rechts = neueWurzel->links;
+     neueWurzel->links = knoten->nummer;
+
+     // Zuerst den abgesenkten Knoten, dann die neue Wurzel aktualisieren
+     hoeheAktualisieren(knoten);
+     hoeheAktualisieren(neueWurzel);
+     return neueWurzel;
+ }
+
+ /**
+  * Dreht einen Teilbaum nach rechts (der linke Nachfolger wird zur neuen Wurzel)
+  * @param knoten Wurzel des Teilbaums
+  * @return Neue Wurzel des Teilbaums
+  */
+ Buch* rotiereRechts(Buch* knoten) {
+     Buch* neueWurzel = knotenZeiger(knoten->links);
+     knoten->links = neueWurzel->rechts;
+     neueWurzel->rechts = knoten->nummer;
+
+     hoeheAktualisieren(knoten);
+     hoeheAktualisieren(neueWurzel);
+     return neueWurzel;
+ }
+
+ /**
+  * Stellt die AVL-Bedingung (Höhendifferenz der Teilbäume höchstens 1) für einen
+  * Knoten wieder her, nachdem in einen seiner Teilbäume eingefügt wurde
+  * @param knoten Wurzel des Teilbaums
+  * @return Neue Wurzel des (ausbalancierten) Teilbaums
+  */
+ Buch* knotenAusbalancieren(Buch* knoten) {
+     hoeheAktualisieren(knoten);
+     Buch* linkerKnoten = knotenZeiger(knoten->links);
+     Buch* rechterKnoten = knotenZeiger(knoten->rechts);
+     int balance = knotenHoehe(linkerKnoten) - knotenHoehe(rechterKnoten);
+
+     // Linker Teilbaum zu hoch
+     if (balance > 1) {
+         // Links-Rechts-Fall: zuerst den linken Teilbaum nach links drehen
+         if (knotenHoehe(knotenZeiger(linkerKnoten->links)) < knotenHoehe(knotenZeiger(linkerKnoten->rechts))) {
+             knoten->links = rotiereLinks(linkerKnoten)->nummer;
+         }
+         return rotiereRechts(knoten);
+     }
+
+     // Rechter Teilbaum zu hoch
+     if (balance < -1) {
+         // Rechts-Links-Fall: zuerst den rechten Teilbaum nach rechts drehen
+         if (knotenHoehe(knotenZeiger(rechterKnoten->rechts)) < knotenHoehe(knotenZeiger(rechterKnoten->links))) {
+             knoten->rechts = rotiereRechts(rechterKnoten)->nummer;
+         }
+         return rotiereLinks(knoten);
+     }
+
+     return knoten;
+ }
+
+ /**
+  * Fügt ein Buch in den Binärbaum ein. Der Baum wird dabei als AVL-Baum
+  * ausbalanciert, damit er auch bei sortiert eingelesenen ISBNs nicht zu einer
+  * Liste entartet und die Suche O(log n) bleibt.
+  * Der Abstieg erfolgt iterativ; der Pfad wird in einem Array gemerkt, das wegen
+  * der AVL-Bedingung nie mehr als MAX_BAUMHOEHE Einträge benötigt.
+  * @param wurzelKnoten Zeiger auf die Wurzel des Baums
+  * @param isbn ISBN des einzufügenden Buches
+  * @param titel Titel des einzufügenden Buches
+  * @return Zeiger auf die (möglicherweise neue) Wurzel des Baums
+  */
+ Buch* buchEinfuegen(Buch* wurzelKnoten, uint64_t isbn, const char* titel) {
+     return buchEinfuegenMitLaenge(wurzelKnoten, isbn, titel, strlen(titel));
+ }
+
+ /**
+  * Fügt ein Buch mit einem nicht nullterminierten Titel in den Binärbaum ein
+  * (siehe buchEinfuegen), z. B. direkt aus dem Puffer einer eingelesenen Datei
   * @param wurzelKnoten Zeiger auf die Wurzel des Baums
   * @param isbn ISBN des einzufügenden Buches
   * @param titel Titel des einzufügenden Buches
+  * @param titelLaenge Länge des Titels in Bytes
   * @return Zeiger auf die (möglicherweise neue) Wurzel des Baums
   */
- Buch* buchEinfuegen(Buch* wurzelKnoten, const char* isbn, const char* titel) {
-     // Wenn der Baum leer ist, neues Buch als Wurzel einfügen
-     if (wurzelKnoten == NULL) {
-         return neuesBuchErstellen(isbn, titel);
+ Buch* buchEinfuegenMitLaenge(Buch* wurzelKnoten, uint64_t isbn, const char* titel, size_t titelLaenge) {
+     // Adressen der Knotennummern auf dem Weg von der Wurzel zur Einfügeposition
+     // (die Knoten werden in der Arena nie verschoben)
+     unsigned int* pfad[MAX_BAUMHOEHE];
+     int tiefe = 0;
+     unsigned int wurzelNummer = knotenNummer(wurzelKnoten);
+     unsigned int* position = &wurzelNummer;
+
+     // Bis zur freien Position absteigen
+     while (*position != KEIN_KNOTEN) {
+         Buch* knoten = knotenZeiger(*position);
+
+         // Wenn die ISBN bereits existiert, nichts tun (Duplikate vermeiden)
+         // Alternativ könnte man hier den Titel aktualisieren, falls sich dieser geändert hat
+         if (isbn == knoten->isbn) {
+             return wurzelKnoten;
+         }
+
+         if (tiefe == MAX_BAUMHOEHE) {
+             printf("Fehler: Der Binärbaum ist nicht ausbalanciert!\n");
+             return wurzelKnoten;
+         }
+         pfad[tiefe++] = position;
+
+         // Kleinere ISBNs links, größere rechts einfügen
+         position = isbn < knoten->isbn ? &knoten->links : &knoten->rechts;
+     }
+
+     Buch* neuesBuch = neuesBuchErstellen(isbn, titel, titelLaenge);
+     if (neuesBuch == NULL) {
+         return wurzelKnoten;
+     }
+     *position = neuesBuch->nummer;
+
+     // Titel-Index, ISBN-Hashindex und ISBN-Folge kennen das neue Buch nicht
+     titelIndex.gueltig = 0;
+     isbnHash.gueltig = 0;
+     isbnFolge.gueltig = 0;
+
+     // Auf dem Rückweg zur Wurzel die Balance wiederherstellen. Sobald sich die
+     // Höhe eines Teilbaums nicht mehr ändert, sind alle Vorgänger unverändert.
+     for (int i = tiefe - 1; i >= 0; i--) {
+         Buch* knoten = knotenZeiger(*pfad[i]);
+         int alteHoehe = knoten->hoehe;
+
+         Buch* neueWurzel = knotenAusbalancieren(knoten);
+         *pfad[i] = neueWurzel->nummer;
+         if (neueWurzel == knoten && knoten->hoehe == alteHoehe) {
+             break;
+         }
+     }
+
+     return knotenZeiger(wurzelNummer);
+ }
+
+ /**
+  * Gibt den gesamten Katalog frei. Da alle Knoten aus der Buch-Arena stammen,
+  * genügt es, die Blöcke, den Titel-Pool und den Titel-Index freizugeben;
+  * der Baum selbst muss nicht durchlaufen werden.
+  */
+ void katalogFreigeben() {
+     for (size_t i = 0; i < buchArena.anzahlBloecke; i++) {
+         free(buchArena.bloecke[i]);
+         free(buchArena.datenBloecke[i]);
+     }
+     free(buchArena.bloecke);
+     free(buchArena.datenBloecke);
+
+     buchArena.bloecke = NULL;
+     buchArena.datenBloecke = NULL;
+     buchArena.anzahlBloecke = 0;
+     buchArena.kapazitaetBloecke = 0;
+     buchArena.anzahlKnoten = 0;
+     wurzel = NULL;
+
+     if (!imKatalogAbbild(titelPool.daten)) {
+         free(titelPool.daten);
+     }
+     titelPool.daten = NULL;
+     titelPool.laenge = 0;
+     titelPool.kapazitaet = 0;
+
+     titelIndexFreigeben();
+     isbnHashFreigeben();
+     if (katalogAbbild.daten != NULL) {
+         dateiAbbildFreigeben(&katalogAbbild);
+     }
+ }
+
+ /**
+  * Sucht ein Buch im Binärbaum anhand der ISBN
+  * @param wurzelKnoten Wurzel des (Teil-)Baums, in dem gesucht wird
+  * @param isbn Zu suchende ISBN
+  * @return Zeiger auf das gefundene Buch oder NULL, wenn nicht gefunden
+  */
+ Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, uint64_t isbn) {
+     // Absteigen, bis das Buch gefunden oder das Ende eines Pfades erreicht ist
+     while (wurzelKnoten != NULL) {
+         // Wenn die ISBNs übereinstimmen, Buch gefunden
+         if (isbn == wurzelKnoten->isbn) {
+             return wurzelKnoten;
+         }
+
+         // Bei kleinerer ISBN links, bei größerer rechts weitersuchen
+         wurzelKnoten = knotenZeiger(isbn < wurzelKnoten->isbn ? wurzelKnoten->links : wurzelKnoten->rechts);
+     }
+
+     // Buch nicht gefunden
+     return NULL;
+ }
+
+ /**
+  * Sucht ein Buch im Katalog anhand einer ISBN in Textform (ISBN-10 oder ISBN-13)
+  * @param isbn Zu suchende ISBN
+  * @return Zeiger auf das gefundene Buch oder NULL, wenn die ISBN ungültig ist
+  *         oder kein Buch mit dieser ISBN existiert
+  */
+ Buch* buchNachIsbnTextSuchen(const char* isbn) {
+     uint64_t schluessel;
+     if (!isbnLesen(isbn, strlen(isbn), &schluessel)) {
+         return NULL;
+     }
+     return katalogBuchSuchen(schluessel);
+ }
+
+ /* ISBN-Hashindex für die exakte Suche */
+
+ /**
+  * Bestimmt den Heimatplatz einer ISBN (Fibonacci-Hashing: die oberen Bits des
+  * Produkts mit 2^64 / goldener Schnitt, damit auch fortlaufende ISBNs streuen)
+  */
+ size_t isbnHashPlatz(uint64_t isbn) {
+     return (size_t)((isbn * 0x9E3779B97F4A7C15ULL) >> isbnHash.verschiebung);
+ }
+
+ /**
+  * Trägt ein Buch mit Robin-Hood-Verdrängung in den ISBN-Hashindex ein: Wer
+  * näher an seinem Heimatplatz liegt, macht Platz und wird weiter hinten eingefügt
+  * @param neu Der einzutragende Eintrag
+  */
+ void isbnHashEintragen(IsbnHashEintrag neu) {
+     IsbnHashEintrag* eintraege = isbnHash.eintraege;
+     size_t platz = isbnHashPlatz(neu.isbn);
+     size_t abstand = 0;
+     while (eintraege[platz].buch != NULL) {
+         size_t abstandVorhanden = (platz - isbnHashPlatz(eintraege[platz].isbn)) & isbnHash.maske;
+         if (abstandVorhanden < abstand) {
+             IsbnHashEintrag tausch = eintraege[platz];
+             eintraege[platz] = neu;
+             neu = tausch;
+             abstand = abstandVorhanden;
+         }
+         platz = (platz + 1) & isbnHash.maske;
+         abstand++;
+     }
+     eintraege[platz] = neu;
+ }
+
+ /**
+  * Baut den ISBN-Hashindex über alle Bücher des Katalogs auf. Die Tabelle hat
+  * die kleinste Zweierpotenz an Plätzen, bei der sie höchstens zu 7/8 gefüllt ist.
+  * Statt jedes Buch einzeln mit Verdrängung einzufügen, werden die Bücher nach
+  * Heimatplatz verteilt (Zählen, dann Platzieren): Liegen die Einträge nach
+  * Heimatplatz geordnet, ist die Robin-Hood-Bedingung von selbst erfüllt, und
+  * jedes Buch kostet einen Schreibzugriff ohne Sondieren. Nur Bücher, die über
+  * das Tabellenende hinausragen, werden anschließend einzeln eingefügt.
+  * Da Knoten nur gemeinsam freigegeben werden, gehört jeder Knoten der Arena
+  * zum Katalog; die Arena wird daher sequentiell statt des Baums durchlaufen.
+  * @return 1 bei Erfolg, 0 bei Speichermangel (die Suche durchläuft dann den Baum)
+  */
+ int isbnHashAufbauen() {
+     isbnHashFreigeben();
+
+     size_t anzahl = buchArena.anzahlKnoten;
+     size_t plaetze = 16;
+     int bits = 4;
+     while (plaetze - plaetze / ISBN_HASH_FUELLUNG < anzahl) {
+         plaetze *= 2;
+         bits++;
+     }
+     IsbnHashEintrag* eintraege = (IsbnHashEintrag*)calloc(plaetze, sizeof(IsbnHashEintrag));
+     // Plätze passen in unsigned int, da wie beim Titel-Index höchstens 2^31 Bücher erwartet werden
+     unsigned int* naechsterPlatz = (unsigned int*)calloc(plaetze, sizeof(unsigned int));
+     if (eintraege == NULL || naechsterPlatz == NULL) {
+         free(eintraege);
+         free(naechsterPlatz);
+         return 0;
+     }
+     isbnHash.eintraege = eintraege;
+     isbnHash.maske = plaetze - 1;
+     isbnHash.verschiebung = 64 - bits;
+
+     // Zählphase: Bücher je Heimatplatz
+     for (unsigned int nummer = 1; nummer <= buchArena.anzahlKnoten; nummer++) {
+         naechsterPlatz[isbnHashPlatz(knotenZeiger(nummer)->isbn)]++;
+     }
+
+     // Erster Platz jedes Heimatplatzes: direkt hinter den Büchern der Heimatplätze davor
+     size_t ende = 0;
+     for (size_t platz = 0; platz < plaetze; platz++) {
+         size_t anzahlHier = naechsterPlatz[platz];
+         naechsterPlatz[platz] = (unsigned int)(ende > platz ? ende : platz);
+         ende = naechsterPlatz[platz] + anzahlHier;
+     }
+
+     // Bücher, die über das Tabellenende hinausragen (höchstens die letzte Kette)
+     size_t anzahlUeberlauf = ende > plaetze ? ende - plaetze : 0;
+     IsbnHashEintrag* ueberlauf = (IsbnHashEintrag*)malloc((anzahlUeberlauf > 0 ? anzahlUeberlauf : 1) * sizeof(IsbnHashEintrag));
+     if (ueberlauf == NULL) {
+         free(naechsterPlatz);
+         isbnHashFreigeben();
+         return 0;
+     }
+
+     // Platzierphase
+     for (unsigned int nummer = 1; nummer <= buchArena.anzahlKnoten; nummer++) {
+         Buch* knoten = knotenZeiger(nummer);
+         size_t platz = naechsterPlatz[isbnHashPlatz(knoten->isbn)]++;
+         IsbnHashEintrag* ziel = platz < plaetze ? &eintraege[platz] : &ueberlauf[platz - plaetze];
+         ziel->isbn = knoten->isbn;
+         ziel->buch = knoten;
+     }
+     free(naechsterPlatz);
+
+     // Überläufe am Tabellenanfang fortsetzen
+     for (size_t i = 0; i < anzahlUeberlauf; i++) {
+         isbnHashEintragen(ueberlauf[i]);
+     }
+     free(ueberlauf);
+
+     isbnHash.anzahl = anzahl;
+     isbnHash.gueltig = 1;
+     return 1;
+ }
+
+ /**
+  * Gibt den Speicher des ISBN-Hashindex frei
+  */
+ void isbnHashFreigeben() {
+     free(isbnHash.eintraege);
+     isbnHash.eintraege = NULL;
+     isbnHash.maske = 0;
+     isbnHash.verschiebung = 0;
+     isbnHash.anzahl = 0;
+     isbnHash.gueltig = 0;
+ }
+
+ /**
+  * Sucht ein Buch im ISBN-Hashindex (nur bei gültigem Index aufrufen)
+  * @param isbn Zu suchende ISBN
+  * @return Zeiger auf das gefundene Buch oder NULL, wenn nicht gefunden
+  */
+ Buch* isbnHashSuchen(uint64_t isbn) {
+     size_t platz = isbnHashPlatz(isbn);
+     for (size_t abstand = 0; ; abstand++) {
+         const IsbnHashEintrag* eintrag = &isbnHash.eintraege[platz];
+         if (eintrag->buch == NULL) {
+             return NULL;
+         }
+         if (eintrag->isbn == isbn) {
+             return eintrag->buch;
+         }
+         // Ein Eintrag näher an seinem Heimatplatz: Die ISBN käme davor
+         if (((platz - isbnHashPlatz(eintrag->isbn)) & isbnHash.maske) < abstand) {
+             return NULL;
+         }
+         platz = (platz + 1) & isbnHash.maske;
+     }
+ }
+
+ /**
+  * Sucht ein Buch im Katalog anhand der ISBN: über den Hashindex, solange er
+  * gültig ist, sonst über die ISBN-Folge und zuletzt im Binärbaum
+  * @param isbn Zu suchende ISBN
+  * @return Zeiger auf das gefundene Buch oder NULL, wenn nicht gefunden
+  */
+ Buch* katalogBuchSuchen(uint64_t isbn) {
+     if (isbnHash.gueltig) {
+         return isbnHashSuchen(isbn);
+     }
+     if (isbnFolge.gueltig) {
+         unsigned int nummer = isbnFolgeUntergrenze(isbn);
+         if (nummer < titelIndex.anzahlBuecher && titelIndex.buecher[nummer]->isbn == isbn) {
+             return titelIndex.buecher[nummer];
+         }
+         return NULL;
+     }
+     return buchNachIsbnSuchen(wurzel, isbn);
+ }
+
+ /* ISBN-Folge in Eytzinger-Reihenfolge für geordnete Suchen */
+
+ /**
+  * Ordnet die ISBNs des Titel-Index (in ISBN-Reihenfolge) in Eytzinger-
+  * Reihenfolge an. Die Positionen werden in symmetrischer Reihenfolge des
+  * impliziten Baums durchlaufen, sodass jede ISBN genau einmal und ohne
+  * Stapel ihren Platz erhält. Wird mit jedem Aufbau des Titel-Index erstellt
+  * und mit ihm freigegeben.
+  * @return 1 bei Erfolg, 0 bei Speichermangel (geordnete Suchen verwenden dann
+  *         die binäre Suche im Titel-Index)
+  */
+ int isbnFolgeAufbauen() {
+     isbnFolgeFreigeben();
+     if (!titelIndex.gueltig) {
+         return 0;
+     }
+
+     unsigned int anzahl = titelIndex.anzahlBuecher;
+     size_t bytes = (((size_t)anzahl + 1) * sizeof(uint64_t) + 63) & ~(size_t)63;
+     uint64_t* schluessel = (uint64_t*)aligned_alloc(64, bytes);
+     unsigned int* nummer = (unsigned int*)malloc(((size_t)anzahl + 1) * sizeof(unsigned int));
+     if (schluessel == NULL || nummer == NULL) {
+         free(schluessel);
+         free(nummer);
+         return 0;
+     }
+     schluessel[0] = 0;
+     nummer[0] = anzahl;
+
+     // Symmetrischer Durchlauf: beim linkesten Knoten beginnen, dann jeweils zum Nachfolger
+     size_t k = 1;
+     while (2 * k <= anzahl) {
+         k *= 2;
+     }
+     for (unsigned int i = 0; i < anzahl; i++) {
+         schluessel[k] = titelIndex.buecher[i]->isbn;
+         nummer[k] = i;
+         if (2 * k + 1 <= anzahl) {
+             // Nachfolger ist der linkeste Knoten des rechten Teilbaums
+             k = 2 * k + 1;
+             while (2 * k <= anzahl) {
+                 k *= 2;
+             }
+         } else {
+             // Aufsteigen, bis man aus einem linken Teilbaum kommt
+             while (k & 1) {
+                 k >>= 1;
+             }
+             k >>= 1;
+         }
+     }
+
+     isbnFolge.schluessel = schluessel;
+     isbnFolge.nummer = nummer;
+     isbnFolge.anzahl = anzahl;
+     isbnFolge.gueltig = 1;
+     return 1;
+ }
+
+ /**
+  * Gibt den Speicher der ISBN-Folge frei
+  */
+ void isbnFolgeFreigeben() {
+     free(isbnFolge.schluessel);
+     free(isbnFolge.nummer);
+     isbnFolge.schluessel = NULL;
+     isbnFolge.nummer = NULL;
+     isbnFolge.anzahl = 0;
+     isbnFolge.gueltig = 0;
+ }
+
+ /**
+  * Bestimmt die Nummer des ersten Buches im Titel-Index mit mindestens der
+  * gegebenen ISBN. Der Abstieg ist verzweigungsfrei (die Richtung wird als
+  * 0 oder 1 addiert) und lädt die Cache-Zeile drei Ebenen tiefer vorab, sodass
+  * sich die Speicherzugriffe mehrerer Ebenen überlappen. Nur bei gültiger
+  * ISBN-Folge aufrufen.
+  * @param isbn Vergleichs-ISBN
+  * @return Buchnummer (anzahl, wenn alle ISBNs kleiner sind)
+  */
+ unsigned int isbnFolgeUntergrenze(uint64_t isbn) {
+     const uint64_t* schluessel = isbnFolge.schluessel;
+     size_t anzahl = isbnFolge.anzahl;
+     size_t k = 1;
+     while (k <= anzahl) {
+         __builtin_prefetch(schluessel + k * EYTZINGER_VORAUS);
+         k = 2 * k + (schluessel[k] < isbn);
+     }
+     // Die zuletzt nach links abgebogene Position ist die gesuchte (0 = keine)
+     k >>= __builtin_ffsll((long long)~k);
+     return isbnFolge.nummer[k];
+ }
+
+ /**
+  * Initialisiert einen leeren Knotenstapel
+  * @param stapel Der zu initialisierende Stapel
+  */
+ void stapelInitialisieren(KnotenStapel* stapel) {
+     stapel->eintraege = stapel->lokal;
+     stapel->anzahl = 0;
+     stapel->kapazitaet = MAX_BAUMHOEHE;
+ }
+
+ /**
+  * Legt einen Knoten auf den Stapel und vergrößert ihn bei Bedarf
+  * @param stapel Der Stapel
+  * @param knoten Der abzulegende Knoten
+  * @return 1 bei Erfolg, 0 wenn kein Speicher mehr reserviert werden konnte
+  */
+ int stapelAblegen(KnotenStapel* stapel, Buch* knoten) {
+     if (stapel->anzahl == stapel->kapazitaet) {
+         int neueKapazitaet = stapel->kapazitaet * 2;
+         Buch** neu;
+
+         if (stapel->eintraege == stapel->lokal) {
+             neu = (Buch**)malloc(neueKapazitaet * sizeof(Buch*));
+             if (neu != NULL) {
+                 memcpy(neu, stapel->lokal, stapel->anzahl * sizeof(Buch*));
+             }
+         } else {
+             neu = (Buch**)realloc(stapel->eintraege, neueKapazitaet * sizeof(Buch*));
+         }
+
+         if (neu == NULL) {
+             printf("Fehler bei der Speicherreservierung!\n");
+             return 0;
+         }
+         stapel->eintraege = neu;
+         stapel->kapazitaet = neueKapazitaet;
+     }
+
+     stapel->eintraege[stapel->anzahl++] = knoten;
+     return 1;
+ }
+
+ /**
+  * Entnimmt den obersten Knoten vom Stapel
+  * @param stapel Der Stapel
+  * @return Oberster Knoten oder NULL, wenn der Stapel leer ist
+  */
+ Buch* stapelEntnehmen(KnotenStapel* stapel) {
+     return stapel->anzahl > 0 ? stapel->eintraege[--stapel->anzahl] : NULL;
+ }
+
+ /**
+  * Gibt den Heap-Speicher eines Stapels frei (falls er vergrößert wurde)
+  * @param stapel Der Stapel
+  */
+ void stapelFreigeben(KnotenStapel* stapel) {
+     if (stapel->eintraege != stapel->lokal) {
+         free(stapel->eintraege);
+     }
+     stapelInitialisieren(stapel);
+ }
+
+ /**
+  * Konvertiert einen String zu Kleinbuchstaben
+  * @param str Der zu konvertierende String
+  */
+ void zuKleinbuchstaben(char* str) {
+     // Jeden Buchstaben zu Kleinbuchstaben konvertieren
+     for (int i = 0; str[i]; i++) {
+         str[i] = tolower(str[i]);
+     }
+ }
+
+ /**
+  * Wandelt ein einzelnes Zeichen in einen Kleinbuchstaben um. Entspricht tolower()
+  * im Standard-Locale "C" (nur A-Z werden umgewandelt), kommt aber ohne
+  * Funktionsaufruf und Tabellenzugriff aus.
+  * @param zeichen Das umzuwandelnde Zeichen
+  * @return Das Zeichen als Kleinbuchstabe
+  */
+ unsigned char zeichenFalten(unsigned char zeichen) {
+     return (unsigned char)((unsigned int)(zeichen - 'A') < 26u ? zeichen + ('a' - 'A') : zeichen);
+ }
+
+ /**
+  * Bereitet einen Suchbegriff für musterSuchen vor: Der Begriff wird einmal in
+  * Kleinbuchstaben umgewandelt und die Horspool-Sprungtabelle berechnet.
+  * Wie bisher werden höchstens MAX_TITEL_LAENGE - 1 Zeichen berücksichtigt.
+  * @param muster Das vorzubereitende Suchmuster
+  * @param teilstring Der zu suchende Teilstring (NULL wird wie "" behandelt)
+  */
+ void musterVorbereiten(Suchmuster* muster, const char* teilstring) {
+     muster->laenge = 0;
+     while (teilstring != NULL && teilstring[muster->laenge] != '\0' && muster->laenge < MAX_TITEL_LAENGE - 1) {
+         muster->muster[muster->laenge] = zeichenFalten((unsigned char)teilstring[muster->laenge]);
+         muster->laenge++;
+     }
+
+     // Zeichen, die im Suchbegriff (außer an der letzten Stelle) nicht vorkommen,
+     // erlauben eine Verschiebung um die volle Länge
+     memset(muster->sprung, (int)(muster->laenge > 0 ? muster->laenge : 1), sizeof(muster->sprung));
+     for (size_t i = 0; i + 1 < muster->laenge; i++) {
+         muster->sprung[muster->muster[i]] = (unsigned char)(muster->laenge - 1 - i);
+     }
+ }
+
+ /**
+  * Sucht einen vorbereiteten Suchbegriff case-insensitiv in einem Text
+  * (Boyer-Moore-Horspool über kleingeschriebene Zeichen). Der Text wird direkt
+  * gelesen, es werden weder Kopien angelegt noch Speicher reserviert.
+  * @param muster Mit musterVorbereiten vorbereiteter Suchbegriff
+  * @param text Der zu durchsuchende Text
+  * @param laenge Länge des Textes in Bytes
+  * @return Position des ersten Vorkommens oder KEIN_TREFFER
+  */
+ size_t musterFinden(const Suchmuster* muster, const char* text, size_t laenge) {
+     // Leerer Suchbegriff passt zu allem
+     if (muster->laenge == 0) {
+         return 0;
+     }
+     if (text == NULL || laenge < muster->laenge) {
+         return KEIN_TREFFER;
+     }
+
+     const unsigned char* zeichen = (const unsigned char*)text;
+     size_t letzte = muster->laenge - 1;
+     unsigned char letztesZeichen = muster->muster[letzte];
+
+     for (size_t position = 0; position + letzte < laenge; ) {
+         unsigned char c = zeichenFalten(zeichen[position + letzte]);
+
+         // Erst das letzte Zeichen, dann den Rest von vorne vergleichen
+         if (c == letztesZeichen) {
+             size_t i = 0;
+             while (i < letzte && zeichenFalten(zeichen[position + i]) == muster->muster[i]) {
+                 i++;
+             }
+             if (i == letzte) {
+                 return position;
+             }
+         }
+
+         position += muster->sprung[c];
+     }
+
+     return KEIN_TREFFER;
+ }
+
+ /**
+  * Prüft, ob ein vorbereiteter Suchbegriff case-insensitiv in einem Text vorkommt
+  * @param muster Mit musterVorbereiten vorbereiteter Suchbegriff
+  * @param text Der zu durchsuchende Text
+  * @param laenge Länge des Textes in Bytes
+  * @return 1 wenn der Suchbegriff gefunden wurde, sonst 0
+  */
+ int musterSuchen(const Suchmuster* muster, const char* text, size_t laenge) {
+     return musterFinden(muster, text, laenge) != KEIN_TREFFER;
+ }
+
+ /**
+  * Vergleicht die inneren Zeichen eines Suchbegriffs (ohne erstes und letztes)
+  * case-insensitiv mit einer Textstelle
+  * @return 1 bei Übereinstimmung, sonst 0
+  */
+ int musterMitteVergleichen(const Suchmuster* muster, const unsigned char* stelle) {
+     for (size_t i = 1; i + 1 < muster->laenge; i++) {
+         if (zeichenFalten(stelle[i]) != muster->muster[i]) {
+             return 0;
+         }
+     }
+     return 1;
+ }
+
+ /**
+  * Liefert zu einem Kleinbuchstaben den Großbuchstaben (andere Zeichen unverändert)
+  */
+ unsigned char zeichenGross(unsigned char zeichen) {
+     return (unsigned char)((unsigned int)(zeichen - 'a') < 26u ? zeichen - ('a' - 'A') : zeichen);
+ }
+
+ #ifdef SIMD_VERFUEGBAR
+
+ /**
+  * SSE2-Variante von musterFinden für lange, flache Puffer: Pro Schritt werden
+  * 16 mögliche Startpositionen geprüft, indem erstes und letztes Zeichen des
+  * Suchbegriffs (jeweils in Klein- und Großschreibung) mit dem Text verglichen
+  * werden. Nur die verbleibenden Kandidaten werden vollständig verglichen.
+  * Wie der AVX2-Kern für den Befehlssatz übersetzt, damit er auch auf i386
+  * ohne -msse2 gebaut wird; aufgerufen wird er erst nach der Laufzeitprüfung.
+  */
+ __attribute__((target("sse2")))
+ size_t musterFindenSse2(const Suchmuster* muster, const char* text, size_t laenge) {
+     size_t m = muster->laenge;
+     if (m == 0 || laenge < m) {
+         return musterFinden(muster, text, laenge);
+     }
+
+     const unsigned char* zeichen = (const unsigned char*)text;
+     unsigned char erstes = muster->muster[0];
+     unsigned char letztes = muster->muster[m - 1];
+     __m128i ersteKlein = _mm_set1_epi8((char)erstes);
+     __m128i ersteGross = _mm_set1_epi8((char)zeichenGross(erstes));
+     __m128i letzteKlein = _mm_set1_epi8((char)letztes);
+     __m128i letzteGross = _mm_set1_epi8((char)zeichenGross(letztes));
+
+     size_t position = 0;
+     for (; position + m - 1 + 16 <= laenge; position += 16) {
+         __m128i anfang = _mm_loadu_si128((const __m128i*)(zeichen + position));
+         __m128i ende = _mm_loadu_si128((const __m128i*)(zeichen + position + m - 1));
+         __m128i passtAnfang = _mm_or_si128(_mm_cmpeq_epi8(anfang, ersteKlein), _mm_cmpeq_epi8(anfang, ersteGross));
+         __m128i passtEnde = _mm_or_si128(_mm_cmpeq_epi8(ende, letzteKlein), _mm_cmpeq_epi8(ende, letzteGross));
+         unsigned int kandidaten = (unsigned int)_mm_movemask_epi8(_mm_and_si128(passtAnfang, passtEnde));
+
+         while (kandidaten != 0) {
+             unsigned int bit = (unsigned int)__builtin_ctz(kandidaten);
+             if (musterMitteVergleichen(muster, zeichen + position + bit)) {
+                 return position + bit;
+             }
+             kandidaten &= kandidaten - 1;
+         }
+     }
+
+     // Rest, für den kein voller Block mehr gelesen werden kann
+     size_t rest = musterFinden(muster, text + position, laenge - position);
+     return rest == KEIN_TREFFER ? KEIN_TREFFER : position + rest;
+ }
+
+ /**
+  * AVX2-Variante von musterFindenSse2 mit 32 Startpositionen pro Schritt
+  */
+ __attribute__((target("avx2")))
+ size_t musterFindenAvx2(const Suchmuster* muster, const char* text, size_t laenge) {
+     size_t m = muster->laenge;
+     if (m == 0 || laenge < m) {
+         return musterFinden(muster, text, laenge);
+     }
+
+     const unsigned char* zeichen = (const unsigned char*)text;
+     unsigned char erstes = muster->muster[0];
+     unsigned char letztes = muster->muster[m - 1];
+     __m256i ersteKlein = _mm256_set1_epi8((char)erstes);
+     __m256i ersteGross = _mm256_set1_epi8((char)zeichenGross(erstes));
+     __m256i letzteKlein = _mm256_set1_epi8((char)letztes);
+     __m256i letzteGross = _mm256_set1_epi8((char)zeichenGross(letztes));
+
+     size_t position = 0;
+     for (; position + m - 1 + 32 <= laenge; position += 32) {
+         __m256i anfang = _mm256_loadu_si256((const __m256i*)(zeichen + position));
+         __m256i ende = _mm256_loadu_si256((const __m256i*)(zeichen + position + m - 1));
+         __m256i passtAnfang = _mm256_or_si256(_mm256_cmpeq_epi8(anfang, ersteKlein), _mm256_cmpeq_epi8(anfang, ersteGross));
+         __m256i passtEnde = _mm256_or_si256(_mm256_cmpeq_epi8(ende, letzteKlein), _mm256_cmpeq_epi8(ende, letzteGross));
+         unsigned int kandidaten = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(passtAnfang, passtEnde));
+
+         while (kandidaten != 0) {
+             unsigned int bit = (unsigned int)__builtin_ctz(kandidaten);
+             if (musterMitteVergleichen(muster, zeichen + position + bit)) {
+                 return position + bit;
+             }
+             kandidaten &= kandidaten - 1;
+         }
+     }
+
+     size_t rest = musterFinden(muster, text + position, laenge - position);
+     return rest == KEIN_TREFFER ? KEIN_TREFFER : position + rest;
+ }
+
+ #else
+
+ // Ohne x86-Vektorbefehle verwenden alle Stufen die skalare Suche
+ size_t musterFindenSse2(const Suchmuster* muster, const char* text, size_t laenge) {
+     return musterFinden(muster, text, laenge);
+ }
+
+ size_t musterFindenAvx2(const Suchmuster* muster, const char* text, size_t laenge) {
+     return musterFinden(muster, text, laenge);
+ }
+
+ #endif
+
+ /**
+  * Ermittelt zur Laufzeit die höchste vom Prozessor unterstützte SIMD-Stufe
+  * @return SIMD_AVX2, SIMD_SSE2 oder SIMD_SKALAR
+  */
+ SimdStufe simdStufeErmitteln() {
+ #ifdef SIMD_VERFUEGBAR
+     __builtin_cpu_init();
+     if (__builtin_cpu_supports("avx2")) {
+         return SIMD_AVX2;
+     }
+     if (__builtin_cpu_supports("sse2")) {
+         return SIMD_SSE2;
+     }
+ #endif
+     return SIMD_SKALAR;
+ }
+
+ /**
+  * Legt die SIMD-Stufe für die flache Titelsuche fest. Stufen, die der Prozessor
+  * nicht unterstützt, werden auf die höchste verfügbare Stufe begrenzt.
+  * @param stufe Gewünschte Stufe
+  */
+ void simdStufeSetzen(SimdStufe stufe) {
+     SimdStufe verfuegbar = simdStufeErmitteln();
+     simdStufe = stufe < verfuegbar ? stufe : verfuegbar;
+     simdStufeGewaehlt = 1;
+ }
+
+ /**
+  * Sucht einen Suchbegriff mit dem zur Laufzeit gewählten Suchkern
+  * (AVX2, SSE2 oder skalar) in einem langen Puffer
+  * @return Position des ersten Vorkommens oder KEIN_TREFFER
+  */
+ size_t musterFindenVektor(const Suchmuster* muster, const char* text, size_t laenge) {
+     if (!simdStufeGewaehlt) {
+         simdStufeSetzen(SIMD_AVX2);
+     }
+
+     switch (simdStufe) {
+         case SIMD_AVX2:
+             return musterFindenAvx2(muster, text, laenge);
+         case SIMD_SSE2:
+             return musterFindenSse2(muster, text, laenge);
+         default:
+             return musterFinden(muster, text, laenge);
+     }
+ }
+
+ /**
+  * Prüft, ob ein Teilstring in einem String enthalten ist (case-insensitiv).
+  * Für wiederholte Suchen mit demselben Teilstring musterVorbereiten und
+  * musterSuchen direkt verwenden, damit der Suchbegriff nur einmal umgewandelt wird.
+  * @param quelle Der zu durchsuchende String
+  * @param teilstring Der zu suchende Teilstring
+  * @return 1 wenn der Teilstring gefunden wurde, sonst 0
+  */
+ int enthältTeilstring(const char* quelle, const char* teilstring) {
+     // Wenn der Teilstring leer ist, geben wir true zurück - leerer Suchbegriff passt zu allem
+     if (teilstring == NULL || teilstring[0] == '\0') {
+         return 1;
+     }
+
+     // Wenn die Quelle leer ist, geben wir false zurück
+     if (quelle == NULL || quelle[0] == '\0') {
+         return 0;
+     }
+
+     Suchmuster muster;
+     musterVorbereiten(&muster, teilstring);
+     return musterSuchen(&muster, quelle, strlen(quelle));
+ }
+
+ /**
+  * Suche nach Büchern mit einem bestimmten Titel (case-insensitiv) ab einer
+  * ISBN. Der Baum wird iterativ in ISBN-Reihenfolge (In-Order) mit einem
+  * expliziten Stapel durchlaufen, beginnend beim ersten Buch ab abIsbn;
+  * die Suche endet, sobald maxResults Treffer gefunden sind.
+  * @param wurzelKnoten Wurzel des zu durchsuchenden (Teil-)Baums
+  * @param muster Vorbereiteter Suchbegriff
+  * @param abIsbn Nur Bücher mit mindestens dieser ISBN werden geprüft (0 = alle)
+  * @param treffer Array, das die gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher
+  */
+ int baumTitelSuchenAb(Buch* wurzelKnoten, const Suchmuster* muster, uint64_t abIsbn, Buch** treffer, int maxResults) {
+     KnotenStapel stapel;
+     stapelInitialisieren(&stapel);
+
+     // Pfad zum ersten Buch ab abIsbn auf den Stapel legen
+     Buch* knoten = wurzelKnoten;
+     while (knoten != NULL) {
+         if (knoten->isbn >= abIsbn) {
+             if (!stapelAblegen(&stapel, knoten)) {
+                 stapelFreigeben(&stapel);
+                 return 0;
+             }
+             knoten = knotenZeiger(knoten->links);
+         } else {
+             knoten = knotenZeiger(knoten->rechts);
+         }
+     }
+
+     int aktuelleAnzahl = 0;
+     while (aktuelleAnzahl < maxResults && (knoten != NULL || stapel.anzahl > 0)) {
+         // Linken Rand des Teilbaums auf den Stapel legen
+         while (knoten != NULL) {
+             if (!stapelAblegen(&stapel, knoten)) {
+                 stapelFreigeben(&stapel);
+                 return aktuelleAnzahl;
+             }
+             knoten = knotenZeiger(knoten->links);
+         }
+
+         // Kleinsten noch nicht besuchten Knoten verarbeiten
+         knoten = stapelEntnehmen(&stapel);
+
+         // Prüfen, ob der aktuelle Knoten dem Suchkriterium entspricht
+         if (musterSuchen(muster, buchTitel(knoten), buchDaten(knoten)->titelLaenge)) {
+             treffer[aktuelleAnzahl++] = knoten;
+         }
+
+         // Dann im rechten Teilbaum weitersuchen
+         knoten = knotenZeiger(knoten->rechts);
+     }
+
+     stapelFreigeben(&stapel);
+     return aktuelleAnzahl;
+ }
+
+ /**
+  * Suche nach Büchern mit einem bestimmten Titel (case-insensitiv) durch
+  * Traversierung des Baums in ISBN-Reihenfolge (siehe baumTitelSuchenAb)
+  * @param wurzelKnoten Wurzel des zu durchsuchenden (Teil-)Baums
+  * @param titel Zu suchender Titel (Teil des Titels)
+  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher
+  */
+ int büchernachTitelSuchenIterativ(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+     if (maxResults <= 0) {
+         return 0;
+     }
+
+     Buch** treffer = (Buch**)malloc((size_t)maxResults * sizeof(Buch*));
+     if (treffer == NULL) {
+         return 0;
+     }
+
+     // Suchbegriff nur einmal pro Suche umwandeln
+     Suchmuster muster;
+     musterVorbereiten(&muster, titel);
+
+     int gefunden = baumTitelSuchenAb(wurzelKnoten, &muster, 0, treffer, maxResults);
+     trefferAlsIsbnListe(treffer, gefunden, isbnListe);
+     free(treffer);
+     return gefunden;
+ }
+
+ /* Titel-Index für die Titelsuche (Trigramme und flacher Titelpuffer) */
+
+ /**
+  * Bildet ein Trigramm auf die Nummer seiner Postingliste ab. Verschiedene
+  * Trigramme können dieselbe Liste teilen; das führt nur zu zusätzlichen
+  * Kandidaten, die beim abschließenden Teilstring-Vergleich aussortiert werden.
+  * @param zeichen Drei bereits in Kleinbuchstaben umgewandelte Zeichen
+  * @return Nummer der Postingliste (kleiner als TRIGRAMM_LISTEN)
+  */
+ unsigned int trigrammListe(const unsigned char* zeichen) {
+     unsigned int trigramm = ((unsigned int)zeichen[0] << 16) | ((unsigned int)zeichen[1] << 8) | zeichen[2];
+     return (trigramm * 2654435761u) >> (32 - TRIGRAMM_BITS);
+ }
+
+ /**
+  * Ruft für jedes Trigramm eines Titels die Postingliste ab und zählt bzw. füllt sie.
+  * Kommt dasselbe Trigramm mehrfach im Titel vor, wird das Buch nur einmal eingetragen.
+  * @param buchNummer Nummer des Buches
+  * @param titel Titel des Buches
+  * @param letztesBuch Pro Liste die zuletzt eingetragene Buchnummer (+1, 0 = keine)
+  * @param position Zähler (Zählphase) bzw. Schreibposition (Füllphase) pro Liste
+  * @param postings NULL in der Zählphase, sonst das zu füllende Posting-Array
+  */
+ void trigrammeEintragen(unsigned int buchNummer, const char* titel, unsigned int* letztesBuch,
+                         size_t* position, unsigned int* postings) {
+     unsigned char fenster[3] = { 0, 0, 0 };
+     int gefuellt = 0;
+
+     for (const char* c = titel; *c; c++) {
+         fenster[0] = fenster[1];
+         fenster[1] = fenster[2];
+         fenster[2] = zeichenFalten((unsigned char)*c);
+         if (++gefuellt < 3) {
+             continue;
+         }
+
+         unsigned int liste = trigrammListe(fenster);
+         if (letztesBuch[liste] == buchNummer + 1) {
+             continue;
+         }
+         letztesBuch[liste] = buchNummer + 1;
+
+         if (postings == NULL) {
+             position[liste]++;
+         } else {
+             postings[position[liste]++] = buchNummer;
+         }
+     }
+ }
+
+ /**
+  * Legt die Titel aller Bücher in ISBN-Reihenfolge lückenlos in einem neuen
+  * Titel-Pool ab und passt die Verweise der Bücher an. Titel
+  * überschriebener Bücher fallen dabei weg.
+  * @param buecher Alle Bücher in ISBN-Reihenfolge
+  * @param anzahl Anzahl der Bücher
+  * @return 1 bei Erfolg, 0 bei Speichermangel (der bisherige Pool bleibt dann erhalten)
+  */
+ int titelPoolOrdnen(Buch** buecher, unsigned int anzahl) {
+     size_t benoetigt = 0;
+     for (unsigned int i = 0; i < anzahl; i++) {
+         benoetigt += (size_t)buchDaten(buecher[i])->titelLaenge + 1;
+     }
+
+     char* daten = (char*)malloc(benoetigt > 0 ? benoetigt : 1);
+     if (daten == NULL) {
+         return 0;
+     }
+
+     size_t laenge = 0;
+     for (unsigned int i = 0; i < anzahl; i++) {
+         Buch* buch = buecher[i];
+         BuchDaten* buchdaten = buchDaten(buch);
+         memcpy(daten + laenge, buchTitel(buch), (size_t)buchdaten->titelLaenge + 1);
+         buchdaten->titelOffset = laenge;
+         laenge += (size_t)buchdaten->titelLaenge + 1;
+     }
+
+     if (!imKatalogAbbild(titelPool.daten)) {
+         free(titelPool.daten);
+     }
+     titelPool.daten = daten;
+     titelPool.laenge = laenge;
+     titelPool.kapazitaet = benoetigt > 0 ? benoetigt : 1;
+     return 1;
+ }
+
+ /**
+  * Baut den Titel-Index über alle Titel des Katalogs auf. Die Bücher werden
+  * in ISBN-Reihenfolge nummeriert und ihre Titel in dieser Reihenfolge im Pool
+  * abgelegt. Die Postinglisten werden in zwei Durchläufen (Zählen, dann Füllen)
+  * in einem einzigen zusammenhängenden Array angelegt.
+  * @return 1 bei Erfolg, 0 bei Speichermangel (die Titelsuche durchläuft dann den Baum)
+  */
+ int titelIndexAufbauen() {
+     titelIndexFreigeben();
+
+     // Bücher in ISBN-Reihenfolge einsammeln
+     size_t anzahl = buchArena.anzahlKnoten;
+     Buch** buecher = (Buch**)malloc((anzahl > 0 ? anzahl : 1) * sizeof(Buch*));
+     size_t* position = (size_t*)calloc(TRIGRAMM_LISTEN + 1, sizeof(size_t));
+     unsigned int* letztesBuch = (unsigned int*)calloc(TRIGRAMM_LISTEN, sizeof(unsigned int));
+     if (buecher == NULL || position == NULL || letztesBuch == NULL) {
+         free(buecher);
+         free(position);
+         free(letztesBuch);
+         return 0;
+     }
+
+     KnotenStapel stapel;
+     stapelInitialisieren(&stapel);
+     unsigned int nummer = 0;
+     Buch* knoten = wurzel;
+     while (knoten != NULL || stapel.anzahl > 0) {
+         while (knoten != NULL) {
+             if (!stapelAblegen(&stapel, knoten)) {
+                 stapelFreigeben(&stapel);
+                 free(buecher);
+                 free(position);
+                 free(letztesBuch);
+                 return 0;
+             }
+             knoten = knotenZeiger(knoten->links);
+         }
+         knoten = stapelEntnehmen(&stapel);
+         buecher[nummer++] = knoten;
+         knoten = knotenZeiger(knoten->rechts);
+     }
+     stapelFreigeben(&stapel);
+
+     if (!titelPoolOrdnen(buecher, nummer)) {
+         free(buecher);
+         free(position);
+         free(letztesBuch);
+         return 0;
+     }
+
+     // Zählphase: Länge jeder Postingliste bestimmen
+     for (unsigned int i = 0; i < nummer; i++) {
+         trigrammeEintragen(i, buchTitel(buecher[i]), letztesBuch, position, NULL);
+     }
+
+     // Längen in Anfangspositionen umrechnen
+     size_t summe = 0;
+     for (unsigned int liste = 0; liste <= TRIGRAMM_LISTEN; liste++) {
+         size_t laenge = position[liste];
+         position[liste] = summe;
+         summe += laenge;
+     }
+
+     size_t* listenAnfang = (size_t*)malloc((TRIGRAMM_LISTEN + 1) * sizeof(size_t));
+     unsigned int* postings = (unsigned int*)malloc((summe > 0 ? summe : 1) * sizeof(unsigned int));
+     if (listenAnfang == NULL || postings == NULL) {
+         free(listenAnfang);
+         free(postings);
+         free(buecher);
+         free(position);
+         free(letztesBuch);
+         return 0;
+     }
+     memcpy(listenAnfang, position, (TRIGRAMM_LISTEN + 1) * sizeof(size_t));
+
+     // Füllphase: Buchnummern eintragen (aufsteigend, da die Bücher sortiert vorliegen)
+     memset(letztesBuch, 0, TRIGRAMM_LISTEN * sizeof(unsigned int));
+     for (unsigned int i = 0; i < nummer; i++) {
+         trigrammeEintragen(i, buchTitel(buecher[i]), letztesBuch, position, postings);
+     }
+
+     free(position);
+     free(letztesBuch);
+
+     titelIndex.buecher = buecher;
+     titelIndex.anzahlBuecher = nummer;
+     titelIndex.listenAnfang = listenAnfang;
+     titelIndex.postings = postings;
+     titelIndex.gueltig = 1;
+
+     // Geordnete ISBN-Suchen über dieselbe Nummerierung
+     isbnFolgeAufbauen();
+     return 1;
+ }
+
+ /**
+  * Gibt den Speicher des Titel-Index frei
+  */
+ void titelIndexFreigeben() {
+     // Die ISBN-Folge verweist auf die Nummern des Titel-Index
+     isbnFolgeFreigeben();
+
+     free(titelIndex.buecher);
+     if (!imKatalogAbbild(titelIndex.listenAnfang)) {
+         free(titelIndex.listenAnfang);
+     }
+     if (!imKatalogAbbild(titelIndex.postings)) {
+         free(titelIndex.postings);
+     }
+     titelIndex.buecher = NULL;
+     titelIndex.anzahlBuecher = 0;
+     titelIndex.listenAnfang = NULL;
+     titelIndex.postings = NULL;
+     titelIndex.gueltig = 0;
+ }
+
+ /**
+  * Sucht in einer aufsteigend sortierten Postingliste den ersten Eintrag >= ziel.
+  * Die Schrittweite wird verdoppelt (Galoppieren), danach binär eingegrenzt.
+  * @param liste Beginn der Restliste
+  * @param laenge Länge der Restliste
+  * @param ziel Gesuchte Buchnummer
+  * @return Position des ersten Eintrags >= ziel (laenge, wenn keiner existiert)
+  */
+ size_t postingGaloppieren(const unsigned int* liste, size_t laenge, unsigned int ziel) {
+     size_t oben = 1;
+     while (oben < laenge && liste[oben - 1] < ziel) {
+         oben *= 2;
+     }
+
+     size_t unten = oben / 2;
+     if (oben > laenge) {
+         oben = laenge;
+     }
+     while (unten < oben) {
+         size_t mitte = unten + (oben - unten) / 2;
+         if (liste[mitte] < ziel) {
+             unten = mitte + 1;
+         } else {
+             oben = mitte;
+         }
+     }
+     return unten;
+ }
+
+ /**
+  * Sucht Bücher über den Trigramm-Index. Die Postinglisten aller Trigramme des
+  * Suchbegriffs werden geschnitten (beginnend mit der kürzesten), die verbleibenden
+  * Kandidaten anschließend mit musterSuchen geprüft. Das Ergebnis ist damit
+  * identisch zur Baumtraversierung, einschließlich der ISBN-Reihenfolge.
+  * @param muster Vorbereiteter Suchbegriff
+  * @param ab Nummer des ersten zu prüfenden Buches
+  * @param treffer Array, das die gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher oder -1, wenn der Index nicht verwendet werden kann
+  *         (Index veraltet, Suchbegriff kürzer als drei Zeichen oder zu unspezifisch)
+  */
+ int trigrammKandidatenSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults) {
+     if (!titelIndex.gueltig) {
+         return -1;
+     }
+
+     const unsigned char* suchbegriff = muster->muster;
+     size_t laenge = muster->laenge;
+     if (laenge < 3) {
+         return -1;
+     }
+
+     // Postinglisten aller Trigramme bestimmen und nach Länge sortieren
+     const unsigned int* listen[MAX_TITEL_LAENGE];
+     size_t laengen[MAX_TITEL_LAENGE];
+     int anzahlListen = 0;
+
+     for (size_t i = 0; i + 3 <= laenge; i++) {
+         unsigned int liste = trigrammListe(&suchbegriff[i]);
+         const unsigned int* beginn = titelIndex.postings + titelIndex.listenAnfang[liste];
+         size_t listenLaenge = titelIndex.listenAnfang[liste + 1] - titelIndex.listenAnfang[liste];
+
+         // Dieselbe Liste nur einmal berücksichtigen
+         int doppelt = 0;
+         for (int j = 0; j < anzahlListen; j++) {
+             if (listen[j] == beginn) {
+                 doppelt = 1;
+                 break;
+             }
+         }
+         if (doppelt) {
+             continue;
+         }
+
+         // Einfügen nach aufsteigender Länge
+         int j = anzahlListen++;
+         while (j > 0 && laengen[j - 1] > listenLaenge) {
+             listen[j] = listen[j - 1];
+             laengen[j] = laengen[j - 1];
+             j--;
+         }
+         listen[j] = beginn;
+         laengen[j] = listenLaenge;
+     }
+
+     // Bei sehr langen Listen ist der lineare Durchlauf des Titelpuffers schneller
+     if (laengen[0] > titelIndex.anzahlBuecher / TRIGRAMM_SELEKTIVITAET) {
+         return -1;
+     }
+
+     // Kandidaten aus der kürzesten Liste in den übrigen Listen suchen
+     int aktuelleAnzahl = 0;
+     size_t positionen[MAX_TITEL_LAENGE] = { 0 };
+
+     size_t erster = postingGaloppieren(listen[0], laengen[0], ab);
+     for (size_t k = erster; k < laengen[0] && aktuelleAnzahl < maxResults; k++) {
+         unsigned int kandidat = listen[0][k];
+         int inAllenListen = 1;
+
+         for (int j = 1; j < anzahlListen; j++) {
+             positionen[j] += postingGaloppieren(listen[j] + positionen[j], laengen[j] - positionen[j], kandidat);
+             if (positionen[j] == laengen[j]) {
+                 // Eine Liste ist erschöpft: es kann keine weiteren Treffer geben
+                 return aktuelleAnzahl;
+             }
+             if (listen[j][positionen[j]] != kandidat) {
+                 inAllenListen = 0;
+                 break;
+             }
+         }
+
+         // Abschließende Prüfung mit derselben Vergleichsfunktion wie bei der Traversierung
+         Buch* buch = titelIndex.buecher[kandidat];
+         if (inAllenListen && musterSuchen(muster, buchTitel(buch), buchDaten(buch)->titelLaenge)) {
+             treffer[aktuelleAnzahl++] = buch;
+         }
+     }
+
+     return aktuelleAnzahl;
+ }
+
+ /**
+  * Sucht Bücher über den Trigramm-Index (siehe trigrammKandidatenSuchen)
+  * @param titel Zu suchender Titel (Teil des Titels)
+  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher oder -1, wenn der Index nicht verwendet werden kann
+  */
+ int trigrammTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+     if (maxResults <= 0) {
+         return 0;
+     }
+
+     Buch** treffer = (Buch**)malloc((size_t)maxResults * sizeof(Buch*));
+     if (treffer == NULL) {
+         return -1;
+     }
+
+     Suchmuster muster;
+     musterVorbereiten(&muster, titel);
+
+     int gefunden = trigrammKandidatenSuchen(&muster, 0, treffer, maxResults);
+     trefferAlsIsbnListe(treffer, gefunden, isbnListe);
+     free(treffer);
+     return gefunden;
+ }
+
+ /**
+  * Durchsucht die Titel der Bücher von..bis-1 im flachen Titel-Pool mit dem zur
+  * Laufzeit gewählten Suchkern. Die Titel liegen in ISBN-Reihenfolge hintereinander,
+  * getrennt durch '\0', das in keinem Suchbegriff vorkommt; ein Treffer kann daher
+  * nie zwei Titel überspannen. Nach einem Treffer wird beim nächsten Titel weitergesucht.
+  * @param muster Vorbereiteter Suchbegriff
+  * @param von Nummer des ersten zu durchsuchenden Buches
+  * @param bis Nummer hinter dem letzten zu durchsuchenden Buch
+  * @param treffer Array, das die gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Treffer
+  * @param abbruchAb Bei paralleler Suche: Die Suche endet vorzeitig, sobald eine
+  *        frühere Partition als partition genug Treffer hat (sonst NULL)
+  * @param partition Nummer der durchsuchten Partition
+  * @return Anzahl gefundener Bücher
+  */
+ int titelBereichDurchsuchen(const Suchmuster* muster, unsigned int von, unsigned int bis,
+                             Buch** treffer, int maxResults, const atomic_uint* abbruchAb, unsigned int partition) {
+     if (von >= bis) {
+         return 0;
+     }
+
+     const BuchDaten* letztes = buchDaten(titelIndex.buecher[bis - 1]);
+     size_t ende = letztes->titelOffset + letztes->titelLaenge + 1;
+     size_t position = buchDaten(titelIndex.buecher[von])->titelOffset;
+     int aktuelleAnzahl = 0;
+     unsigned int naechstesBuch = von;
+
+     while (aktuelleAnzahl < maxResults && naechstesBuch < bis) {
+         if (abbruchAb != NULL && atomic_load_explicit(abbruchAb, memory_order_relaxed) < partition) {
+             break;
+         }
+
+         size_t fund = musterFindenVektor(muster, titelPool.daten + position, ende - position);
+         if (fund == KEIN_TREFFER) {
+             break;
+         }
+         fund += position;
+
+         // Buch zum Treffer bestimmen: letzter Titel, der nicht hinter dem Treffer beginnt
+         unsigned int unten = naechstesBuch;
+         unsigned int oben = bis;
+         while (oben - unten > 1) {
+             unsigned int mitte = unten + (oben - unten) / 2;
+             if (buchDaten(titelIndex.buecher[mitte])->titelOffset <= fund) {
+                 unten = mitte;
+             } else {
+                 oben = mitte;
+             }
+         }
+
+         Buch* buch = titelIndex.buecher[unten];
+         treffer[aktuelleAnzahl++] = buch;
+         naechstesBuch = unten + 1;
+         const BuchDaten* daten = buchDaten(buch);
+         position = daten->titelOffset + daten->titelLaenge + 1;
+     }
+
+     return aktuelleAnzahl;
+ }
+
+ /**
+  * Holt so lange Partitionen eines Suchauftrags ab und durchsucht sie, bis alle
+  * vergeben sind. Partitionen hinter der ersten vollständig gefüllten Partition
+  * werden übersprungen, da ihre Treffer nicht mehr unter den ersten maxResults liegen.
+  * @param auftrag Der gemeinsame Suchauftrag
+  */
+ void partitionenAbarbeiten(SuchAuftrag* auftrag) {
+     while (1) {
+         unsigned int partition = atomic_fetch_add(&auftrag->naechstePartition, 1);
+         if (partition >= auftrag->anzahlPartitionen) {
+             return;
+         }
+
+         auftrag->trefferAnzahl[partition] = 0;
+         if (atomic_load_explicit(&auftrag->abbruchAb, memory_order_relaxed) < partition) {
+             continue;
+         }
+
+         unsigned int von = auftrag->ab + partition * auftrag->buecherProPartition;
+         unsigned int bis = von + auftrag->buecherProPartition;
+         if (bis > titelIndex.anzahlBuecher || partition == auftrag->anzahlPartitionen - 1) {
+             bis = titelIndex.anzahlBuecher;
+         }
+
+         int anzahl = titelBereichDurchsuchen(auftrag->muster, von, bis,
+                                              auftrag->treffer + (size_t)partition * auftrag->maxResults,
+                                              auftrag->maxResults, &auftrag->abbruchAb, partition);
+         auftrag->trefferAnzahl[partition] = anzahl;
+
+         // Vollständig gefüllt: spätere Partitionen werden nicht mehr benötigt
+         if (anzahl == auftrag->maxResults) {
+             unsigned int bisher = atomic_load(&auftrag->abbruchAb);
+             while (partition < bisher && !atomic_compare_exchange_weak(&auftrag->abbruchAb, &bisher, partition)) {
+             }
+         }
+     }
+ }
+
+ /**
+  * Hauptschleife eines Arbeiter-Threads: Wartet auf neue Aufträge und bearbeitet
+  * jeden Auftrag genau einmal
+  */
+ void* suchArbeiter(void* argument) {
+     (void)argument;
+     unsigned long gesehen = 0;
+
+     pthread_mutex_lock(&suchPool.sperre);
+     while (1) {
+         while (!suchPool.beenden && suchPool.generation == gesehen) {
+             pthread_cond_wait(&suchPool.neuerAuftrag, &suchPool.sperre);
+         }
+         if (suchPool.beenden) {
+             break;
+         }
+         gesehen = suchPool.generation;
+         SuchAuftrag* auftrag = suchPool.auftrag;
+         pthread_mutex_unlock(&suchPool.sperre);
+
+         partitionenAbarbeiten(auftrag);
+
+         pthread_mutex_lock(&suchPool.sperre);
+         if (--suchPool.aktiveArbeiter == 0) {
+             pthread_cond_signal(&suchPool.auftragErledigt);
+         }
+     }
+     pthread_mutex_unlock(&suchPool.sperre);
+     return NULL;
+ }
+
+ /**
+  * Startet den Thread-Pool für die parallele Titelsuche
+  * @param anzahlThreads Gewünschte Anzahl Threads einschließlich des aufrufenden
+  * @return Anzahl tatsächlich nutzbarer Threads (1, wenn kein Arbeiter gestartet werden konnte)
+  */
+ int suchPoolStarten(int anzahlThreads) {
+     suchPoolBeenden();
+
+     suchPool.beenden = 0;
+     suchPool.generation = 0;
+     suchPool.aktiveArbeiter = 0;
+     suchPool.anzahlArbeiter = 0;
+     for (int i = 0; i < anzahlThreads - 1; i++) {
+         if (pthread_create(&suchPool.arbeiter[i], NULL, suchArbeiter, NULL) != 0) {
+             break;
+         }
+         suchPool.anzahlArbeiter++;
+     }
+     suchPool.gestartet = 1;
+     return suchPool.anzahlArbeiter + 1;
+ }
+
+ /**
+  * Beendet alle Arbeiter-Threads des Such-Pools
+  */
+ void suchPoolBeenden() {
+     if (!suchPool.gestartet) {
+         return;
+     }
+
+     pthread_mutex_lock(&suchPool.sperre);
+     suchPool.beenden = 1;
+     pthread_cond_broadcast(&suchPool.neuerAuftrag);
+     pthread_mutex_unlock(&suchPool.sperre);
+
+     for (int i = 0; i < suchPool.anzahlArbeiter; i++) {
+         pthread_join(suchPool.arbeiter[i], NULL);
+     }
+     suchPool.anzahlArbeiter = 0;
+     suchPool.gestartet = 0;
+ }
+
+ /**
+  * Legt die Anzahl der Threads für die flache Titelsuche fest (1 = seriell)
+  * @param anzahl Gewünschte Anzahl, wird auf 1..MAX_SUCH_THREADS begrenzt
+  */
+ void suchThreadsSetzen(int anzahl) {
+     if (anzahl < 1) {
+         anzahl = 1;
+     }
+     if (anzahl > MAX_SUCH_THREADS) {
+         anzahl = MAX_SUCH_THREADS;
+     }
+     if (suchPool.gestartet && suchPool.anzahlArbeiter + 1 != anzahl) {
+         suchPoolBeenden();
+     }
+     suchThreads = anzahl;
+ }
+
+ /**
+  * Liefert die Anzahl der Threads für die flache Titelsuche; ohne vorherige
+  * Festlegung die Anzahl der verfügbaren Prozessoren
+  */
+ int suchThreadsErmitteln() {
+     if (suchThreads == 0) {
+         suchThreadsSetzen(prozessorAnzahl());
+     }
+     return suchThreads;
+ }
+
+ /**
+  * Liefert die Anzahl der verfügbaren Prozessoren (mindestens 1)
+  */
+ int prozessorAnzahl() {
+     long prozessoren = sysconf(_SC_NPROCESSORS_ONLN);
+     return prozessoren > 0 ? (int)prozessoren : 1;
+ }
+
+ /**
+  * Durchsucht den flachen Titel-Pool parallel auf dem Thread-Pool und fügt die
+  * Treffer der Partitionen in Partitionsreihenfolge, also in ISBN-Reihenfolge,
+  * zusammen. Das Ergebnis ist identisch zur seriellen Suche.
+  * @param muster Vorbereiteter Suchbegriff
+  * @param ab Nummer des ersten zu durchsuchenden Buches
+  * @param treffer Array, das die ersten maxResults gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Treffer
+  * @return Anzahl gefundener Bücher oder -1 bei Speichermangel
+  */
+ int parallelTitelSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults) {
+     int threads = suchThreadsErmitteln();
+     if (!suchPool.gestartet) {
+         threads = suchPoolStarten(threads);
+     } else {
+         threads = suchPool.anzahlArbeiter + 1;
+     }
+
+     unsigned int anzahlBuecher = ab < titelIndex.anzahlBuecher ? titelIndex.anzahlBuecher - ab : 0;
+     unsigned int anzahlPartitionen = (unsigned int)threads * PARTITIONEN_PRO_THREAD;
+     if (anzahlPartitionen > anzahlBuecher) {
+         anzahlPartitionen = anzahlBuecher > 0 ? anzahlBuecher : 1;
+     }
+
+     SuchAuftrag auftrag;
+     auftrag.muster = muster;
+     auftrag.ab = ab;
+     auftrag.anzahlPartitionen = anzahlPartitionen;
+     auftrag.buecherProPartition = anzahlBuecher / anzahlPartitionen;
+     auftrag.maxResults = maxResults;
+     auftrag.treffer = (Buch**)malloc((size_t)anzahlPartitionen * maxResults * sizeof(Buch*));
+     auftrag.trefferAnzahl = (int*)malloc(anzahlPartitionen * sizeof(int));
+     atomic_init(&auftrag.naechstePartition, 0);
+     atomic_init(&auftrag.abbruchAb, anzahlPartitionen);
+     if (auftrag.treffer == NULL || auftrag.trefferAnzahl == NULL) {
+         free(auftrag.treffer);
+         free(auftrag.trefferAnzahl);
+         return -1;
+     }
+
+     // Auftrag an die Arbeiter verteilen und selbst mitarbeiten
+     pthread_mutex_lock(&suchPool.sperre);
+     suchPool.auftrag = &auftrag;
+     suchPool.aktiveArbeiter = suchPool.anzahlArbeiter;
+     suchPool.generation++;
+     pthread_cond_broadcast(&suchPool.neuerAuftrag);
+     pthread_mutex_unlock(&suchPool.sperre);
+
+     partitionenAbarbeiten(&auftrag);
+
+     pthread_mutex_lock(&suchPool.sperre);
+     while (suchPool.aktiveArbeiter > 0) {
+         pthread_cond_wait(&suchPool.auftragErledigt, &suchPool.sperre);
+     }
+     pthread_mutex_unlock(&suchPool.sperre);
+
+     // Treffer in Partitionsreihenfolge zusammenführen
+     int aktuelleAnzahl = 0;
+     for (unsigned int partition = 0; partition < anzahlPartitionen && aktuelleAnzahl < maxResults; partition++) {
+         Buch** partitionsTreffer = auftrag.treffer + (size_t)partition * maxResults;
+         for (int i = 0; i < auftrag.trefferAnzahl[partition] && aktuelleAnzahl < maxResults; i++) {
+             treffer[aktuelleAnzahl++] = partitionsTreffer[i];
+         }
+     }
+
+     free(auftrag.treffer);
+     free(auftrag.trefferAnzahl);
+     return aktuelleAnzahl;
+ }
+
+ /**
+  * Durchsucht den flachen Titel-Pool ab einem Buch, bei mehreren Threads
+  * parallel in Partitionen
+  * @param muster Vorbereiteter Suchbegriff
+  * @param ab Nummer des ersten zu durchsuchenden Buches
+  * @param treffer Array, das die gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher oder -1, wenn der Index veraltet ist
+  */
+ int flachBereichSuchen(const Suchmuster* muster, unsigned int ab, Buch** treffer, int maxResults) {
+     if (!titelIndex.gueltig) {
+         return -1;
+     }
+
+     int gefunden = -1;
+     if (suchThreadsErmitteln() > 1) {
+         gefunden = parallelTitelSuchen(muster, ab, treffer, maxResults);
+     }
+     if (gefunden < 0) {
+         gefunden = titelBereichDurchsuchen(muster, ab, titelIndex.anzahlBuecher, treffer, maxResults, NULL, 0);
+     }
+     return gefunden;
+ }
+
+ /**
+  * Durchsucht den flachen Titel-Pool (siehe flachBereichSuchen)
+  * @param titel Zu suchender Titel (Teil des Titels)
+  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher oder -1, wenn der Index veraltet ist
+  */
+ int flachTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+     if (maxResults <= 0) {
+         return titelIndex.gueltig ? 0 : -1;
+     }
+
+     Buch** treffer = (Buch**)malloc((size_t)maxResults * sizeof(Buch*));
+     if (treffer == NULL) {
+         return -1;
+     }
+
+     Suchmuster muster;
+     musterVorbereiten(&muster, titel);
+
+     int gefunden = flachBereichSuchen(&muster, 0, treffer, maxResults);
+     trefferAlsIsbnListe(treffer, gefunden, isbnListe);
+     free(treffer);
+     return gefunden;
+ }
+
+ /**
+  * Bestimmt die Nummer des ersten Buches im Titel-Index mit mindestens der gegebenen ISBN
+  * @param abIsbn Vergleichs-ISBN (0 liefert 0)
+  * @return Buchnummer (anzahlBuecher, wenn alle ISBNs kleiner sind)
+  */
+ unsigned int titelIndexPosition(uint64_t abIsbn) {
+     if (isbnFolge.gueltig) {
+         return isbnFolgeUntergrenze(abIsbn);
+     }
+
+     unsigned int unten = 0;
+     unsigned int oben = titelIndex.anzahlBuecher;
+     while (unten < oben) {
+         unsigned int mitte = unten + (oben - unten) / 2;
+         if (titelIndex.buecher[mitte]->isbn < abIsbn) {
+             unten = mitte + 1;
+         } else {
+             oben = mitte;
+         }
+     }
+     return unten;
+ }
+
+ /**
+  * Kopiert die ISBNs gefundener Bücher in eine ISBN-Liste
+  */
+ void trefferAlsIsbnListe(Buch** treffer, int anzahl, char isbnListe[][LEN_ISBN]) {
+     for (int i = 0; i < anzahl; i++) {
+         isbnFormatieren(treffer[i]->isbn, isbnListe[i]);
+     }
+ }
+
+ /**
+  * Beginnt eine seitenweise Titelsuche
+  * @param cursor Aufzubauende Suchposition
+  * @param titel Zu suchender Titel (Teil des Titels)
+  */
+ void titelSucheStarten(TitelCursor* cursor, const char* titel) {
+     musterVorbereiten(&cursor->muster, titel);
+     strncpy(cursor->titel, titel, MAX_TITEL_LAENGE - 1);
+     cursor->titel[MAX_TITEL_LAENGE - 1] = '\0';
+     cursor->abIsbn = 0;
+     cursor->anzahlGeliefert = 0;
+     cursor->erschoepft = 0;
+ }
+
+ /**
+  * Liefert die nächsten Treffer einer Titelsuche als Verweise auf die Bücher,
+  * sodass kein erneutes Nachschlagen nötig ist. Es wird das jeweils günstigste
+  * Verfahren verwendet: Trigramm-Index für spezifische Suchbegriffe, sonst der
+  * flache Titelpuffer und, falls der Index veraltet ist, die Baumtraversierung.
+  * Jedes Verfahren endet, sobald maxResults Treffer gefunden sind.
+  * @param cursor Suchposition, wird hinter den letzten Treffer verschoben
+  * @param treffer Array, das die gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher (0, wenn es keine weiteren gibt)
+  */
+ int titelSucheFortsetzen(TitelCursor* cursor, Buch** treffer, int maxResults) {
+     if (cursor->erschoepft || maxResults <= 0) {
+         return 0;
+     }
+
+     int gefunden = -1;
+     if (titelIndex.gueltig) {
+         unsigned int ab = titelIndexPosition(cursor->abIsbn);
+         gefunden = trigrammKandidatenSuchen(&cursor->muster, ab, treffer, maxResults);
+         if (gefunden < 0) {
+             gefunden = flachBereichSuchen(&cursor->muster, ab, treffer, maxResults);
+         }
+     }
+     if (gefunden < 0) {
+         gefunden = baumTitelSuchenAb(wurzel, &cursor->muster, cursor->abIsbn, treffer, maxResults);
+     }
+
+     if (gefunden > 0) {
+         cursor->abIsbn = treffer[gefunden - 1]->isbn + 1;
+     }
+     cursor->anzahlGeliefert += gefunden;
+     cursor->erschoepft = gefunden < maxResults;
+     return gefunden;
+ }
+
+ /**
+  * Sucht die ersten maxResults Bücher nach Titel (siehe titelSucheFortsetzen)
+  * @param titel Zu suchender Titel (Teil des Titels)
+  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnimmt
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * @return Anzahl gefundener Bücher
+  */
+ int katalogTitelSuchen(const char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+     if (maxResults <= 0) {
+         return 0;
+     }
+
+     Buch** treffer = (Buch**)malloc((size_t)maxResults * sizeof(Buch*));
+     if (treffer == NULL) {
+         return 0;
+     }
+
+     TitelCursor cursor;
+     titelSucheStarten(&cursor, titel);
+     int gefunden = titelSucheFortsetzen(&cursor, treffer, maxResults);
+     trefferAlsIsbnListe(treffer, gefunden, isbnListe);
+     free(treffer);
+     return gefunden;
+ }
+
+ /**
+  * Lädt den Katalog aus dem Schnappschuss oder, falls dieser fehlt oder veraltet
+  * ist, aus der CSV-Datei
+  */
+ void csvDateiEinlesen() {
+     katalogLaden(CSV_DATEI, SCHNAPPSCHUSS_DATEI);
+ }
+
+ /**
+  * Bildet eine Datei zum Lesen in den Speicher ab (mmap). Ist das nicht möglich
+  * (z. B. bei Pipes), wird der Inhalt stattdessen in einen Puffer eingelesen.
+  * @param pfad Pfad zur Datei
+  * @param abbild Nimmt Inhalt und Größe der Datei auf
+  * @return 1 bei Erfolg, 0 wenn die Datei nicht gelesen werden konnte
+  */
+ int dateiAbbilden(const char* pfad, DateiAbbild* abbild) {
+     abbild->daten = NULL;
+     abbild->groesse = 0;
+     abbild->abgebildet = 0;
+
+     int datei = open(pfad, O_RDONLY);
+     if (datei < 0) {
+         return 0;
+     }
+
+     struct stat info;
+     if (fstat(datei, &info) != 0) {
+         close(datei);
+         return 0;
+     }
+     abbild->groesse = (size_t)info.st_size;
+     if (abbild->groesse == 0) {
+         close(datei);
+         return 1;
+     }
+
+     void* daten = mmap(NULL, abbild->groesse, PROT_READ, MAP_PRIVATE, datei, 0);
+     if (daten != MAP_FAILED) {
+         // Die Datei wird einmal von vorne nach hinten gelesen
+         madvise(daten, abbild->groesse, MADV_SEQUENTIAL);
+         abbild->daten = (const char*)daten;
+         abbild->abgebildet = 1;
+         close(datei);
+         return 1;
+     }
+
+     char* puffer = (char*)malloc(abbild->groesse);
+     size_t gelesen = 0;
+     while (puffer != NULL && gelesen < abbild->groesse) {
+         ssize_t anzahl = read(datei, puffer + gelesen, abbild->groesse - gelesen);
+         if (anzahl <= 0) {
+             break;
+         }
+         gelesen += (size_t)anzahl;
+     }
+     close(datei);
+
+     if (puffer == NULL || gelesen < abbild->groesse) {
+         free(puffer);
+         abbild->groesse = 0;
+         return 0;
+     }
+     abbild->daten = puffer;
+     return 1;
+ }
+
+ /**
+  * Gibt eine mit dateiAbbilden abgebildete Datei wieder frei
+  */
+ void dateiAbbildFreigeben(DateiAbbild* abbild) {
+     if (abbild->abgebildet) {
+         munmap((void*)abbild->daten, abbild->groesse);
+     } else {
+         free((void*)abbild->daten);
+     }
+     abbild->daten = NULL;
+     abbild->groesse = 0;
+     abbild->abgebildet = 0;
+ }
+
+ /**
+  * Liest ein CSV-Feld ab position, ohne es zu kopieren. Felder in Anführungszeichen
+  * dürfen Kommas, Zeilenumbrüche und verdoppelte Anführungszeichen enthalten; das
+  * schließende Anführungszeichen wird mit memchr gesucht.
+  * @param position Erstes Zeichen des Feldes
+  * @param ende Ende des Puffers
+  * @param feld Nimmt Anfang und Länge des Feldinhalts auf
+  * @return Position des Trennzeichens hinter dem Feld (',' oder '\n') oder ende
+  */
+ const char* csvFeldLesen(const char* position, const char* ende, CsvFeld* feld) {
+     feld->maskiert = 0;
+
+     if (position < ende && *position == '"') {
+         const char* anfang = position + 1;
+         const char* suche = anfang;
+
+         while (1) {
+             const char* anfuehrungszeichen = (const char*)memchr(suche, '"', (size_t)(ende - suche));
+             if (anfuehrungszeichen == NULL) {
+                 // Nicht geschlossenes Feld reicht bis zum Ende der Datei
+                 feld->anfang = anfang;
+                 feld->laenge = (size_t)(ende - anfang);
+                 return ende;
+             }
+             if (anfuehrungszeichen + 1 < ende && anfuehrungszeichen[1] == '"') {
+                 feld->maskiert = 1;
+                 suche = anfuehrungszeichen + 2;
+                 continue;
+             }
+
+             feld->anfang = anfang;
+             feld->laenge = (size_t)(anfuehrungszeichen - anfang);
+             position = anfuehrungszeichen + 1;
+             break;
+         }
+
+         // Zeichen zwischen schließendem Anführungszeichen und Trennzeichen ignorieren
+         while (position < ende && *position != ',' && *position != '\n') {
+             position++;
+         }
+         return position;
+     }
+
+     // Feld ohne Anführungszeichen: bis zum nächsten Trennzeichen
+     feld->anfang = position;
+     while (position < ende && *position != ',' && *position != '\n') {
+         position++;
+     }
+     feld->laenge = (size_t)(position - feld->anfang);
+     if (feld->laenge > 0 && feld->anfang[feld->laenge - 1] == '\r') {
+         feld->laenge--;
+     }
+     return position;
+ }
+
+ /**
+  * Sucht das Ende des aktuellen CSV-Datensatzes. Zeilenumbrüche innerhalb von
+  * Anführungszeichen gehören zum Datensatz; gesucht wird abwechselnd mit memchr
+  * nach dem nächsten Zeilenumbruch und dem nächsten Anführungszeichen davor.
+  * @param position Position innerhalb des Datensatzes (außerhalb von Anführungszeichen)
+  * @param ende Ende des Puffers
+  * @return Anfang des nächsten Datensatzes oder ende
+  */
+ const char* csvDatensatzEnde(const char* position, const char* ende) {
+     const char* zeilenEnde = (const char*)memchr(position, '\n', (size_t)(ende - position));
+     if (zeilenEnde == NULL) {
+         zeilenEnde = ende;
+     }
+
+     while (1) {
+         const char* oeffnend = (const char*)memchr(position, '"', (size_t)(zeilenEnde - position));
+         if (oeffnend == NULL) {
+             return zeilenEnde < ende ? zeilenEnde + 1 : ende;
+         }
+
+         const char* schliessend = (const char*)memchr(oeffnend + 1, '"', (size_t)(ende - oeffnend - 1));
+         if (schliessend == NULL) {
+             return ende;
+         }
+         position = schliessend + 1;
+
+         // Das Feld enthielt einen Zeilenumbruch: Zeilenende neu bestimmen
+         if (schliessend > zeilenEnde) {
+             zeilenEnde = (const char*)memchr(position, '\n', (size_t)(ende - position));
+             if (zeilenEnde == NULL) {
+                 zeilenEnde = ende;
+             }
+         }
+     }
+ }
+
+ /**
+  * Kopiert den Inhalt eines CSV-Feldes und ersetzt dabei "" durch "
+  * @param feld Das Feld (siehe csvFeldLesen)
+  * @param ziel Puffer mit mindestens feld->laenge Bytes
+  * @return Länge des Ergebnisses
+  */
+ size_t csvFeldEntmaskieren(const CsvFeld* feld, char* ziel) {
+     size_t laenge = 0;
+     for (size_t i = 0; i < feld->laenge; i++) {
+         ziel[laenge++] = feld->anfang[i];
+         if (feld->anfang[i] == '"' && i + 1 < feld->laenge && feld->anfang[i + 1] == '"') {
+             i++;
+         }
+     }
+     return laenge;
+ }
+
+ /**
+  * Zählt die Anführungszeichen im Rohabschnitt eines Lade-Threads (Thread-Funktion)
+  * @param argument Der CsvAbschnitt
+  */
+ void* csvAnfuehrungszeichenZaehlen(void* argument) {
+     CsvAbschnitt* abschnitt = (CsvAbschnitt*)argument;
+     const char* position = abschnitt->anfang;
+     size_t anzahl = 0;
+
+     while (position < abschnitt->ende) {
+         position = (const char*)memchr(position, '"', (size_t)(abschnitt->ende - position));
+         if (position == NULL) {
+             break;
+         }
+         anzahl++;
+         position++;
+     }
+
+     abschnitt->anfuehrungszeichen = anzahl;
+     return NULL;
+ }
+
+ /**
+  * Sucht den ersten Datensatz, der an oder hinter position beginnt
+  * @param position Beliebige Position in der Datei
+  * @param inAnfuehrungszeichen 1, wenn position innerhalb von Anführungszeichen liegt
+  * @param ende Ende der Datei
+  * @return Anfang des Datensatzes oder ende
+  */
+ const char* csvDatensatzAnfangSuchen(const char* position, int inAnfuehrungszeichen, const char* ende) {
+     if (inAnfuehrungszeichen) {
+         const char* schliessend = (const char*)memchr(position, '"', (size_t)(ende - position));
+         if (schliessend == NULL) {
+             return ende;
+         }
+         return csvDatensatzEnde(schliessend + 1, ende);
+     }
+     if (position[-1] == '\n') {
+         return position;
+     }
+     return csvDatensatzEnde(position, ende);
+ }
+
+ /**
+  * Zerlegt alle Datensätze eines Abschnitts, ohne Felder zu kopieren
+  * (Thread-Funktion). Die ISBN wird dabei gleich geprüft und in ihren
+  * Zahlenschlüssel umgewandelt. Datensätze ohne ISBN oder Titel werden
+  * übersprungen, solche mit ungültiger ISBN zusätzlich gezählt.
+  * @param argument Der CsvAbschnitt
+  */
+ void* csvAbschnittZerlegen(void* argument) {
+     CsvAbschnitt* abschnitt = (CsvAbschnitt*)argument;
+     const char* position = abschnitt->anfang;
+
+     abschnitt->kapazitaet = (size_t)(abschnitt->ende - abschnitt->anfang) / 64 + 16;
+     abschnitt->zeilen = (CsvZeile*)malloc(abschnitt->kapazitaet * sizeof(CsvZeile));
+     abschnitt->anzahlZeilen = 0;
+     abschnitt->ungueltig = 0;
+     if (abschnitt->zeilen == NULL) {
+         abschnitt->fehler = 1;
+         return NULL;
+     }
+
+     // CSV-Format verarbeiten: "isbn","titel",...
+     while (position < abschnitt->ende) {
+         CsvFeld isbnFeld;
+         CsvFeld titelFeld = { NULL, 0, 0 };
+
+         position = csvFeldLesen(position, abschnitt->dateiEnde, &isbnFeld);
+         if (position < abschnitt->dateiEnde && *position == ',') {
+             position = csvFeldLesen(position + 1, abschnitt->dateiEnde, &titelFeld);
+         }
+
+         // Die übrigen Felder werden nicht benötigt
+         position = csvDatensatzEnde(position, abschnitt->dateiEnde);
+
+         if (isbnFeld.laenge == 0 || titelFeld.laenge == 0) {
+             continue;
+         }
+
+         uint64_t isbn;
+         if (!isbnLesen(isbnFeld.anfang, isbnFeld.laenge, &isbn)) {
+             abschnitt->ungueltig++;
+             continue;
+         }
+
+         if (abschnitt->anzahlZeilen == abschnitt->kapazitaet) {
+             size_t kapazitaet = abschnitt->kapazitaet * 2;
+             CsvZeile* zeilen = (CsvZeile*)realloc(abschnitt->zeilen, kapazitaet * sizeof(CsvZeile));
+             if (zeilen == NULL) {
+                 abschnitt->fehler = 1;
+                 return NULL;
+             }
+             abschnitt->zeilen = zeilen;
+             abschnitt->kapazitaet = kapazitaet;
+         }
+
+         CsvZeile* zeile = &abschnitt->zeilen[abschnitt->anzahlZeilen++];
+         zeile->isbn = isbn;
+         zeile->titel = titelFeld.anfang;
+         zeile->titelLaenge = (unsigned int)titelFeld.laenge;
+         zeile->maskiert = (unsigned char)titelFeld.maskiert;
+     }
+
+     return NULL;
+ }
+
+ /**
+  * Führt eine Thread-Funktion für alle Abschnitte aus: Abschnitt 0 im
+  * aufrufenden Thread, alle übrigen in eigenen Threads. Kann ein Thread nicht
+  * gestartet werden, wird sein Abschnitt anschließend seriell bearbeitet.
+  */
+ void csvAbschnitteBearbeiten(CsvAbschnitt* abschnitte, int anzahl, void* (*bearbeiten)(void*)) {
+     pthread_t threads[MAX_LADE_THREADS];
+     int gestartet[MAX_LADE_THREADS] = { 0 };
+
+     for (int i = 1; i < anzahl; i++) {
+         gestartet[i] = pthread_create(&threads[i], NULL, bearbeiten, &abschnitte[i]) == 0;
+     }
+     bearbeiten(&abschnitte[0]);
+     for (int i = 1; i < anzahl; i++) {
+         if (gestartet[i]) {
+             pthread_join(threads[i], NULL);
+         } else {
+             bearbeiten(&abschnitte[i]);
+         }
+     }
+ }
+
+ /**
+  * Sortiert Datensätze stabil nach ISBN (LSD-Radixsort über die 8 Bytes des
+  * Zahlenschlüssels) und entfernt doppelte ISBNs. Durch die Stabilität bleibt
+  * von gleichen ISBNs der erste Datensatz der Datei übrig. Bytes, die in allen
+  * Schlüsseln gleich sind (etwa die oberen Bytes, da ISBN-13 unter 2^44
+  * liegen), werden übersprungen.
+  * @param zeilen Datensätze in Dateireihenfolge
+  * @param anzahl Anzahl der Datensätze
+  * @param eindeutig Erhält die Anzahl verschiedener ISBNs
+  * @return Neu reserviertes Array der Dateipositionen in ISBN-Reihenfolge (vom
+  *         Aufrufer freizugeben) oder NULL bei Speichermangel
+  */
+ unsigned int* csvZeilenSortieren(CsvZeile** zeilen, size_t anzahl, size_t* eindeutig) {
+     CsvSortierSchluessel* schluessel = (CsvSortierSchluessel*)malloc((anzahl > 0 ? anzahl : 1) * sizeof(CsvSortierSchluessel));
+     CsvSortierSchluessel* puffer = (CsvSortierSchluessel*)malloc((anzahl > 0 ? anzahl : 1) * sizeof(CsvSortierSchluessel));
+     unsigned int* reihenfolge = (unsigned int*)malloc((anzahl > 0 ? anzahl : 1) * sizeof(unsigned int));
+     if (schluessel == NULL || puffer == NULL || reihenfolge == NULL) {
+         free(schluessel);
+         free(puffer);
+         free(reihenfolge);
+         return NULL;
+     }
+
+     for (size_t i = 0; i < anzahl; i++) {
+         schluessel[i].isbn = zeilen[i]->isbn;
+         schluessel[i].position = (unsigned int)i;
+     }
+
+     // Vom niederwertigsten bis zum höchstwertigen Byte
+     for (int stelle = 0; stelle < 8; stelle++) {
+         int verschiebung = stelle * 8;
+         size_t haeufigkeit[256] = { 0 };
+         for (size_t i = 0; i < anzahl; i++) {
+             haeufigkeit[(schluessel[i].isbn >> verschiebung) & 0xFF]++;
+         }
+         if (anzahl == 0 || haeufigkeit[(schluessel[0].isbn >> verschiebung) & 0xFF] == anzahl) {
+             continue;
+         }
+
+         size_t position = 0;
+         for (int b = 0; b < 256; b++) {
+             size_t h = haeufigkeit[b];
+             haeufigkeit[b] = position;
+             position += h;
+         }
+         for (size_t i = 0; i < anzahl; i++) {
+             puffer[haeufigkeit[(schluessel[i].isbn >> verschiebung) & 0xFF]++] = schluessel[i];
+         }
+         CsvSortierSchluessel* tausch = schluessel;
+         schluessel = puffer;
+         puffer = tausch;
+     }
+
+     size_t anzahlEindeutig = 0;
+     for (size_t i = 0; i < anzahl; i++) {
+         if (i == 0 || schluessel[i].isbn != schluessel[i - 1].isbn) {
+             reihenfolge[anzahlEindeutig++] = schluessel[i].position;
+         }
+     }
+
+     free(schluessel);
+     free(puffer);
+     *eindeutig = anzahlEindeutig;
+     return reihenfolge;
+ }
+
+ /**
+  * Höhe eines Baums mit anzahl Knoten, der durch fortgesetztes Teilen in der
+  * Mitte entsteht: floor(log2(anzahl)) + 1
+  */
+ int hoeheFuerAnzahl(size_t anzahl) {
+     int hoehe = 0;
+     while (anzahl > 0) {
+         hoehe++;
+         anzahl /= 2;
+     }
+     return hoehe;
+ }
+
+ /**
+  * Baut aus nach ISBN sortierten Knoten ohne Vergleiche und Rotationen einen
+  * vollständig ausbalancierten Baum auf: Die Mitte jedes Bereichs wird zur
+  * Wurzel, die beiden Hälften zu ihren Teilbäumen. Die Bereiche werden auf
+  * einem Stapel fester Größe abgearbeitet, da jeder Schritt höchstens einen
+  * Bereich je Baumebene offen lässt. Laufzeit O(n).
+  * @param knoten Nach ISBN sortierte Knoten ohne Duplikate
+  * @param anzahl Anzahl der Knoten
+  * @return Wurzel des neuen Baums
+  */
+ Buch* baumAusSortiertenKnotenAufbauen(Buch** knoten, size_t anzahl) {
+     struct {
+         size_t von;
+         size_t bis;
+         unsigned int* ziel;
+     } bereiche[2 * MAX_BAUMHOEHE];
+     int offen = 0;
+     unsigned int neueWurzel = KEIN_KNOTEN;
+
+     bereiche[offen].von = 0;
+     bereiche[offen].bis = anzahl;
+     bereiche[offen].ziel = &neueWurzel;
+     offen++;
+
+     while (offen > 0) {
+         offen--;
+         size_t von = bereiche[offen].von;
+         size_t bis = bereiche[offen].bis;
+         unsigned int* ziel = bereiche[offen].ziel;
+
+         if (von >= bis) {
+             *ziel = KEIN_KNOTEN;
+             continue;
+         }
+
+         size_t mitte = von + (bis - von) / 2;
+         Buch* wurzelKnoten = knoten[mitte];
+         wurzelKnoten->hoehe = hoeheFuerAnzahl(bis - von);
+         *ziel = wurzelKnoten->nummer;
+
+         bereiche[offen].von = mitte + 1;
+         bereiche[offen].bis = bis;
+         bereiche[offen].ziel = &wurzelKnoten->rechts;
+         offen++;
+         bereiche[offen].von = von;
+         bereiche[offen].bis = mitte;
+         bereiche[offen].ziel = &wurzelKnoten->links;
+         offen++;
+     }
+
+     return knotenZeiger(neueWurzel);
+ }
+
+ /**
+  * Baut den Katalog in einem Schritt aus allen zerlegten Datensätzen auf (nur
+  * bei leerem Katalog). Die Datensätze werden einmal nach ISBN sortiert, wenn
+  * sie nicht bereits sortiert vorliegen; bei doppelten ISBNs gilt wie beim
+  * einzelnen Einfügen der erste Eintrag der Datei. Die Knoten werden in
+  * Dateireihenfolge angelegt, damit die Titel sequentiell gelesen werden, und
+  * anschließend in ISBN-Reihenfolge zu einem ausbalancierten Baum verbunden.
+  * @return Anzahl der Datensätze (einschließlich doppelter ISBNs) oder -1 bei
+  *         Speichermangel; bereits angelegte Knoten und Titel werden dann
+  *         zurückgenommen, der Katalog bleibt leer
+  */
+ int csvZeilenMassenEinfuegen(CsvAbschnitt* abschnitte, int anzahl) {
+     size_t n = 0;
+     size_t titelBytes = 0;
+     for (int a = 0; a < anzahl; a++) {
+         n += abschnitte[a].anzahlZeilen;
+         for (size_t i = 0; i < abschnitte[a].anzahlZeilen; i++) {
+             titelBytes += (size_t)abschnitte[a].zeilen[i].titelLaenge + 1;
+         }
+     }
+
+     // Stand der Arena und des Titel-Pools, auf den bei Speichermangel zurückgesetzt wird
+     size_t knotenVorher = buchArena.anzahlKnoten;
+     size_t titelVorher = titelPool.laenge;
+
+     size_t groesse = n > 0 ? n : 1;
+     CsvZeile** zeilen = (CsvZeile**)malloc(groesse * sizeof(CsvZeile*));
+     Buch** knoten = (Buch**)malloc(groesse * sizeof(Buch*));
+     if (zeilen == NULL || knoten == NULL || !titelPoolReservieren(titelBytes)) {
+         free(zeilen);
+         free(knoten);
+         return -1;
+     }
+
+     // Datensätze in Dateireihenfolge einsammeln und prüfen, ob sie bereits sortiert sind
+     size_t z = 0;
+     int istSortiert = 1;
+     for (int a = 0; a < anzahl; a++) {
+         for (size_t i = 0; i < abschnitte[a].anzahlZeilen; i++) {
+             zeilen[z] = &abschnitte[a].zeilen[i];
+             if (istSortiert && z > 0 && zeilen[z - 1]->isbn > zeilen[z]->isbn) {
+                 istSortiert = 0;
+             }
+             z++;
+         }
+     }
+
+     // Bei unsortierter Eingabe: Dateipositionen der ersten Einträge in ISBN-Reihenfolge
+     unsigned int* reihenfolge = NULL;
+     size_t eindeutig = 0;
+     unsigned char* uebernehmen = NULL;
+     Buch** knotenNachPosition = NULL;
+     if (!istSortiert) {
+         reihenfolge = csvZeilenSortieren(zeilen, n, &eindeutig);
+         uebernehmen = (unsigned char*)calloc(groesse, 1);
+         knotenNachPosition = (Buch**)malloc(groesse * sizeof(Buch*));
+         if (reihenfolge == NULL || uebernehmen == NULL || knotenNachPosition == NULL) {
+             free(reihenfolge);
+             free(uebernehmen);
+             free(knotenNachPosition);
+             free(zeilen);
+             free(knoten);
+             return -1;
+         }
+         for (size_t i = 0; i < eindeutig; i++) {
+             uebernehmen[reihenfolge[i]] = 1;
+         }
+     }
+
+     // Knoten in Dateireihenfolge anlegen (bei sortierter Eingabe direkt in ISBN-Reihenfolge)
+     char* entmaskiert = NULL;   // Puffer für Titel mit verdoppelten Anführungszeichen
+     size_t entmaskiertGroesse = 0;
+     size_t anzahlKnoten = 0;
+     int speicherFehler = 0;
+
+     for (size_t i = 0; i < n; i++) {
+         const CsvZeile* zeile = zeilen[i];
+         if (istSortiert) {
+             if (i > 0 && zeilen[i - 1]->isbn == zeile->isbn) {
+                 continue;
+             }
+         } else {
+             knotenNachPosition[i] = NULL;
+             if (!uebernehmen[i]) {
+                 continue;
+             }
+         }
+
+         const char* titel = zeile->titel;
+         size_t titelLaenge = zeile->titelLaenge;
+         if (zeile->maskiert) {
+             if (titelLaenge > entmaskiertGroesse) {
+                 char* puffer = (char*)realloc(entmaskiert, titelLaenge);
+                 if (puffer == NULL) {
+                     speicherFehler = 1;
+                     break;
+                 }
+                 entmaskiert = puffer;
+                 entmaskiertGroesse = titelLaenge;
+             }
+             CsvFeld feld = { zeile->titel, titelLaenge, 1 };
+             titelLaenge = csvFeldEntmaskieren(&feld, entmaskiert);
+             titel = entmaskiert;
+         }
+
+         Buch* neuesBuch = neuesBuchErstellen(zeile->isbn, titel, titelLaenge);
+         if (neuesBuch == NULL) {
+             speicherFehler = 1;
+             break;
+         }
+         if (istSortiert) {
+             knoten[anzahlKnoten++] = neuesBuch;
+         } else {
+             knotenNachPosition[i] = neuesBuch;
+         }
+     }
+
+     // Kein unvollständiger Katalog: angelegte Knoten und Titel zurücknehmen
+     // (die Blöcke der Arena und der Pool bleiben für einen neuen Versuch reserviert)
+     if (speicherFehler) {
+         buchArena.anzahlKnoten = knotenVorher;
+         titelPool.laenge = titelVorher;
+         free(entmaskiert);
+         free(reihenfolge);
+         free(uebernehmen);
+         free(knotenNachPosition);
+         free(zeilen);
+         free(knoten);
+         return -1;
+     }
+
+     // Bei unsortierter Eingabe die Knoten in ISBN-Reihenfolge bringen
+     if (!istSortiert) {
+         for (size_t i = 0; i < eindeutig; i++) {
+             Buch* buch = knotenNachPosition[reihenfolge[i]];
+             if (buch != NULL) {
+                 knoten[anzahlKnoten++] = buch;
+             }
+         }
+     }
+
+     wurzel = baumAusSortiertenKnotenAufbauen(knoten, anzahlKnoten);
+     titelIndex.gueltig = 0;
+     isbnHash.gueltig = 0;
+     isbnFolge.gueltig = 0;
+
+     free(entmaskiert);
+     free(reihenfolge);
+     free(uebernehmen);
+     free(knotenNachPosition);
+     free(zeilen);
+     free(knoten);
+     return (int)n;
+ }
+
+ /**
+  * Fügt die zerlegten Datensätze aller Abschnitte in den Binärbaum ein. Ein
+  * leerer Katalog wird in einem Schritt aufgebaut (csvZeilenMassenEinfuegen),
+  * sonst wird jeder Datensatz in Dateireihenfolge eingefügt, sodass bei doppelten
+  * ISBNs wie bisher der erste Eintrag gilt.
+  * @return Anzahl der eingefügten Datensätze (einschließlich doppelter ISBNs)
+  *         oder -1, wenn wegen Speichermangels nicht alle Datensätze in den
+  *         Katalog aufgenommen werden konnten
+  */
+ int csvZeilenEinfuegen(CsvAbschnitt* abschnitte, int anzahl) {
+     if (wurzel == NULL) {
+         int eingefuegt = csvZeilenMassenEinfuegen(abschnitte, anzahl);
+         if (eingefuegt >= 0) {
+             return eingefuegt;
+         }
+     }
+
+     int anzahlBücher = 0;
+     int fehlgeschlagen = 0;
+     char* entmaskiert = NULL;   // Puffer für Titel mit verdoppelten Anführungszeichen
+     size_t entmaskiertGroesse = 0;
+
+     for (int a = 0; a < anzahl; a++) {
+         for (size_t i = 0; i < abschnitte[a].anzahlZeilen; i++) {
+             const CsvZeile* zeile = &abschnitte[a].zeilen[i];
+
+             const char* titel = zeile->titel;
+             size_t titelLaenge = zeile->titelLaenge;
+             if (zeile->maskiert) {
+                 if (titelLaenge > entmaskiertGroesse) {
+                     char* puffer = (char*)realloc(entmaskiert, titelLaenge);
+                     if (puffer == NULL) {
+                         fehlgeschlagen++;
+                         continue;
+                     }
+                     entmaskiert = puffer;
+                     entmaskiertGroesse = titelLaenge;
+                 }
+                 CsvFeld feld = { zeile->titel, titelLaenge, 1 };
+                 titelLaenge = csvFeldEntmaskieren(&feld, entmaskiert);
+                 titel = entmaskiert;
+             }
+
+             size_t knotenVorher = buchArena.anzahlKnoten;
+             wurzel = buchEinfuegenMitLaenge(wurzel, zeile->isbn, titel, titelLaenge);
+             // Kein neuer Knoten: doppelte ISBN oder Speichermangel
+             if (buchArena.anzahlKnoten == knotenVorher && buchNachIsbnSuchen(wurzel, zeile->isbn) == NULL) {
+                 fehlgeschlagen++;
+             }
+             anzahlBücher++;
+         }
+     }
+
+     free(entmaskiert);
+     return fehlgeschlagen > 0 ? -1 : anzahlBücher;
+ }
+
+ /**
+  * Liest eine CSV-Datei mit mehreren Threads ein und fügt alle Bücher in den
+  * Binärbaum ein. Die Datei wird in den Speicher abgebildet und in gleich große
+  * Byte-Bereiche geteilt. Damit jeder Thread an einer echten Datensatzgrenze
+  * beginnt, zählen die Threads zuerst die Anführungszeichen in ihrem Bereich:
+  * Ist die Summe aller davor liegenden ungerade, beginnt der Bereich innerhalb
+  * eines Feldes in Anführungszeichen (verdoppelte "" ändern die Parität nicht).
+  * Danach zerlegt jeder Thread die Datensätze, die in seinem Abschnitt beginnen,
+  * und die Ergebnisse werden in Dateireihenfolge eingefügt.
+  * Zeilen beliebiger Länge und Zeilenumbrüche in Anführungszeichen sind erlaubt.
+  * Der Titel-Index wird nicht aufgebaut.
+  * @param pfad Pfad zur CSV-Datei
+  * @param anzahlThreads Anzahl der Lade-Threads (1 = seriell)
+  * @return Anzahl der eingelesenen Bücher oder -1, wenn die Datei nicht lesbar ist
+  *         oder nicht alle Bücher in den Katalog aufgenommen werden konnten
+  */
+ int csvDatenEinlesenParallel(const char* pfad, int anzahlThreads) {
+     DateiAbbild abbild;
+
+     // Prüfen, ob die Datei geöffnet werden konnte
+     if (!dateiAbbilden(pfad, &abbild)) {
+         printf("Fehler beim Öffnen der CSV-Datei: %s\n", pfad);
+         return -1;
+     }
+     if (abbild.groesse == 0) {
+         printf("CSV-Datei ist leer oder fehlerhaft\n");
+         dateiAbbildFreigeben(&abbild);
+         return -1;
+     }
+
+     // Den ersten Datensatz (Header) überspringen
+     const char* ende = abbild.daten + abbild.groesse;
+     const char* daten = csvDatensatzEnde(abbild.daten, ende);
+     size_t groesse = (size_t)(ende - daten);
+
+     if (anzahlThreads < 1) {
+         anzahlThreads = 1;
+     }
+     if (anzahlThreads > MAX_LADE_THREADS) {
+         anzahlThreads = MAX_LADE_THREADS;
+     }
+     if ((size_t)anzahlThreads > groesse) {
+         anzahlThreads = groesse > 0 ? (int)groesse : 1;
+     }
+
+     CsvAbschnitt abschnitte[MAX_LADE_THREADS];
+     for (int i = 0; i < anzahlThreads; i++) {
+         abschnitte[i].anfang = daten + groesse * i / anzahlThreads;
+         abschnitte[i].ende = daten + groesse * (i + 1) / anzahlThreads;
+         abschnitte[i].dateiEnde = ende;
+         abschnitte[i].anfuehrungszeichen = 0;
+         abschnitte[i].zeilen = NULL;
+         abschnitte[i].anzahlZeilen = 0;
+         abschnitte[i].kapazitaet = 0;
+         abschnitte[i].ungueltig = 0;
+         abschnitte[i].fehler = 0;
+     }
+
+     // Abschnittsgrenzen auf Datensatzanfänge verschieben
+     if (anzahlThreads > 1) {
+         csvAbschnitteBearbeiten(abschnitte, anzahlThreads, csvAnfuehrungszeichenZaehlen);
+
+         size_t anfuehrungszeichen = 0;
+         for (int i = 1; i < anzahlThreads; i++) {
+             anfuehrungszeichen += abschnitte[i - 1].anfuehrungszeichen;
+             abschnitte[i].anfang = csvDatensatzAnfangSuchen(abschnitte[i].anfang, anfuehrungszeichen % 2, ende);
+             abschnitte[i - 1].ende = abschnitte[i].anfang;
+         }
+     }
+
+     csvAbschnitteBearbeiten(abschnitte, anzahlThreads, csvAbschnittZerlegen);
+
+     int anzahlBücher = 0;
+     int fehler = 0;
+     size_t ungueltig = 0;
+     for (int i = 0; i < anzahlThreads; i++) {
+         fehler |= abschnitte[i].fehler;
+         ungueltig += abschnitte[i].ungueltig;
+     }
+     if (ungueltig > 0) {
+         printf("Hinweis: %zu Datensätze mit ungültiger ISBN wurden übersprungen.\n", ungueltig);
+     }
+     if (fehler) {
+         printf("Fehler bei der Speicherreservierung!\n");
+     } else {
+         anzahlBücher = csvZeilenEinfuegen(abschnitte, anzahlThreads);
+         if (anzahlBücher < 0) {
+             printf("Fehler: Zu wenig Speicher, der Katalog wurde nicht vollständig geladen!\n");
+         }
+     }
+
+     for (int i = 0; i < anzahlThreads; i++) {
+         free(abschnitte[i].zeilen);
+     }
+     dateiAbbildFreigeben(&abbild);
+     return anzahlBücher;
+ }
+
+ /**
+  * Liest eine CSV-Datei ein und fügt alle Bücher in den Binärbaum ein
+  * (siehe csvDatenEinlesenParallel). Je angefangenem MiB wird höchstens ein
+  * Thread verwendet, insgesamt höchstens einer je Prozessor.
+  * @param pfad Pfad zur CSV-Datei
+  * @return Anzahl der eingelesenen Bücher oder -1, wenn die Datei nicht lesbar ist
+  *         oder nicht alle Bücher in den Katalog aufgenommen werden konnten
+  */
+ int csvDatenEinlesen(const char* pfad) {
+     int anzahlThreads = prozessorAnzahl();
+
+     struct stat info;
+     if (stat(pfad, &info) == 0 && (off_t)anzahlThreads * CSV_MIN_ABSCHNITT > info.st_size) {
+         anzahlThreads = (int)(info.st_size / CSV_MIN_ABSCHNITT) + 1;
+     }
+
+     return csvDatenEinlesenParallel(pfad, anzahlThreads);
+ }
+
+ /**
+  * Liest eine CSV-Datei ein, fügt alle Bücher in den Binärbaum ein und baut
+  * anschließend den Titel-Index auf
+  * @param pfad Pfad zur CSV-Datei
+  * @return Anzahl der eingelesenen Bücher (0 bei Fehler oder unvollständig geladenem Katalog)
+  */
+ int csvDateiLaden(const char* pfad) {
+     int anzahlBücher = csvDatenEinlesen(pfad);
+     if (anzahlBücher < 0) {
+         return 0;
+     }
+
+     printf("Bibliotheksdaten geladen: %d Bücher eingelesen.\n", anzahlBücher);
+
+     // Index für die Titelsuche über den vollständigen Katalog aufbauen
+     if (!titelIndexAufbauen()) {
+         printf("Hinweis: Zu wenig Speicher für den Titelindex, die Titelsuche durchsucht den gesamten Baum.\n");
+     }
+
+     // Hashindex für die exakte ISBN-Suche aufbauen
+     if (!isbnHashAufbauen()) {
+         printf("Hinweis: Zu wenig Speicher für den ISBN-Hashindex, die ISBN-Suche durchsucht den Baum.\n");
+     }
+
+     return anzahlBücher;
+ }
+
+ /**
+  * Berechnet eine 64-Bit-Prüfsumme über einen Speicherbereich (8 Bytes je Schritt)
+  * @param daten Anfang des Bereichs
+  * @param laenge Länge in Bytes
+  * @return Prüfsumme
+  */
+ unsigned long long datenPruefsumme(const char* daten, size_t laenge) {
+     unsigned long long summe = 14695981039346656037ULL ^ laenge;
+     size_t i = 0;
+     for (; i + 8 <= laenge; i += 8) {
+         unsigned long long wort;
+         memcpy(&wort, daten + i, 8);
+         summe = (summe ^ wort) * 0x9E3779B97F4A7C15ULL;
+         summe ^= summe >> 29;
+     }
+     for (; i < laenge; i++) {
+         summe = (summe ^ (unsigned char)daten[i]) * 1099511628211ULL;
+     }
+     return summe ^ (summe >> 32);
+ }
+
+ /**
+  * Prüfsumme über alle Felder des Schnappschuss-Kopfes vor kopfPruefsumme
+  */
+ unsigned long long schnappschussKopfPruefsumme(const SchnappschussKopf* kopf) {
+     return datenPruefsumme((const char*)kopf, offsetof(SchnappschussKopf, kopfPruefsumme));
+ }
+
+ /**
+  * Schreibt den aufgebauten Katalog als Schnappschuss, damit spätere Programmstarts
+  * die CSV-Datei nicht erneut zerlegen müssen. Die Datei wird unter einem
+  * temporären Namen geschrieben und erst vollständig umbenannt.
+  * @param pfad Pfad des Schnappschusses
+  * @param csvPfad CSV-Datei, aus der der Katalog geladen wurde
+  * @return 1 bei Erfolg, 0 bei Fehler (oder wenn der Titel-Index nicht aktuell ist)
+  */
+ int schnappschussSchreiben(const char* pfad, const char* csvPfad) {
+     if (!titelIndex.gueltig || sizeof(size_t) != sizeof(unsigned long long)) {
+         return 0;
+     }
+
+     // Änderungszeit und Prüfsumme der CSV-Datei festhalten
+     struct stat info;
+     DateiAbbild csv;
+     if (stat(csvPfad, &info) != 0 || !dateiAbbilden(csvPfad, &csv)) {
+         return 0;
+     }
+     SchnappschussKopf kopf;
+     memset(&kopf, 0, sizeof(kopf));
+     memcpy(kopf.kennung, "BIBSNAP", 8);
+     kopf.version = SCHNAPPSCHUSS_VERSION;
+     kopf.bytefolge = SCHNAPPSCHUSS_BYTEFOLGE;
+     kopf.isbnBreite = SCHNAPPSCHUSS_ISBN_BREITE;
+     kopf.trigrammBits = TRIGRAMM_BITS;
+     kopf.csvGroesse = (unsigned long long)info.st_size;
+     kopf.csvSekunden = (long long)info.st_mtim.tv_sec;
+     kopf.csvNanosekunden = (long long)info.st_mtim.tv_nsec;
+     kopf.csvPruefsumme = datenPruefsumme(csv.daten, csv.groesse);
+     dateiAbbildFreigeben(&csv);
+
+     // Abschnitte hintereinander, jeweils auf 8 Bytes ausgerichtet
+     unsigned long long anzahl = titelIndex.anzahlBuecher;
+     unsigned long long poolLaenge = 0;
+     for (unsigned int i = 0; i < titelIndex.anzahlBuecher; i++) {
+         poolLaenge += (unsigned long long)buchDaten(titelIndex.buecher[i])->titelLaenge + 1;
+     }
+     kopf.anzahlBuecher = anzahl;
+     kopf.poolLaenge = poolLaenge;
+     kopf.anzahlPostings = titelIndex.listenAnfang[TRIGRAMM_LISTEN];
+     kopf.schluesselAnfang = (sizeof(SchnappschussKopf) + 7) & ~7ULL;
+     kopf.offsetsAnfang = kopf.schluesselAnfang + anzahl * SCHNAPPSCHUSS_ISBN_BREITE;
+     kopf.poolAnfang = kopf.offsetsAnfang + (anzahl + 1) * sizeof(unsigned long long);
+     kopf.listenAnfang = (kopf.poolAnfang + poolLaenge + 7) & ~7ULL;
+     kopf.postingsAnfang = kopf.listenAnfang + (TRIGRAMM_LISTEN + 1) * sizeof(unsigned long long);
+     kopf.dateiGroesse = kopf.postingsAnfang + kopf.anzahlPostings * sizeof(unsigned int);
+     kopf.kopfPruefsumme = schnappschussKopfPruefsumme(&kopf);
+
+     char temporaer[1024];
+     snprintf(temporaer, sizeof(temporaer), "%s.tmp", pfad);
+     FILE* datei = fopen(temporaer, "wb");
+     if (datei == NULL) {
+         return 0;
+     }
+     setvbuf(datei, NULL, _IOFBF, 1 << 20);
+
+     const char nullen[8] = { 0 };
+     int ok = fwrite(&kopf, sizeof(kopf), 1, datei) == 1;
+     ok = ok && fwrite(nullen, 1, kopf.schluesselAnfang - sizeof(kopf), datei) == kopf.schluesselAnfang - sizeof(kopf);
+
+     for (unsigned int i = 0; ok && i < titelIndex.anzahlBuecher; i++) {
+         ok = fwrite(&titelIndex.buecher[i]->isbn, SCHNAPPSCHUSS_ISBN_BREITE, 1, datei) == 1;
+     }
+     unsigned long long offset = 0;
+     for (unsigned int i = 0; ok && i <= titelIndex.anzahlBuecher; i++) {
+         ok = fwrite(&offset, sizeof(offset), 1, datei) == 1;
+         if (i < titelIndex.anzahlBuecher) {
+             offset += (unsigned long long)buchDaten(titelIndex.buecher[i])->titelLaenge + 1;
+         }
+     }
+     for (unsigned int i = 0; ok && i < titelIndex.anzahlBuecher; i++) {
+         const Buch* buch = titelIndex.buecher[i];
+         ok = fwrite(buchTitel(buch), (size_t)buchDaten(buch)->titelLaenge + 1, 1, datei) == 1;
+     }
+     size_t auffuellung = (size_t)(kopf.listenAnfang - kopf.poolAnfang - poolLaenge);
+     ok = ok && fwrite(nullen, 1, auffuellung, datei) == auffuellung;
+     ok = ok && fwrite(titelIndex.listenAnfang, sizeof(size_t), TRIGRAMM_LISTEN + 1, datei) == TRIGRAMM_LISTEN + 1;
+     ok = ok && fwrite(titelIndex.postings, sizeof(unsigned int), kopf.anzahlPostings, datei) == kopf.anzahlPostings;
+
+     if (fclose(datei) != 0 || !ok || rename(temporaer, pfad) != 0) {
+         remove(temporaer);
+         return 0;
+     }
+     return 1;
+ }
+
+ /**
+  * Lädt den Katalog aus einem Schnappschuss (nur bei leerem Katalog). Die Datei
+  * wird abgebildet; Titel-Pool und Trigramm-Index werden direkt aus der Abbildung
+  * verwendet, nur die Baumknoten werden aus den sortierten ISBNs in O(n) angelegt.
+  * Der Schnappschuss gilt als veraltet, wenn sich Größe oder Inhalt der CSV-Datei
+  * geändert haben. Bei gleicher Größe, aber geänderter Änderungszeit wird der
+  * Inhalt über die Prüfsumme verglichen und bei Gleichheit die neue Zeit vermerkt.
+  * @param pfad Pfad des Schnappschusses
+  * @param csvPfad CSV-Datei, aus der der Schnappschuss erzeugt wurde
+  * @return 1, wenn der Katalog geladen wurde, 0 wenn der Schnappschuss fehlt,
+  *         ungültig oder veraltet ist (der Katalog bleibt dann leer)
+  */
+ int schnappschussLaden(const char* pfad, const char* csvPfad) {
+     struct stat info;
+     if (wurzel != NULL || buchArena.anzahlKnoten > 0 || titelPool.laenge > 0 ||
+         sizeof(size_t) != sizeof(unsigned long long) || stat(csvPfad, &info) != 0) {
+         return 0;
+     }
+
+     DateiAbbild abbild;
+     if (!dateiAbbilden(pfad, &abbild)) {
+         return 0;
+     }
+     if (abbild.abgebildet) {
+         madvise((void*)abbild.daten, abbild.groesse, MADV_NORMAL);
+     }
+
+     // Kopf und Lage der Abschnitte prüfen
+     SchnappschussKopf kopf;
+     memset(&kopf, 0, sizeof(kopf));
+     int gueltig = abbild.groesse >= sizeof(kopf);
+     if (gueltig) {
+         memcpy(&kopf, abbild.daten, sizeof(kopf));
+         gueltig = memcmp(kopf.kennung, "BIBSNAP", 8) == 0 && kopf.version == SCHNAPPSCHUSS_VERSION &&
+                   kopf.bytefolge == SCHNAPPSCHUSS_BYTEFOLGE && kopf.isbnBreite == SCHNAPPSCHUSS_ISBN_BREITE &&
+                   kopf.trigrammBits == TRIGRAMM_BITS && kopf.kopfPruefsumme == schnappschussKopfPruefsumme(&kopf) &&
+                   kopf.dateiGroesse == abbild.groesse && kopf.anzahlBuecher < 0xFFFFFFFFULL &&
+                   kopf.schluesselAnfang >= sizeof(kopf) &&
+                   kopf.offsetsAnfang == kopf.schluesselAnfang + kopf.anzahlBuecher * SCHNAPPSCHUSS_ISBN_BREITE &&
+                   kopf.poolAnfang == kopf.offsetsAnfang + (kopf.anzahlBuecher + 1) * sizeof(unsigned long long) &&
+                   kopf.listenAnfang >= kopf.poolAnfang + kopf.poolLaenge && kopf.listenAnfang % 8 == 0 &&
+                   kopf.schluesselAnfang % 8 == 0 &&
+                   kopf.postingsAnfang == kopf.listenAnfang + (TRIGRAMM_LISTEN + 1) * sizeof(unsigned long long) &&
+                   kopf.dateiGroesse == kopf.postingsAnfang + kopf.anzahlPostings * sizeof(unsigned int);
+     }
+
+     // Die CSV-Datei darf sich seit dem Schreiben nicht geändert haben
+     int zeitGeaendert = gueltig && (kopf.csvSekunden != (long long)info.st_mtim.tv_sec ||
+                                     kopf.csvNanosekunden != (long long)info.st_mtim.tv_nsec);
+     gueltig = gueltig && kopf.csvGroesse == (unsigned long long)info.st_size;
+     if (gueltig && zeitGeaendert) {
+         DateiAbbild csv;
+         gueltig = dateiAbbilden(csvPfad, &csv);
+         if (gueltig) {
+             gueltig = datenPruefsumme(csv.daten, csv.groesse) == kopf.csvPruefsumme;
+             dateiAbbildFreigeben(&csv);
+         }
+     }
+
+     const uint64_t* schluessel = (const uint64_t*)(abbild.daten + kopf.schluesselAnfang);
+     const unsigned long long* offsets = gueltig ? (const unsigned long long*)(abbild.daten + kopf.offsetsAnfang) : NULL;
+     const char* pool = abbild.daten + kopf.poolAnfang;
+     const unsigned long long* listen = gueltig ? (const unsigned long long*)(abbild.daten + kopf.listenAnfang) : NULL;
+     unsigned int anzahl = gueltig ? (unsigned int)kopf.anzahlBuecher : 0;
+     gueltig = gueltig && offsets[0] == 0 && offsets[anzahl] == kopf.poolLaenge &&
+               (kopf.poolLaenge == 0 || pool[kopf.poolLaenge - 1] == '\0') &&
+               listen[0] == 0 && listen[TRIGRAMM_LISTEN] == kopf.anzahlPostings;
+     for (unsigned int liste = 0; gueltig && liste < TRIGRAMM_LISTEN; liste++) {
+         gueltig = listen[liste] <= listen[liste + 1];
+     }
+
+     // Postings müssen Nummern vorhandener Bücher sein und je Liste streng
+     // aufsteigen, sonst liest die Titelsuche außerhalb von titelIndex.buecher
+     const unsigned int* postings = (const unsigned int*)(abbild.daten + kopf.postingsAnfang);
+     for (unsigned int liste = 0; gueltig && liste < TRIGRAMM_LISTEN; liste++) {
+         unsigned int naechstes = 0; // Kleinste erlaubte Buchnummer
+         for (unsigned long long p = listen[liste]; p < listen[liste + 1]; p++) {
+             if (postings[p] < naechstes || postings[p] >= anzahl) {
+                 gueltig = 0;
+                 break;
+             }
+             naechstes = postings[p] + 1;
+         }
+     }
+
+     Buch** buecher = gueltig ? (Buch**)malloc((anzahl > 0 ? anzahl : 1) * sizeof(Buch*)) : NULL;
+     if (buecher == NULL) {
+         dateiAbbildFreigeben(&abbild);
+         return 0;
+     }
+
+     // Knoten in ISBN-Reihenfolge anlegen; ISBNs und Titel-Offsets müssen streng
+     // aufsteigen, und jeder Titel muss mit '\0' enden
+     for (unsigned int i = 0; i < anzahl; i++) {
+         Buch* buch = NULL;
+         if (offsets[i + 1] > offsets[i] && offsets[i + 1] <= kopf.poolLaenge && pool[offsets[i + 1] - 1] == '\0' &&
+             (i == 0 || schluessel[i - 1] < schluessel[i])) {
+             buch = arenaKnotenAnfordern();
+         }
+         if (buch == NULL) {
+             free(buecher);
+             katalogFreigeben();
+             dateiAbbildFreigeben(&abbild);
+             return 0;
+         }
+         buch->isbn = schluessel[i];
+         BuchDaten* daten = buchDaten(buch);
+         daten->titelOffset = (size_t)offsets[i];
+         daten->titelLaenge = (unsigned int)(offsets[i + 1] - offsets[i] - 1);
+         buecher[i] = buch;
+     }
+
+     // Neue Änderungszeit der unverändert gebliebenen CSV-Datei vermerken
+     if (zeitGeaendert) {
+         kopf.csvSekunden = (long long)info.st_mtim.tv_sec;
+         kopf.csvNanosekunden = (long long)info.st_mtim.tv_nsec;
+         kopf.kopfPruefsumme = schnappschussKopfPruefsumme(&kopf);
+         int datei = open(pfad, O_WRONLY);
+         if (datei >= 0) {
+             if (pwrite(datei, &kopf, sizeof(kopf), 0) != (ssize_t)sizeof(kopf)) {
+                 printf("Hinweis: Änderungszeit im Schnappschuss %s konnte nicht aktualisiert werden.\n", pfad);
+             }
+             close(datei);
+         }
+     }
+
+     katalogAbbild = abbild;
+     wurzel = baumAusSortiertenKnotenAufbauen(buecher, anzahl);
+     titelPool.daten = (char*)pool;
+     titelPool.laenge = (size_t)kopf.poolLaenge;
+     titelPool.kapazitaet = (size_t)kopf.poolLaenge;
+     titelIndex.buecher = buecher;
+     titelIndex.anzahlBuecher = anzahl;
+     titelIndex.listenAnfang = (size_t*)listen;
+     // Ohne Postings läge der Abschnitt am Dateiende und damit außerhalb der Abbildung
+     titelIndex.postings = kopf.anzahlPostings > 0 ? (unsigned int*)(abbild.daten + kopf.postingsAnfang) : NULL;
+     titelIndex.gueltig = 1;
+     isbnFolgeAufbauen();
+     if (!isbnHashAufbauen()) {
+         printf("Hinweis: Zu wenig Speicher für den ISBN-Hashindex, die ISBN-Suche durchsucht den Baum.\n");
+     }
+     return 1;
+ }
+
+ /**
+  * Lädt den Katalog: aus dem Schnappschuss, wenn er zur CSV-Datei passt, sonst
+  * aus der CSV-Datei, aus der anschließend ein neuer Schnappschuss geschrieben wird.
+  * Wurde die CSV-Datei nicht vollständig geladen, wird kein Schnappschuss
+  * geschrieben, damit spätere Starts nicht einen unvollständigen Katalog laden.
+  * @param csvPfad Pfad zur CSV-Datei
+  * @param schnappschussPfad Pfad des Schnappschusses
+  * @return Anzahl der Bücher im Schnappschuss bzw. der eingelesenen Datensätze
+  */
+ int katalogLaden(const char* csvPfad, const char* schnappschussPfad) {
+     if (schnappschussLaden(schnappschussPfad, csvPfad)) {
+         printf("Bibliotheksdaten aus Schnappschuss geladen: %u Bücher.\n", titelIndex.anzahlBuecher);
+         return (int)titelIndex.anzahlBuecher;
+     }
+
+     int anzahlBücher = csvDateiLaden(csvPfad);
+     if (anzahlBücher <= 0) {
+         printf("Hinweis: Ohne vollständig geladenen Katalog wird kein Schnappschuss geschrieben.\n");
+     } else if (!schnappschussSchreiben(schnappschussPfad, csvPfad)) {
+         printf("Hinweis: Schnappschuss %s konnte nicht geschrieben werden.\n", schnappschussPfad);
+     }
+     return anzahlBücher;
+ }
+
+ /**
+  * Liefert den Schlüssel der Ausleihe an einer Position in einem Ausleih-Index
+  * @param index Ausleih-Index nach ISBN oder nach Leser
+  * @param position Position der Ausleihe in ausleihen
+  * @return ISBN bzw. Lesernummer + 1 (nie 0, das einen freien Platz markiert)
+  */
+ uint64_t ausleiheSchluessel(const AusleihIndex* index, int position) {
+     return index->nachLeser ? (uint64_t)ausleihen[position].leser + 1 : ausleihen[position].isbn;
+ }
+
+ /**
+  * Berechnet den Heimatplatz eines Schlüssels im Ausleih-Index (Fibonacci-
+  * Hashing wie beim ISBN-Hashindex)
+  * @param index Der Ausleih-Index
+  * @param schluessel ISBN bzw. Lesernummer + 1
+  * @return Platz in der Tabelle
+  */
+ size_t ausleihIndexPlatz(const AusleihIndex* index, uint64_t schluessel) {
+     return (size_t)((schluessel * 0x9E3779B97F4A7C15ULL) >> index->verschiebung);
+ }
+
+ /**
+  * Sucht den Eintrag eines Schlüssels im Ausleih-Index
+  * @param index Der Ausleih-Index
+  * @param schluessel Zu suchende ISBN bzw. Lesernummer + 1
+  * @return Zeiger auf den Eintrag oder NULL, wenn es keine Ausleihe mit diesem Schlüssel gibt
+  */
+ AusleihIndexEintrag* ausleihIndexFinden(const AusleihIndex* index, uint64_t schluessel) {
+     if (index->eintraege == NULL) {
+         return NULL;
+     }
+
+     size_t platz = ausleihIndexPlatz(index, schluessel);
+     for (size_t abstand = 0; ; abstand++) {
+         AusleihIndexEintrag* eintrag = &index->eintraege[platz];
+         if (eintrag->schluessel == 0) {
+             return NULL;
+         }
+         if (eintrag->schluessel == schluessel) {
+             return eintrag;
+         }
+         // Ein Eintrag näher an seinem Heimatplatz: Der Schlüssel käme davor
+         if (((platz - ausleihIndexPlatz(index, eintrag->schluessel)) & index->maske) < abstand) {
+             return NULL;
+         }
+         platz = (platz + 1) & index->maske;
+     }
+ }
+
+ /**
+  * Trägt einen Schlüssel mit Robin-Hood-Verdrängung in die Tabelle eines
+  * Ausleih-Index ein (die Tabelle muss einen freien Platz haben)
+  * @param index Der Ausleih-Index
+  * @param neu Der einzutragende Eintrag
+  */
+ void ausleihIndexTabelleEintragen(AusleihIndex* index, AusleihIndexEintrag neu) {
+     AusleihIndexEintrag* eintraege = index->eintraege;
+     size_t platz = ausleihIndexPlatz(index, neu.schluessel);
+     size_t abstand = 0;
+     while (eintraege[platz].schluessel != 0) {
+         size_t abstandVorhanden = (platz - ausleihIndexPlatz(index, eintraege[platz].schluessel)) & index->maske;
+         if (abstandVorhanden < abstand) {
+             AusleihIndexEintrag tausch = eintraege[platz];
+             eintraege[platz] = neu;
+             neu = tausch;
+             abstand = abstandVorhanden;
+         }
+         platz = (platz + 1) & index->maske;
+         abstand++;
+     }
+     eintraege[platz] = neu;
+ }
+
+ /**
+  * Verdoppelt die Tabelle eines Ausleih-Index (anfangs 16 Plätze) und trägt
+  * alle Schlüssel neu ein
+  * @param index Der Ausleih-Index
+  * @return 1 bei Erfolg, 0 bei Speichermangel (die bisherige Tabelle bleibt erhalten)
+  */
+ int ausleihIndexVergroessern(AusleihIndex* index) {
+     size_t altePlaetze = index->eintraege != NULL ? index->maske + 1 : 0;
+     size_t plaetze = altePlaetze > 0 ? altePlaetze * 2 : 16;
+     AusleihIndexEintrag* eintraege = (AusleihIndexEintrag*)calloc(plaetze, sizeof(AusleihIndexEintrag));
+     if (eintraege == NULL) {
+         return 0;
+     }
+
+     int bits = 0;
+     while (((size_t)1 << bits) < plaetze) {
+         bits++;
+     }
+
+     AusleihIndexEintrag* alteEintraege = index->eintraege;
+     index->eintraege = eintraege;
+     index->maske = plaetze - 1;
+     index->verschiebung = 64 - bits;
+     for (size_t i = 0; i < altePlaetze; i++) {
+         if (alteEintraege[i].schluessel != 0) {
+             ausleihIndexTabelleEintragen(index, alteEintraege[i]);
+         }
+     }
+     free(alteEintraege);
+     return 1;
+ }
+
+ /**
+  * Nimmt die Ausleihe an einer Position von ausleihen in einen Ausleih-Index
+  * auf. Sie wird als jüngste Ausleihe ihres Schlüssels hinten angehängt.
+  * @param index Der Ausleih-Index
+  * @param position Position der bereits ausgefüllten Ausleihe
+  * @return 1 bei Erfolg, 0 bei Speichermangel (der Index bleibt unverändert)
+  */
+ int ausleihIndexEintragen(AusleihIndex* index, int position) {
+     // Verkettungen für die Position bereitstellen
+     if ((size_t)position >= index->kapazitaet) {
+         size_t kapazitaet = index->kapazitaet > 0 ? index->kapazitaet * 2 : 64;
+         while (kapazitaet <= (size_t)position) {
+             kapazitaet *= 2;
+         }
+         int* naechste = (int*)realloc(index->naechste, kapazitaet * sizeof(int));
+         if (naechste == NULL) {
+             return 0;
+         }
+         index->naechste = naechste;
+         int* vorherige = (int*)realloc(index->vorherige, kapazitaet * sizeof(int));
+         if (vorherige == NULL) {
+             return 0;
+         }
+         index->vorherige = vorherige;
+         index->kapazitaet = kapazitaet;
+     }
+
+     index->naechste[position] = -1;
+     index->vorherige[position] = -1;
+     uint64_t schluessel = ausleiheSchluessel(index, position);
+
+     // Weitere Ausleihe mit einem bereits vorhandenen Schlüssel: hinten anhängen
+     AusleihIndexEintrag* eintrag = ausleihIndexFinden(index, schluessel);
+     if (eintrag != NULL) {
+         index->vorherige[position] = eintrag->letzte;
+         index->naechste[eintrag->letzte] = position;
+         eintrag->letzte = position;
+         return 1;
+     }
+
+     // Neuer Schlüssel; die Tabelle ist höchstens zu 7/8 gefüllt
+     if ((index->anzahl + 1) * ISBN_HASH_FUELLUNG > (index->maske + 1) * (ISBN_HASH_FUELLUNG - 1) &&
+         !ausleihIndexVergroessern(index)) {
+         return 0;
+     }
+     AusleihIndexEintrag neu = { schluessel, position, position };
+     ausleihIndexTabelleEintragen(index, neu);
+     index->anzahl++;
+     return 1;
+ }
+
+ /**
+  * Entfernt die Ausleihe an einer Position aus einem Ausleih-Index. War es die
+  * einzige Ausleihe ihres Schlüssels, wird der Eintrag gelöscht und die
+  * folgenden Einträge rücken um einen Platz auf (Rückwärtsverschiebung statt
+  * Grabstein).
+  * @param index Der Ausleih-Index
+  * @param position Position der Ausleihe in ausleihen
+  */
+ void ausleihIndexAustragen(AusleihIndex* index, int position) {
+     int vorherige = index->vorherige[position];
+     int naechste = index->naechste[position];
+     if (vorherige >= 0) {
+         index->naechste[vorherige] = naechste;
+     }
+     if (naechste >= 0) {
+         index->vorherige[naechste] = vorherige;
+     }
+     if (vorherige >= 0 && naechste >= 0) {
+         return;
+     }
+
+     AusleihIndexEintrag* eintrag = ausleihIndexFinden(index, ausleiheSchluessel(index, position));
+     if (vorherige >= 0) {
+         eintrag->letzte = vorherige;
+         return;
+     }
+     if (naechste >= 0) {
+         eintrag->erste = naechste;
+         return;
+     }
+
+     size_t platz = (size_t)(eintrag - index->eintraege);
+     for (;;) {
+         size_t folgePlatz = (platz + 1) & index->maske;
+         AusleihIndexEintrag* folgend = &index->eintraege[folgePlatz];
+         if (folgend->schluessel == 0 || ausleihIndexPlatz(index, folgend->schluessel) == folgePlatz) {
+             break;
+         }
+         index->eintraege[platz] = *folgend;
+         platz = folgePlatz;
+     }
+     index->eintraege[platz].schluessel = 0;
+     index->anzahl--;
+ }
+
+ /**
+  * Trägt in einem Ausleih-Index ein, dass die Ausleihe von Position von nach
+  * Position nach umgesetzt wurde (ausleihen[nach] muss bereits die Ausleihe enthalten)
+  * @param index Der Ausleih-Index
+  * @param von Bisherige Position der Ausleihe
+  * @param nach Neue Position der Ausleihe
+  */
+ void ausleihIndexVerschieben(AusleihIndex* index, int von, int nach) {
+     int vorherige = index->vorherige[von];
+     int naechste = index->naechste[von];
+     index->vorherige[nach] = vorherige;
+     index->naechste[nach] = naechste;
+
+     if (vorherige >= 0) {
+         index->naechste[vorherige] = nach;
+     }
+     if (naechste >= 0) {
+         index->vorherige[naechste] = nach;
+     }
+     if (vorherige < 0 || naechste < 0) {
+         AusleihIndexEintrag* eintrag = ausleihIndexFinden(index, ausleiheSchluessel(index, nach));
+         if (vorherige < 0) {
+             eintrag->erste = nach;
+         }
+         if (naechste < 0) {
+             eintrag->letzte = nach;
+         }
+     }
+ }
+
+ /**
+  * Entfernt alle Schlüssel aus einem Ausleih-Index (der Speicher bleibt reserviert)
+  * @param index Der Ausleih-Index
+  */
+ void ausleihIndexLeeren(AusleihIndex* index) {
+     if (index->eintraege != NULL) {
+         memset(index->eintraege, 0, (index->maske + 1) * sizeof(AusleihIndexEintrag));
+     }
+     index->anzahl = 0;
+ }
+
+ /**
+  * Nimmt die Ausleihe an einer Position in den Ausleih-Index nach ISBN, in den
+  * Leser-Index und in den Fälligkeits-Heap auf
+  * @param position Position der bereits ausgefüllten Ausleihe
+  * @return 1 bei Erfolg, 0 bei Speichermangel (alle Indizes bleiben unverändert)
+  */
+ int ausleiheIndizieren(int position) {
+     int groesste = position > faelligkeiten.anzahl ? position : faelligkeiten.anzahl;
+     if (!faelligkeitenReservieren((size_t)groesste + 1)) {
+         return 0;
+     }
+     if (!ausleihIndexEintragen(&ausleihIndex, position)) {
+         return 0;
+     }
+     if (!ausleihIndexEintragen(&leserIndex, position)) {
+         ausleihIndexAustragen(&ausleihIndex, position);
+         return 0;
+     }
+     faelligkeitEintragen(position);
+     return 1;
+ }
+
+ /**
+  * Baut den Ausleih-Index nach ISBN, den Leser-Index und den Fälligkeits-Heap
+  * über alle Ausleihen neu auf
+  * @return 1 bei Erfolg, 0 bei Speichermangel
+  */
+ int ausleihIndexAufbauen() {
+     ausleihIndexLeeren(&ausleihIndex);
+     ausleihIndexLeeren(&leserIndex);
+
+     for (int i = 0; i < anzahlAusleihen; i++) {
+         if (!ausleihIndexEintragen(&ausleihIndex, i) || !ausleihIndexEintragen(&leserIndex, i)) {
+             return 0;
+         }
+     }
+     return faelligkeitenAufbauen();
+ }
+
+ /**
+  * Gibt den Speicher des Ausleih-Index nach ISBN, des Leser-Index und des
+  * Fälligkeits-Heaps frei
+  */
+ void ausleihIndexFreigeben() {
+     AusleihIndex* indizes[] = { &ausleihIndex, &leserIndex };
+     for (int i = 0; i < 2; i++) {
+         free(indizes[i]->eintraege);
+         free(indizes[i]->naechste);
+         free(indizes[i]->vorherige);
+         indizes[i]->eintraege = NULL;
+         indizes[i]->maske = 0;
+         indizes[i]->verschiebung = 0;
+         indizes[i]->anzahl = 0;
+         indizes[i]->naechste = NULL;
+         indizes[i]->vorherige = NULL;
+         indizes[i]->kapazitaet = 0;
+     }
+     faelligkeitenFreigeben();
+ }
+
+ /**
+  * Sucht die älteste Ausleihe einer ISBN über den Ausleih-Index
+  * @param isbn ISBN des Buches
+  * @return Position in ausleihen oder -1, wenn das Buch nicht ausgeliehen ist
+  */
+ int ausleiheSuchen(uint64_t isbn) {
+     AusleihIndexEintrag* eintrag = ausleihIndexFinden(&ausleihIndex, isbn);
+     return eintrag != NULL ? eintrag->erste : -1;
+ }
+
+ /**
+  * Liefert die älteste Ausleihe eines Lesers über den Leser-Index
+  * @param leser Nummer des Lesers
+  * @return Position in ausleihen oder -1, wenn der Leser nichts ausgeliehen hat
+  */
+ int leserAusleiheErste(unsigned int leser) {
+     AusleihIndexEintrag* eintrag = ausleihIndexFinden(&leserIndex, (uint64_t)leser + 1);
+     return eintrag != NULL ? eintrag->erste : -1;
+ }
+
+ /**
+  * Liefert die nächstjüngere Ausleihe desselben Lesers
+  * @param position Position einer Ausleihe in ausleihen
+  * @return Position in ausleihen oder -1, wenn es die jüngste Ausleihe des Lesers ist
+  */
+ int leserAusleiheNaechste(int position) {
+     return leserIndex.naechste[position];
+ }
+
+ /**
+  * Sucht die älteste Ausleihe einer ISBN im Konto eines Lesers; durchlaufen
+  * werden nur die Ausleihen dieses Lesers
+  * @param leser Nummer des Lesers
+  * @param isbn ISBN des Buches
+  * @return Position in ausleihen oder -1, wenn der Leser das Buch nicht ausgeliehen hat
+  */
+ int leserAusleiheSuchen(unsigned int leser, uint64_t isbn) {
+     for (int i = leserAusleiheErste(leser); i >= 0; i = leserAusleiheNaechste(i)) {
+         if (ausleihen[i].isbn == isbn) {
+             return i;
+         }
+     }
+     return -1;
+ }
+
+ /**
+  * Berechnet, wann eine Ausleihe zurückgegeben werden muss
+  * @param ausleihe Die Ausleihe
+  * @return Ausleihdatum plus AUSLEIHDAUER Tage
+  */
+ time_t ausleiheFaelligkeit(const Ausleihe* ausleihe) {
+     return ausleihe->ausleihDatum + (time_t)AUSLEIHDAUER * 24 * 60 * 60;
+ }
+
+ /**
+  * Vergleicht zwei Ausleihen nach Fälligkeit (bei gleicher Ausleihdauer also
+  * nach Ausleihdatum)
+  * @param positionA Position der ersten Ausleihe in ausleihen
+  * @param positionB Position der zweiten Ausleihe in ausleihen
+  * @return 1, wenn die erste Ausleihe früher fällig ist, sonst 0
+  */
+ int faelligkeitFrueher(int positionA, int positionB) {
+     return ausleihen[positionA].ausleihDatum < ausleihen[positionB].ausleihDatum;
+ }
+
+ /**
+  * Legt eine Ausleihe auf einen Platz im Fälligkeits-Heap und merkt sich den Platz
+  * @param platz Platz im Heap
+  * @param position Position der Ausleihe in ausleihen
+  */
+ void faelligkeitSetzen(int platz, int position) {
+     faelligkeiten.eintraege[platz] = position;
+     faelligkeiten.platz[position] = platz;
+ }
+
+ /**
+  * Lässt die Ausleihe auf einem Platz im Heap aufsteigen, bis ihr Elternplatz
+  * nicht später fällig ist
+  * @param platz Platz im Heap
+  */
+ void faelligkeitHochschieben(int platz) {
+     int position = faelligkeiten.eintraege[platz];
+     while (platz > 0) {
+         int eltern = (platz - 1) / 2;
+         if (!faelligkeitFrueher(position, faelligkeiten.eintraege[eltern])) {
+             break;
+         }
+         faelligkeitSetzen(platz, faelligkeiten.eintraege[eltern]);
+         platz = eltern;
+     }
+     faelligkeitSetzen(platz, position);
+ }
+
+ /**
+  * Lässt die Ausleihe auf einem Platz im Heap absinken, bis kein Kind früher fällig ist
+  * @param platz Platz im Heap
+  */
+ void faelligkeitHinunterschieben(int platz) {
+     int position = faelligkeiten.eintraege[platz];
+     for (;;) {
+         int kind = 2 * platz + 1;
+         if (kind >= faelligkeiten.anzahl) {
+             break;
+         }
+         if (kind + 1 < faelligkeiten.anzahl &&
+             faelligkeitFrueher(faelligkeiten.eintraege[kind + 1], faelligkeiten.eintraege[kind])) {
+             kind++;
+         }
+         if (!faelligkeitFrueher(faelligkeiten.eintraege[kind], position)) {
+             break;
+         }
+         faelligkeitSetzen(platz, faelligkeiten.eintraege[kind]);
+         platz = kind;
+     }
+     faelligkeitSetzen(platz, position);
+ }
+
+ /**
+  * Stellt sicher, dass der Fälligkeits-Heap mindestens anzahl Ausleihen
+  * aufnehmen kann (Kapazität wird verdoppelt)
+  * @param anzahl Benötigte Anzahl Ausleihen
+  * @return 1 bei Erfolg, 0 bei Speichermangel (der Heap bleibt unverändert)
+  */
+ int faelligkeitenReservieren(size_t anzahl) {
+     if (anzahl <= faelligkeiten.kapazitaet) {
+         return 1;
+     }
+     size_t kapazitaet = faelligkeiten.kapazitaet > 0 ? faelligkeiten.kapazitaet * 2 : 64;
+     while (kapazitaet < anzahl) {
+         kapazitaet *= 2;
+     }
+     int* eintraege = (int*)realloc(faelligkeiten.eintraege, kapazitaet * sizeof(int));
+     if (eintraege == NULL) {
+         return 0;
+     }
+     faelligkeiten.eintraege = eintraege;
+     int* platz = (int*)realloc(faelligkeiten.platz, kapazitaet * sizeof(int));
+     if (platz == NULL) {
+         return 0;
+     }
+     faelligkeiten.platz = platz;
+     faelligkeiten.kapazitaet = kapazitaet;
+     return 1;
+ }
+
+ /**
+  * Nimmt die Ausleihe an einer Position in den Fälligkeits-Heap auf
+  * @param position Position der bereits ausgefüllten Ausleihe
+  * @return 1 bei Erfolg, 0 bei Speichermangel
+  */
+ int faelligkeitEintragen(int position) {
+     if (!faelligkeitenReservieren((size_t)position + 1) ||
+         !faelligkeitenReservieren((size_t)faelligkeiten.anzahl + 1)) {
+         return 0;
+     }
+     faelligkeiten.eintraege[faelligkeiten.anzahl] = position;
+     faelligkeitHochschieben(faelligkeiten.anzahl++);
+     return 1;
+ }
+
+ /**
+  * Entfernt die Ausleihe an einer Position aus dem Fälligkeits-Heap; der letzte
+  * Eintrag des Heaps rückt auf ihren Platz und steigt auf oder sinkt ab
+  * @param position Position der Ausleihe in ausleihen
+  */
+ void faelligkeitAustragen(int position) {
+     int platz = faelligkeiten.platz[position];
+     int letzte = faelligkeiten.eintraege[--faelligkeiten.anzahl];
+     if (platz == faelligkeiten.anzahl) {
+         return;
+     }
+     faelligkeitSetzen(platz, letzte);
+     if (platz > 0 && faelligkeitFrueher(letzte, faelligkeiten.eintraege[(platz - 1) / 2])) {
+         faelligkeitHochschieben(platz);
+     } else {
+         faelligkeitHinunterschieben(platz);
+     }
+ }
+
+ /**
+  * Trägt im Fälligkeits-Heap ein, dass die Ausleihe von Position von nach
+  * Position nach umgesetzt wurde (die Fälligkeit ändert sich dabei nicht)
+  * @param von Bisherige Position der Ausleihe
+  * @param nach Neue Position der Ausleihe
+  */
+ void faelligkeitVerschieben(int von, int nach) {
+     faelligkeitSetzen(faelligkeiten.platz[von], nach);
+ }
+
+ /**
+  * Baut den Fälligkeits-Heap über alle Ausleihen in O(n) auf (Absinken ab dem
+  * letzten inneren Platz)
+  * @return 1 bei Erfolg, 0 bei Speichermangel
+  */
+ int faelligkeitenAufbauen() {
+     faelligkeiten.anzahl = 0;
+     if (!faelligkeitenReservieren((size_t)anzahlAusleihen)) {
+         return 0;
+     }
+     for (int i = 0; i < anzahlAusleihen; i++) {
+         faelligkeitSetzen(i, i);
+     }
+     faelligkeiten.anzahl = anzahlAusleihen;
+     for (int platz = anzahlAusleihen / 2 - 1; platz >= 0; platz--) {
+         faelligkeitHinunterschieben(platz);
+     }
+     return 1;
+ }
+
+ /**
+  * Gibt den Speicher des Fälligkeits-Heaps frei
+  */
+ void faelligkeitenFreigeben() {
+     free(faelligkeiten.eintraege);
+     free(faelligkeiten.platz);
+     faelligkeiten.eintraege = NULL;
+     faelligkeiten.platz = NULL;
+     faelligkeiten.anzahl = 0;
+     faelligkeiten.kapazitaet = 0;
+ }
+
+ /**
+  * Liefert die Ausleihe, die als nächste fällig ist (bzw. am längsten überfällig)
+  * @return Position in ausleihen oder -1, wenn nichts ausgeliehen ist
+  */
+ int naechsteFaelligkeit() {
+     return faelligkeiten.anzahl > 0 ? faelligkeiten.eintraege[0] : -1;
+ }
+
+ /**
+  * Vergleichsfunktion für qsort: Positionen in ausleihen nach Fälligkeit, bei
+  * gleicher Fälligkeit nach Position
+  */
+ int faelligkeitVergleichen(const void* a, const void* b) {
+     int positionA = *(const int*)a;
+     int positionB = *(const int*)b;
+     if (ausleihen[positionA].ausleihDatum != ausleihen[positionB].ausleihDatum) {
+         return ausleihen[positionA].ausleihDatum < ausleihen[positionB].ausleihDatum ? -1 : 1;
+     }
+     return (positionA > positionB) - (positionA < positionB);
+ }
+
+ /**
+  * Sucht alle Ausleihen, die zum Stichtag überfällig sind. Besucht werden nur
+  * die überfälligen Ausleihen im Heap und deren direkte Kinder, nicht alle
+  * Ausleihen.
+  * @param stichtag Zeitpunkt, zu dem die Fälligkeit überschritten sein muss
+  * @param ergebnis Erhält ein mit malloc angelegtes Array der Positionen in
+  *                 ausleihen, nach Fälligkeit sortiert (mit free freizugeben;
+  *                 NULL, wenn nichts überfällig ist)
+  * @return Anzahl überfälliger Ausleihen oder -1 bei Speichermangel
+  */
+ int ueberfaelligeSuchen(time_t stichtag, int** ergebnis) {
+     *ergebnis = NULL;
+     if (faelligkeiten.anzahl == 0 || ausleiheFaelligkeit(&ausleihen[faelligkeiten.eintraege[0]]) >= stichtag) {
+         return 0;
+     }
+
+     // Breitensuche ab der Wurzel; das Ergebnisarray dient zugleich als
+     // Warteschlange der Heap-Plätze
+     size_t kapazitaet = 64;
+     int* plaetze = (int*)malloc(kapazitaet * sizeof(int));
+     if (plaetze == NULL) {
+         return -1;
+     }
+     plaetze[0] = 0;
+     int anzahl = 1;
+     for (int i = 0; i < anzahl; i++) {
+         for (int kind = 2 * plaetze[i] + 1; kind <= 2 * plaetze[i] + 2 && kind < faelligkeiten.anzahl; kind++) {
+             if (ausleiheFaelligkeit(&ausleihen[faelligkeiten.eintraege[kind]]) >= stichtag) {
+                 continue;
+             }
+             if ((size_t)anzahl == kapazitaet) {
+                 int* groesser = (int*)realloc(plaetze, kapazitaet * 2 * sizeof(int));
+                 if (groesser == NULL) {
+                     free(plaetze);
+                     return -1;
+                 }
+                 plaetze = groesser;
+                 kapazitaet *= 2;
+             }
+             plaetze[anzahl++] = kind;
+         }
+     }
+
+     for (int i = 0; i < anzahl; i++) {
+         plaetze[i] = faelligkeiten.eintraege[plaetze[i]];
+     }
+     qsort(plaetze, (size_t)anzahl, sizeof(int), faelligkeitVergleichen);
+     *ergebnis = plaetze;
+     return anzahl;
+ }
+
+ /**
+  * Entfernt eine Ausleihe. Die letzte Ausleihe rückt in die Lücke, sodass
+  * ausleihen lückenlos bleibt; die Ausleih-Indizes und der Fälligkeits-Heap
+  * werden entsprechend angepasst.
+  * @param position Position der zu entfernenden Ausleihe
+  */
+ void ausleiheEntfernen(int position) {
+     ausleihIndexAustragen(&ausleihIndex, position);
+     ausleihIndexAustragen(&leserIndex, position);
+     faelligkeitAustragen(position);
+
+     int letzte = anzahlAusleihen - 1;
+     if (position < letzte) {
+         ausleihen[position] = ausleihen[letzte];
+         ausleihIndexVerschieben(&ausleihIndex, letzte, position);
+         ausleihIndexVerschieben(&leserIndex, letzte, position);
+         faelligkeitVerschieben(letzte, position);
+     }
+
+     anzahlAusleihen--;
+ }
+
+ /**
+  * Stellt sicher, dass ausleihen mindestens anzahl Ausleihen aufnehmen kann. Die
+  * Kapazität wird verdoppelt, sodass Anhängen im Mittel O(1) kostet.
+  * @param anzahl Benötigte Anzahl an Einträgen
+  * @return 1 bei Erfolg, 0 bei Speichermangel (die bisherigen Ausleihen bleiben erhalten)
+  */
+ int ausleihenReservieren(int anzahl) {
+     if (anzahl <= kapazitaetAusleihen) {
+         return 1;
+     }
+
+     int kapazitaet = kapazitaetAusleihen > 0 ? kapazitaetAusleihen : AUSLEIHEN_START;
+     while (kapazitaet < anzahl) {
+         kapazitaet *= 2;
+     }
+
+     Ausleihe* neu = (Ausleihe*)realloc(ausleihen, (size_t)kapazitaet * sizeof(Ausleihe));
+     if (neu == NULL) {
+         return 0;
+     }
+     ausleihen = neu;
+     kapazitaetAusleihen = kapazitaet;
+     return 1;
+ }
+
+ /**
+  * Gibt den Speicher aller Ausleihen und des Ausleih-Index frei
+  */
+ void ausleihenFreigeben() {
+     free(ausleihen);
+     ausleihen = NULL;
+     anzahlAusleihen = 0;
+     kapazitaetAusleihen = 0;
+     ausleihIndexFreigeben();
+     ausleihJournalSchliessen();
+     free(gruppenCommit.stapel);
+     free(gruppenCommit.schreibStapel);
+     gruppenCommit.stapel = NULL;
+     gruppenCommit.schreibStapel = NULL;
+     gruppenCommit.anzahl = 0;
+     gruppenCommit.kapazitaet = 0;
+     gruppenCommit.schreibKapazitaet = 0;
+ }
+
+ /**
+  * Hängt eine Ausleihe an ausleihen an und trägt sie in den Ausleih-Index ein
+  * (ohne sie zu protokollieren)
+  * @param isbn ISBN-13 des Buches
+  * @param ausleihDatum Datum der Ausleihe
+  * @param leser Nummer des Lesers
+  * @return 1 bei Erfolg, 0 bei Speichermangel
+  */
+ int ausleiheAnhaengen(uint64_t isbn, time_t ausleihDatum, unsigned int leser) {
+     if (!ausleihenReservieren(anzahlAusleihen + 1)) {
+         return 0;
+     }
+
+     Ausleihe* ausleihe = &ausleihen[anzahlAusleihen];
+     ausleihe->isbn = isbn;
+     ausleihe->ausleihDatum = ausleihDatum;
+     ausleihe->leser = leser;
+     ausleihe->buch = KEIN_KNOTEN;
+     if (!ausleiheIndizieren(anzahlAusleihen)) {
+         return 0;
+     }
+
+     anzahlAusleihen++;
+     return 1;
+ }
+
+ /**
+  * Legt eine Ausleihe an und kehrt erst zurück, wenn sie im Ausleihjournal
+  * dauerhaft gespeichert ist. Kann von mehreren Threads gleichzeitig aufgerufen
+  * werden; gleichzeitige Ausleihen werden gemeinsam gespeichert (Group Commit).
+  * @param isbn ISBN-13 des Buches
+  * @param ausleihDatum Datum der Ausleihe
+  * @param leser Nummer des Lesers
+  * @return 1 bei Erfolg, 0 bei Fehler
+  */
+ int ausleiheAnlegen(uint64_t isbn, time_t ausleihDatum, unsigned int leser) {
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     int ok = 0;
+     if (gruppenCommit.fehler) {
+         printf("Fehler beim Schreiben des Ausleihjournals!\n");
+     } else if (!ausleiheAnhaengen(isbn, ausleihDatum, leser)) {
+         printf("Fehler bei der Speicherreservierung!\n");
+     } else {
+         Ausleihe ausleihe = { isbn, ausleihDatum, leser, KEIN_KNOTEN };
+         ok = journalEintragSchreiben(JOURNAL_AUSLEIHE, &ausleihe);
+     }
+     pthread_mutex_unlock(&gruppenCommit.sperre);
+     return ok;
+ }
+
+ /**
+  * Bucht die Rückgabe der ältesten Ausleihe einer ISBN im Konto eines Lesers
+  * (die letzte Ausleihe rückt in die Lücke) und kehrt erst zurück, wenn sie im
+  * Ausleihjournal dauerhaft gespeichert ist. Kann von mehreren Threads
+  * gleichzeitig aufgerufen werden.
+  * @param leser Nummer des Lesers, der das Buch zurückgibt
+  * @param isbn ISBN-13 des Buches
+  * @return 1 bei Erfolg, 0 wenn der Leser die ISBN nicht ausgeliehen hat oder das Journal nicht geschrieben werden konnte
+  */
+ int rueckgabeBuchen(unsigned int leser, uint64_t isbn) {
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     int ok = 0;
+     int position = leserAusleiheSuchen(leser, isbn);
+     if (gruppenCommit.fehler) {
+         printf("Fehler beim Schreiben des Ausleihjournals!\n");
+     } else if (position >= 0) {
+         Ausleihe ausleihe = ausleihen[position];
+         ausleiheEntfernen(position);
+         ok = journalEintragSchreiben(JOURNAL_RUECKGABE, &ausleihe);
+     }
+     pthread_mutex_unlock(&gruppenCommit.sperre);
+     return ok;
+ }
+
+ /**
+  * Sammelt einen Eintrag für das Ausleihjournal und wartet, bis er dauerhaft
+  * gespeichert ist. Schreibt gerade kein anderer Thread, übernimmt der
+  * Aufrufer das Schreiben des ganzen Stapels. Ist noch kein Journal geöffnet,
+  * werden stattdessen alle Ausleihen gespeichert. Muss mit gesperrter
+  * gruppenCommit.sperre aufgerufen werden, nachdem die Änderung in den
+  * Speicher übernommen wurde. Schlägt das Speichern fehl, ist die Änderung bei
+  * der Rückkehr wieder aus dem Speicher entfernt.
+  * @param art JOURNAL_AUSLEIHE oder JOURNAL_RUECKGABE
+  * @param ausleihe Die angelegte bzw. zurückgegebene Ausleihe
+  * @return 1 bei Erfolg, 0 bei Schreibfehler
+  */
+ int journalEintragSchreiben(unsigned int art, const Ausleihe* ausleihe) {
+     if (ausleihJournal < 0) {
+         if (!ausleihenSpeichern()) {
+             ausleiheAenderungZuruecknehmen(art, ausleihe);
+             return 0;
+         }
+         return 1;
+     }
+     if (!journalStapelReservieren()) {
+         printf("Fehler bei der Speicherreservierung!\n");
+         ausleiheAenderungZuruecknehmen(art, ausleihe);
+         return 0;
+     }
+
+     JournalEintrag* eintrag = &gruppenCommit.stapel[gruppenCommit.anzahl++];
+     memset(eintrag, 0, sizeof(*eintrag));
+     eintrag->isbn = ausleihe->isbn;
+     eintrag->ausleihDatum = (long long)ausleihe->ausleihDatum;
+     eintrag->leser = ausleihe->leser;
+     eintrag->art = art;
+     eintrag->pruefsumme = datenPruefsumme((const char*)eintrag, offsetof(JournalEintrag, pruefsumme));
+     unsigned long long nummer = ++gruppenCommit.vergeben;
+
+     // Selbst schreiben oder warten, bis ein anderer Schreiber den Eintrag gespeichert hat
+     while (gruppenCommit.dauerhaft < nummer && !gruppenCommit.fehler) {
+         if (gruppenCommit.schreibend) {
+             pthread_cond_wait(&gruppenCommit.geschrieben, &gruppenCommit.sperre);
+         } else {
+             journalStapelSchreiben();
+         }
+     }
+     if (gruppenCommit.dauerhaft < nummer) {
+         // Der Schreiber hat die Änderung bereits zurückgenommen
+         printf("Fehler beim Schreiben des Ausleihjournals!\n");
+         return 0;
+     }
+     return 1;
+ }
+
+ /**
+  * Nimmt eine nicht gespeicherte Änderung im Speicher zurück: Eine angelegte
+  * Ausleihe wird entfernt, eine zurückgegebene wieder angehängt (als jüngste
+  * Ausleihe ihres Lesers). Muss mit gesperrter gruppenCommit.sperre
+  * aufgerufen werden.
+  * @param art JOURNAL_AUSLEIHE oder JOURNAL_RUECKGABE
+  * @param ausleihe Die angelegte bzw. zurückgegebene Ausleihe
+  */
+ void ausleiheAenderungZuruecknehmen(unsigned int art, const Ausleihe* ausleihe) {
+     if (art == JOURNAL_RUECKGABE) {
+         if (!ausleiheAnhaengen(ausleihe->isbn, ausleihe->ausleihDatum, ausleihe->leser)) {
+             printf("Hinweis: Die nicht gespeicherte Rückgabe konnte im Speicher nicht zurückgenommen werden.\n");
+         }
+         return;
      }
 
-     // Vergleichen der ISBNs, um die richtige Position im Baum zu finden
-     int vergleich = strcmp(isbn, wurzelKnoten->isbn);
-
-     // Wenn die ISBN kleiner ist, im linken Teilbaum einfügen
-     if (vergleich < 0) {
-         wurzelKnoten->links = buchEinfuegen(wurzelKnoten->links, isbn, titel);
+     // Jüngste passende Ausleihe des Lesers (gleiche ISBN und gleiches Datum)
+     int gefunden = -1;
+     for (int i = leserAusleiheErste(ausleihe->leser); i >= 0; i = leserAusleiheNaechste(i)) {
+         if (ausleihen[i].isbn == ausleihe->isbn && ausleihen[i].ausleihDatum == ausleihe->ausleihDatum) {
+             gefunden = i;
+         }
      }
-     // Wenn die ISBN größer ist, im rechten Teilbaum einfügen
-     else if (vergleich > 0) {
-         wurzelKnoten->rechts = buchEinfuegen(wurzelKnoten->rechts, isbn, titel);
+     if (gefunden >= 0) {
+         ausleiheEntfernen(gefunden);
      }
-     // Wenn die ISBN bereits existiert, nichts tun (Duplikate vermeiden)
-     // Alternativ könnte man hier den Titel aktualisieren, falls sich dieser geändert hat
-
-     return wurzelKnoten;
  }
 
  /**
- * Gibt den Speicher des Binärbaums rekursiv frei
- */
-void baumFreigeben(Buch* node) {
-    if (node != NULL) {
-        baumFreigeben(node->links);
-        baumFreigeben(node->rechts);
-        free(node);
-    }
-}
+  * Nimmt die Änderungen eines nicht gespeicherten Stapels von Journaleinträgen
+  * in umgekehrter Reihenfolge zurück, sodass z. B. eine Rückgabe vor der
+  * Ausleihe desselben Stapels zurückgenommen wird
+  * @param stapel Die Journaleinträge in der Reihenfolge ihrer Änderungen
+  * @param anzahl Anzahl der Einträge
+  */
+ void journalStapelZuruecknehmen(const JournalEintrag* stapel, size_t anzahl) {
+     for (size_t i = anzahl; i > 0; i--) {
+         Ausleihe ausleihe = { stapel[i - 1].isbn, (time_t)stapel[i - 1].ausleihDatum, stapel[i - 1].leser, KEIN_KNOTEN };
+         ausleiheAenderungZuruecknehmen(stapel[i - 1].art, &ausleihe);
+     }
+ }
 
  /**
-  * Sucht ein Buch im Binärbaum anhand der ISBN
-  * @param wurzelKnoten Wurzel des (Teil-)Baums, in dem gesucht wird
-  * @param isbn Zu suchende ISBN
-  * @return Zeiger auf das gefundene Buch oder NULL, wenn nicht gefunden
+  * Stellt Platz für einen weiteren Eintrag im Stapel gesammelter
+  * Journaleinträge bereit (Verdopplung)
+  * @return 1 bei Erfolg, 0 bei Speichermangel
   */
- Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, const char* isbn) {
-     // Wenn der Baum leer ist oder wir am Ende eines Pfades sind, Buch nicht gefunden
-     if (wurzelKnoten == NULL) {
-         return NULL;
+ int journalStapelReservieren() {
+     if (gruppenCommit.anzahl < gruppenCommit.kapazitaet) {
+         return 1;
      }
 
-     // ISBNs vergleichen
-     int vergleich = strcmp(isbn, wurzelKnoten->isbn);
+     size_t kapazitaet = gruppenCommit.kapazitaet > 0 ? gruppenCommit.kapazitaet * 2 : JOURNAL_STAPEL_START;
+     JournalEintrag* neu = (JournalEintrag*)realloc(gruppenCommit.stapel, kapazitaet * sizeof(JournalEintrag));
+     if (neu == NULL) {
+         return 0;
+     }
+     gruppenCommit.stapel = neu;
+     gruppenCommit.kapazitaet = kapazitaet;
+     return 1;
+ }
 
-     // Wenn die gesuchte ISBN kleiner ist, im linken Teilbaum suchen
-     if (vergleich < 0) {
-         return buchNachIsbnSuchen(wurzelKnoten->links, isbn);
+ /**
+  * Schreibt alle gesammelten Journaleinträge mit einem write und einem fsync.
+  * Der Schreiber wartet zuvor das Sammelfenster ab, damit sich Einträge
+  * anderer Threads anschließen können, und tauscht die Stapel, sodass während
+  * des Schreibens ohne Sperre weiter gesammelt wird. Wird das Journal zu lang,
+  * verdichtet der Schreiber es anschließend. Muss mit gesperrter
+  * gruppenCommit.sperre aufgerufen werden, während kein anderer Thread schreibt.
+  */
+ void journalStapelSchreiben() {
+     gruppenCommit.schreibend = 1;
+
+     if (gruppenCommit.fensterMikrosekunden > 0) {
+         struct timespec fenster = { gruppenCommit.fensterMikrosekunden / 1000000,
+                                     (long)(gruppenCommit.fensterMikrosekunden % 1000000) * 1000 };
+         pthread_mutex_unlock(&gruppenCommit.sperre);
+         nanosleep(&fenster, NULL);
+         pthread_mutex_lock(&gruppenCommit.sperre);
      }
-     // Wenn die gesuchte ISBN größer ist, im rechten Teilbaum suchen
-     else if (vergleich > 0) {
-         return buchNachIsbnSuchen(wurzelKnoten->rechts, isbn);
+
+     JournalEintrag* stapel = gruppenCommit.stapel;
+     size_t anzahl = gruppenCommit.anzahl;
+     size_t kapazitaet = gruppenCommit.kapazitaet;
+     gruppenCommit.stapel = gruppenCommit.schreibStapel;
+     gruppenCommit.kapazitaet = gruppenCommit.schreibKapazitaet;
+     gruppenCommit.anzahl = 0;
+     gruppenCommit.schreibStapel = stapel;
+     gruppenCommit.schreibKapazitaet = kapazitaet;
+     unsigned long long bis = gruppenCommit.vergeben;
+     int datei = ausleihJournal;
+     pthread_mutex_unlock(&gruppenCommit.sperre);
+
+     // Nach einem unvollständigen write mit dem Rest fortfahren
+     const char* daten = (const char*)stapel;
+     size_t rest = anzahl * sizeof(JournalEintrag);
+     int ok = datei >= 0;
+     while (ok && rest > 0) {
+         ssize_t geschrieben = write(datei, daten, rest);
+         ok = geschrieben > 0;
+         if (ok) {
+             daten += geschrieben;
+             rest -= (size_t)geschrieben;
+         }
      }
-     // Wenn die ISBNs übereinstimmen, Buch gefunden
-     else {
-         return wurzelKnoten;
+     ok = ok && fsync(datei) == 0;
+
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     gruppenCommit.schreibvorgaenge++;
+     if (ok) {
+         gruppenCommit.dauerhaft = bis;
+         journalEintraege += anzahl;
+
+         // Verdichten, sobald das Journal mindestens JOURNAL_VERDICHTEN_AB und
+         // mindestens so viele Einträge wie offene Ausleihen hat; das vollständige
+         // Schreiben verteilt sich so auf viele Ausleihen (im Mittel O(1) je Ausleihe)
+         if (journalEintraege >= JOURNAL_VERDICHTEN_AB && journalEintraege >= (size_t)anzahlAusleihen &&
+             !ausleihenSpeichern()) {
+             printf("Hinweis: Das Ausleihjournal konnte nicht verdichtet werden.\n");
+         }
+     } else {
+         // Alle nicht dauerhaft gespeicherten Änderungen zurücknehmen, damit der
+         // Speicher dem gespeicherten Stand entspricht: zuerst die während des
+         // Schreibens gesammelten, dann die des fehlgeschlagenen Stapels. Die
+         // wartenden Aufrufer melden den Fehler (dauerhaft < ihre Nummer).
+         gruppenCommit.fehler = 1;
+         journalStapelZuruecknehmen(gruppenCommit.stapel, gruppenCommit.anzahl);
+         gruppenCommit.anzahl = 0;
+         journalStapelZuruecknehmen(stapel, anzahl);
      }
+     gruppenCommit.schreibend = 0;
+     pthread_cond_broadcast(&gruppenCommit.geschrieben);
  }
 
  /**
-  * Konvertiert einen String zu Kleinbuchstaben
-  * @param str Der zu konvertierende String
+  * Legt das Sammelfenster des Group Commit fest: So lange wartet ein Schreiber
+  * auf Einträge anderer Threads, bevor er den Stapel schreibt. Größere Fenster
+  * bündeln mehr Einträge je fsync, verlängern aber die Wartezeit jedes Aufrufers.
+  * @param mikrosekunden Fenster in Mikrosekunden (0 = sofort schreiben), höchstens JOURNAL_MAX_FENSTER
   */
- void zuKleinbuchstaben(char* str) {
-     // Jeden Buchstaben zu Kleinbuchstaben konvertieren
-     for (int i = 0; str[i]; i++) {
-         str[i] = tolower(str[i]);
-     }
+ void journalFensterSetzen(unsigned int mikrosekunden) {
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     gruppenCommit.fensterMikrosekunden = mikrosekunden < JOURNAL_MAX_FENSTER ? mikrosekunden : JOURNAL_MAX_FENSTER;
+     pthread_mutex_unlock(&gruppenCommit.sperre);
  }
 
  /**
-  * Prüft, ob ein Teilstring in einem String enthalten ist (case-insensitiv)
-  * @param quelle Der zu durchsuchende String
-  * @param teilstring Der zu suchende Teilstring
-  * @return 1 wenn der Teilstring gefunden wurde, sonst 0
+  * Wendet einen Eintrag des Ausleihjournals auf die geladenen Ausleihen an
+  * @param eintrag Der Eintrag
+  * @return 1 bei Erfolg, 0 wenn der Eintrag nicht zu den Ausleihen passt
   */
- int enthältTeilstring(const char* quelle, const char* teilstring) {
-     // Wenn der Teilstring leer ist, geben wir true zurück - leerer Suchbegriff passt zu allem
-     if (teilstring == NULL || teilstring[0] == '\0') {
+ int journalEintragAnwenden(const JournalEintrag* eintrag) {
+     if (eintrag->art == JOURNAL_AUSLEIHE) {
+         return ausleiheAnhaengen(eintrag->isbn, (time_t)eintrag->ausleihDatum, eintrag->leser);
+     }
+     if (eintrag->art == JOURNAL_RUECKGABE) {
+         int position = leserAusleiheSuchen(eintrag->leser, eintrag->isbn);
+         if (position < 0) {
+             return 0;
+         }
+         ausleiheEntfernen(position);
          return 1;
      }
+     return 0;
+ }
 
-     // Wenn die Quelle leer ist, geben wir false zurück
-     if (quelle == NULL || quelle[0] == '\0') {
+ /**
+  * Legt ein leeres Ausleihjournal für die Ausleihdatei mit der angegebenen Größe
+  * und Prüfsumme an (über eine temporäre Datei, sodass immer ein vollständiger
+  * Kopf vorliegt) und öffnet es zum Anhängen
+  * @return 1 bei Erfolg, 0 bei Fehler
+  */
+ int ausleihJournalAnlegen(unsigned long long basisGroesse, unsigned long long basisPruefsumme) {
+     ausleihJournalSchliessen();
+
+     JournalKopf kopf;
+     memset(&kopf, 0, sizeof(kopf));
+     memcpy(kopf.kennung, "BIBJRNL", 8);
+     kopf.version = JOURNAL_VERSION;
+     kopf.eintragGroesse = sizeof(JournalEintrag);
+     kopf.basisGroesse = basisGroesse;
+     kopf.basisPruefsumme = basisPruefsumme;
+
+     char temporaer[1024];
+     snprintf(temporaer, sizeof(temporaer), "%s.tmp", AUSLEIHJOURNAL);
+     int datei = open(temporaer, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+     if (datei < 0) {
+         return 0;
+     }
+     int ok = write(datei, &kopf, sizeof(kopf)) == (ssize_t)sizeof(kopf) && fsync(datei) == 0;
+     if (close(datei) != 0 || !ok || rename(temporaer, AUSLEIHJOURNAL) != 0) {
+         remove(temporaer);
          return 0;
      }
 
-     // Kopien der Strings erstellen, um sie zu Kleinbuchstaben zu konvertieren
-     char quelleKlein[MAX_TITEL_LAENGE];
-     char teilstringKlein[MAX_TITEL_LAENGE];
-
-     // Strings kopieren
-     strncpy(quelleKlein, quelle, MAX_TITEL_LAENGE - 1);
-     quelleKlein[MAX_TITEL_LAENGE - 1] = '\0';
-
-     strncpy(teilstringKlein, teilstring, MAX_TITEL_LAENGE - 1);
-     teilstringKlein[MAX_TITEL_LAENGE - 1] = '\0';
-
-     // Zu Kleinbuchstaben konvertieren
-     zuKleinbuchstaben(quelleKlein);
-     zuKleinbuchstaben(teilstringKlein);
-
-     // Prüfen, ob der Teilstring in der Quelle enthalten ist
-     return strstr(quelleKlein, teilstringKlein) != NULL;
+     ausleihJournal = open(AUSLEIHJOURNAL, O_WRONLY | O_APPEND);
+     journalEintraege = 0;
+     gruppenCommit.fehler = 0;
+     return ausleihJournal >= 0;
  }
 
  /**
-  * Rekursive Suche nach Büchern mit einem bestimmten Titel (case-insensitiv)
-  * @param wurzelKnoten Wurzel des zu durchsuchenden (Teil-)Baums
-  * @param titel Zu suchender Titel (Teil des Titels)
-  * @param gefundeneISBNs Array, das die ISBNs der gefundenen Bücher aufnimmt
-  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
-  * @param aktuelleAnzahl Aktuelle Anzahl gefundener Bücher
-  * @return Aktualisierte Anzahl gefundener Bücher
+  * Spielt das Ausleihjournal nach dem Laden der Ausleihdatei ein. Das Journal
+  * gilt nur, wenn sein Kopf Größe und Prüfsumme der geladenen Ausleihdatei
+  * nennt; ein Journal von vor dem letzten Verdichten wird verworfen. Die
+  * Einträge werden bis zum ersten unvollständigen oder beschädigten Eintrag
+  * (z. B. nach einem Absturz während des Schreibens) übernommen, der Rest wird
+  * abgeschnitten, damit neue Einträge direkt dahinter folgen.
+  * @param basisGroesse Größe der geladenen Ausleihdatei
+  * @param basisPruefsumme Prüfsumme der geladenen Ausleihdatei
+  * @return 1 bei Erfolg, 0 wenn das Journal nicht geöffnet werden konnte
   */
- int büchernachTitelSuchenRekursiv(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults, int aktuelleAnzahl) {
-     // Wenn der Baum leer ist oder die maximale Anzahl erreicht wurde, beenden
-     if (wurzelKnoten == NULL || aktuelleAnzahl >= maxResults) {
-         return aktuelleAnzahl;
+ int ausleihJournalEinspielen(unsigned long long basisGroesse, unsigned long long basisPruefsumme) {
+     ausleihJournalSchliessen();
+
+     DateiAbbild journal;
+     if (!dateiAbbilden(AUSLEIHJOURNAL, &journal)) {
+         return ausleihJournalAnlegen(basisGroesse, basisPruefsumme);
+     }
+
+     JournalKopf kopf;
+     int passend = journal.groesse >= sizeof(kopf);
+     if (passend) {
+         memcpy(&kopf, journal.daten, sizeof(kopf));
+         passend = memcmp(kopf.kennung, "BIBJRNL", 8) == 0 && kopf.version == JOURNAL_VERSION &&
+                   kopf.eintragGroesse == sizeof(JournalEintrag) && kopf.basisGroesse == basisGroesse &&
+                   kopf.basisPruefsumme == basisPruefsumme;
      }
 
-     // Zuerst im linken Teilbaum suchen
-     aktuelleAnzahl = büchernachTitelSuchenRekursiv(wurzelKnoten->links, titel, isbnListe, maxResults, aktuelleAnzahl);
+     size_t gueltigBis = sizeof(kopf);
+     size_t angewendet = 0;
+     size_t unpassend = 0;
+     while (passend && gueltigBis + sizeof(JournalEintrag) <= journal.groesse) {
+         JournalEintrag eintrag;
+         memcpy(&eintrag, journal.daten + gueltigBis, sizeof(eintrag));
+         if (eintrag.pruefsumme != datenPruefsumme((const char*)&eintrag, offsetof(JournalEintrag, pruefsumme))) {
+             break;
+         }
+         if (!journalEintragAnwenden(&eintrag)) {
+             unpassend++;
+         }
+         gueltigBis += sizeof(JournalEintrag);
+         angewendet++;
+     }
+     size_t groesse = journal.groesse;
+     dateiAbbildFreigeben(&journal);
 
-     // Prüfen, ob der aktuelle Knoten dem Suchkriterium entspricht
-     if (aktuelleAnzahl < maxResults && enthältTeilstring(wurzelKnoten->titel, titel)) {
-         // Wenn ja, ISBN in die Liste aufnehmen
-         strncpy(isbnListe[aktuelleAnzahl], wurzelKnoten->isbn, LEN_ISBN - 1);
-         isbnListe[aktuelleAnzahl][LEN_ISBN - 1] = '\0';
-         aktuelleAnzahl++;
+     if (!passend) {
+         return ausleihJournalAnlegen(basisGroesse, basisPruefsumme);
+     }
+     if (unpassend > 0) {
+         printf("Hinweis: %zu Einträge des Ausleihjournals passten nicht zu den Ausleihen.\n", unpassend);
      }
 
-     // Dann im rechten Teilbaum suchen
-     aktuelleAnzahl = büchernachTitelSuchenRekursiv(wurzelKnoten->rechts, titel, isbnListe, maxResults, aktuelleAnzahl);
+     ausleihJournal = open(AUSLEIHJOURNAL, O_WRONLY | O_APPEND);
+     if (ausleihJournal < 0) {
+         return 0;
+     }
+     if (gueltigBis < groesse) {
+         printf("Hinweis: %zu Bytes unvollständiger oder beschädigter Einträge am Ende des Ausleihjournals wurden verworfen.\n",
+                groesse - gueltigBis);
+         if (ftruncate(ausleihJournal, (off_t)gueltigBis) != 0) {
+             ausleihJournalSchliessen();
+             return 0;
+         }
+     }
+     journalEintraege = angewendet;
+     return 1;
+ }
 
-     return aktuelleAnzahl;
+ /**
+  * Schließt das Ausleihjournal
+  */
+ void ausleihJournalSchliessen() {
+     if (ausleihJournal >= 0) {
+         close(ausleihJournal);
+     }
+     ausleihJournal = -1;
+     journalEintraege = 0;
  }
 
  /**
-  * Liest die CSV-Datei ein und baut den Binärbaum auf
+  * Lädt die Ausleihdaten: zuerst den zuletzt gespeicherten Stand aus der
+  * Ausleihdatei, danach alle seither protokollierten Ausleihen und Rückgaben
+  * aus dem Ausleihjournal. Fehlt die binäre Ausleihdatei, wird die frühere
+  * Textdatei eingelesen und anschließend als binäre Ausleihdatei gespeichert;
+  * enthält sie eine ungültige Ausleihe, bleibt sie der gespeicherte Stand und
+  * es wird keine binäre Ausleihdatei angelegt.
   */
- void csvDateiEinlesen() {
-     FILE* datei = fopen(CSV_DATEI, "r");
+ void ausleihenLaden() {
+     unsigned long long groesse = 0;
+     unsigned long long pruefsumme = 0;
+     int ergebnis = ausleihDateiLesen(AUSLEIHDATEI, &groesse, &pruefsumme);
+     if (ergebnis == -1) {
+         // Beschädigte Datei nicht beim nächsten Speichern überschreiben
+         char defekt[1024];
+         snprintf(defekt, sizeof(defekt), "%s.defekt", AUSLEIHDATEI);
+         rename(AUSLEIHDATEI, defekt);
+         printf("Fehler: Die Ausleihdatei ist beschädigt und wurde nach %s verschoben!\n", defekt);
+     }
+     int text = ergebnis == 0 ? ausleihTextdateiLesen(AUSLEIHTEXTDATEI, &groesse, &pruefsumme) : 0;
 
-     // Prüfen, ob die Datei geöffnet werden konnte
-     if (datei == NULL) {
-         printf("Fehler beim Öffnen der CSV-Datei: %s\n", CSV_DATEI);
+     if (ergebnis == -2 || text == -2 || !ausleihIndexAufbauen()) {
+         ausleihenSperren("Fehler bei der Speicherreservierung!");
          return;
      }
-
-     char zeile[1024];  // Puffer für eine Zeile aus der CSV-Datei
-
-     // Die erste Zeile (Header) überspringen
-     if (fgets(zeile, sizeof(zeile), datei) == NULL) {
-         printf("CSV-Datei ist leer oder fehlerhaft\n");
-         fclose(datei);
+     if (text < 0) {
+         // Keinen unvollständigen Stand als Ausleihdatei speichern
+         ausleihenSperren("Fehler: Die Ausleihen konnten nicht übernommen werden, die Textdatei bleibt unverändert!");
          return;
      }
 
-     int anzahlBücher = 0; // Zähler für erfolgreiche Einträge
-
-     // Zeile für Zeile einlesen
-     while (fgets(zeile, sizeof(zeile), datei) != NULL) {
-         char isbn[LEN_ISBN] = "";
-         char titel[MAX_TITEL_LAENGE] = "";
-
-         // CSV-Format verarbeiten: "isbn","titel",...
-         // Die ISBN ist das erste Feld, der Titel das zweite
-
-         // Verbesserter CSV-Parser zur korrekten Extraktion der Felder
-         char* pos = zeile;
-         int feldNummer = 0;
-         int inAnführungszeichen = 0;
-
-         char tempFeld[MAX_TITEL_LAENGE] = ""; // Temporärer Puffer für das aktuelle Feld
-         int tempIndex = 0;
+     // Seit dem letzten Speichern protokollierte Ausleihen und Rückgaben übernehmen
+     if (!ausleihJournalEinspielen(groesse, pruefsumme)) {
+         printf("Fehler beim Öffnen des Ausleihjournals!\n");
+     }
 
-         // Zeichen für Zeichen verarbeiten
-         for (int i = 0; zeile[i] != '\0' && zeile[i] != '\n'; i++) {
-             char c = zeile[i];
+     if (text == 1 && ausleihenSpeichern()) {
+         printf("Hinweis: %d Ausleihen aus %s nach %s übernommen.\n", anzahlAusleihen, AUSLEIHTEXTDATEI, AUSLEIHDATEI);
+     }
+ }
 
-             if (c == '"') {
-                 // Anfang oder Ende von Anführungszeichen
-                 inAnführungszeichen = !inAnführungszeichen;
+ /**
+  * Sperrt Ausleihen und Rückgaben, wenn die Ausleihdaten nicht vollständig
+  * geladen werden konnten: Sonst würde das nächste Speichern die Ausleihdatei
+  * mit dem unvollständigen Stand überschreiben. Die Ausleihen im Speicher
+  * werden verworfen, die Dateien bleiben unverändert.
+  * @param meldung Auszugebende Fehlermeldung
+  */
+ void ausleihenSperren(const char* meldung) {
+     printf("%s\n", meldung);
+     printf("Hinweis: Ausleihen und Rückgaben sind bis zum nächsten Programmstart gesperrt.\n");
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     ausleihJournalSchliessen();
+     gruppenCommit.fehler = 1;
+ }
 
-                 // Wenn Anführungszeichen geschlossen werden, feld könnte vollständig sein
-                 if (!inAnführungszeichen) {
-                     tempFeld[tempIndex] = '\0';
+ /**
+  * Liest die binäre Ausleihdatei ohne Zerlegen einzelner Zeilen: Nach dem Kopf
+  * werden alle Datensätze mit einem read direkt in ausleihen gelesen, wenn sie
+  * dasselbe Speicherlayout haben (sonst über einen Zwischenpuffer Feld für
+  * Feld übernommen), und über die Prüfsumme im Kopf geprüft
+  * @param pfad Pfad der Ausleihdatei
+  * @param groesse Erhält die Größe der Datei (0, wenn sie fehlt)
+  * @param pruefsumme Erhält die Prüfsumme des Kopfes, an die das Ausleihjournal gebunden ist
+  * @return 1 wenn die Ausleihen gelesen wurden, 0 wenn die Datei fehlt,
+  *         -1 wenn sie beschädigt ist, -2 bei Speichermangel (anzahlAusleihen ist dann 0)
+  */
+ int ausleihDateiLesen(const char* pfad, unsigned long long* groesse, unsigned long long* pruefsumme) {
+     anzahlAusleihen = 0;
+     *groesse = 0;
+     *pruefsumme = 0;
 
-                     if (feldNummer == 0) {
-                         // ISBN speichern
-                         strncpy(isbn, tempFeld, LEN_ISBN - 1);
-                         isbn[LEN_ISBN - 1] = '\0';
-                     } else if (feldNummer == 1) {
-                         // Titel speichern
-                         strncpy(titel, tempFeld, MAX_TITEL_LAENGE - 1);
-                         titel[MAX_TITEL_LAENGE - 1] = '\0';
+     int datei = open(pfad, O_RDONLY);
+     if (datei < 0) {
+         return 0;
+     }
 
-                         // Nach dem Titel können wir aufhören, wir benötigen keine weiteren Felder
-                         break;
-                     }
+     struct stat info;
+     AusleihDateiKopf kopf;
+     int gueltig = fstat(datei, &info) == 0 && read(datei, &kopf, sizeof(kopf)) == (ssize_t)sizeof(kopf);
+     gueltig = gueltig && memcmp(kopf.kennung, "BIBAUSL", 8) == 0 && kopf.version == AUSLEIHDATEI_VERSION &&
+               kopf.bytefolge == SCHNAPPSCHUSS_BYTEFOLGE && kopf.eintragGroesse == sizeof(AusleihDatensatz) &&
+               kopf.kopfPruefsumme == datenPruefsumme((const char*)&kopf, offsetof(AusleihDateiKopf, kopfPruefsumme)) &&
+               kopf.anzahl < 0x7FFFFFFFULL &&
+               (unsigned long long)info.st_size == sizeof(kopf) + kopf.anzahl * sizeof(AusleihDatensatz);
+     if (!gueltig) {
+         close(datei);
+         return -1;
+     }
 
-                     // Nächstes Feld vorbereiten
-                     feldNummer++;
-                     tempIndex = 0;
-                     tempFeld[0] = '\0';
-                 }
-             } else if (inAnführungszeichen) {
-                 // Zeichen innerhalb von Anführungszeichen zum temporären Feld hinzufügen
-                 if (tempIndex < MAX_TITEL_LAENGE - 1) {
-                     tempFeld[tempIndex++] = c;
-                 }
-             }
-         }
+     // Datensätze mit dem Speicherlayout von Ausleihe direkt einlesen; das
+     // reservierte Feld (0) wird dabei zu buch = KEIN_KNOTEN
+     int layoutPasst = sizeof(Ausleihe) == sizeof(AusleihDatensatz) && sizeof(time_t) == sizeof(long long) &&
+                       offsetof(Ausleihe, ausleihDatum) == offsetof(AusleihDatensatz, ausleihDatum) &&
+                       offsetof(Ausleihe, leser) == offsetof(AusleihDatensatz, leser) &&
+                       offsetof(Ausleihe, buch) == offsetof(AusleihDatensatz, reserviert);
+     size_t laenge = (size_t)kopf.anzahl * sizeof(AusleihDatensatz);
+     AusleihDatensatz* datensaetze = NULL;
+     if (!layoutPasst) {
+         datensaetze = (AusleihDatensatz*)malloc(laenge > 0 ? laenge : 1);
+     }
+     if (!ausleihenReservieren((int)kopf.anzahl) || (!layoutPasst && datensaetze == NULL)) {
+         close(datei);
+         return -2;
+     }
 
-         // Buch in den Binärbaum einfügen, wenn ISBN und Titel nicht leer sind
-         if (strlen(isbn) > 0 && strlen(titel) > 0) {
-             wurzel = buchEinfuegen(wurzel, isbn, titel);
-             anzahlBücher++;
-         }
+     char* ziel = layoutPasst ? (char*)ausleihen : (char*)datensaetze;
+     size_t gelesen = 0;
+     while (gueltig && gelesen < laenge) {
+         ssize_t anzahl = read(datei, ziel + gelesen, laenge - gelesen);
+         gueltig = anzahl > 0;
+         gelesen += gueltig ? (size_t)anzahl : 0;
      }
+     close(datei);
+     gueltig = gueltig && datenPruefsumme(ziel, laenge) == kopf.datenPruefsumme;
+
+     for (size_t i = 0; gueltig && !layoutPasst && i < (size_t)kopf.anzahl; i++) {
+         ausleihen[i].isbn = datensaetze[i].isbn;
+         ausleihen[i].ausleihDatum = (time_t)datensaetze[i].ausleihDatum;
+         ausleihen[i].leser = datensaetze[i].leser;
+         ausleihen[i].buch = KEIN_KNOTEN;
+     }
+     free(datensaetze);
 
-     printf("Bibliotheksdaten geladen: %d Bücher eingelesen.\n", anzahlBücher);
-     fclose(datei);
+     if (!gueltig) {
+         return -1;
+     }
+     anzahlAusleihen = (int)kopf.anzahl;
+     *groesse = (unsigned long long)info.st_size;
+     *pruefsumme = kopf.kopfPruefsumme;
+     return 1;
  }
 
  /**
-  * Lädt die Ausleihdaten aus der Datei
+  * Liest die Ausleihen aus der früheren Textdatei (je Ausleihe eine Zeile mit
+  * der ISBN und eine mit dem Ausleihdatum). Das Lesen bricht bei der ersten
+  * ungültigen Ausleihe ab, statt sie zu überspringen.
+  * @param pfad Pfad der Textdatei
+  * @param groesse Erhält die Größe der Datei
+  * @param pruefsumme Erhält die Prüfsumme über den Inhalt der Datei
+  * @return 1 wenn die Datei vollständig gelesen wurde, 0 wenn sie fehlt,
+  *         -1 bei einer ungültigen Ausleihe, -2 bei Speichermangel
   */
- void ausleihenLaden() {
-     FILE* datei = fopen(AUSLEIHDATEI, "r");
-
-     // Wenn die Datei nicht existiert, gibt es noch keine Ausleihen
-     if (datei == NULL) {
-         return;
-     }
-
-     // Ausleihen einlesen
+ int ausleihTextdateiLesen(const char* pfad, unsigned long long* groesse, unsigned long long* pruefsumme) {
      anzahlAusleihen = 0;
+     DateiAbbild abbild;
+     if (!dateiAbbilden(pfad, &abbild)) {
+         return 0;
+     }
 
-     while (anzahlAusleihen < MAX_AUSLEIHEN && 
-             fscanf(datei, "%13s\n", ausleihen[anzahlAusleihen].isbn) == 1) {
-
-         // Titel aus dem Binärbaum abrufen
-         Buch* buch = buchNachIsbnSuchen(wurzel, ausleihen[anzahlAusleihen].isbn);
-         if (buch != NULL) {
-             strncpy(ausleihen[anzahlAusleihen].titel, buch->titel, MAX_TITEL_LAENGE - 1);
-             ausleihen[anzahlAusleihen].titel[MAX_TITEL_LAENGE - 1] = '\0';
-         } else {
-             strcpy(ausleihen[anzahlAusleihen].titel, "Unbekanntes Buch");
+     int ergebnis = 1;
+     const char* position = abbild.daten;
+     const char* ende = abbild.daten + abbild.groesse;
+     for (;;) {
+         const char* isbnText;
+         size_t isbnLaenge;
+         const char* datumText;
+         size_t datumLaenge;
+         position = ausleihFeldLesen(position, ende, &isbnText, &isbnLaenge);
+         position = ausleihFeldLesen(position, ende, &datumText, &datumLaenge);
+         if (isbnLaenge == 0) {
+             break;
          }
 
          // Ausleihdatum einlesen
-         fscanf(datei, "%ld\n", &ausleihen[anzahlAusleihen].ausleihDatum);
+         char datum[32];
+         char* datumEnde = datum;
+         long long ausleihDatum = 0;
+         if (datumLaenge > 0 && datumLaenge < sizeof(datum)) {
+             memcpy(datum, datumText, datumLaenge);
+             datum[datumLaenge] = '\0';
+             ausleihDatum = strtoll(datum, &datumEnde, 10);
+         }
+
+         // Ausleihen werden unter der ISBN-13 als Zahl geführt
+         uint64_t isbn;
+         if (datumEnde == datum || *datumEnde != '\0' || !isbnLesen(isbnText, isbnLaenge, &isbn)) {
+             printf("Fehler: Die Ausleihe Nr. %d in %s ist ungültig!\n", anzahlAusleihen + 1, pfad);
+             ergebnis = -1;
+             break;
+         }
 
+         if (!ausleihenReservieren(anzahlAusleihen + 1)) {
+             ergebnis = -2;
+             break;
+         }
+         ausleihen[anzahlAusleihen].isbn = isbn;
+         ausleihen[anzahlAusleihen].ausleihDatum = (time_t)ausleihDatum;
+         ausleihen[anzahlAusleihen].leser = 0;
+         ausleihen[anzahlAusleihen].buch = KEIN_KNOTEN;
          anzahlAusleihen++;
      }
 
-     fclose(datei);
+     *groesse = abbild.groesse;
+     *pruefsumme = datenPruefsumme(abbild.daten, abbild.groesse);
+     dateiAbbildFreigeben(&abbild);
+     return ergebnis;
+ }
+
+ /**
+  * Liest ein durch Leerraum getrenntes Feld der Ausleihdatei
+  * @param position Aktuelle Leseposition
+  * @param ende Ende der Datei
+  * @param anfang Erhält den Anfang des Feldes
+  * @param laenge Erhält die Länge des Feldes (0, wenn kein Feld mehr folgt)
+  * @return Position hinter dem Feld
+  */
+ const char* ausleihFeldLesen(const char* position, const char* ende, const char** anfang, size_t* laenge) {
+     while (position < ende && isspace((unsigned char)*position)) {
+         position++;
+     }
+     *anfang = position;
+     while (position < ende && !isspace((unsigned char)*position)) {
+         position++;
+     }
+     *laenge = (size_t)(position - *anfang);
+     return position;
  }
 
  /**
-  * Speichert die Ausleihdaten in der Datei
+  * Speichert alle Ausleihen in der binären Ausleihdatei und beginnt ein leeres
+  * Ausleihjournal (Verdichten). Die Datei wird über eine temporäre Datei
+  * ersetzt; bricht das Programm vorher ab, bleiben die alte Ausleihdatei und
+  * das zugehörige Journal gültig, danach passt das alte Journal nicht mehr
+  * zur neuen Ausleihdatei und wird beim Laden verworfen.
+  * @return 1 bei Erfolg, 0 bei Fehler
   */
- void ausleihenSpeichern() {
-     FILE* datei = fopen(AUSLEIHDATEI, "w");
+ int ausleihenSpeichern() {
+     // Datensätze mit genullten Füllbytes aufbauen, damit die Prüfsumme eindeutig ist
+     AusleihDatensatz* datensaetze = (AusleihDatensatz*)calloc((size_t)(anzahlAusleihen > 0 ? anzahlAusleihen : 1),
+                                                              sizeof(AusleihDatensatz));
+     if (datensaetze == NULL) {
+         printf("Fehler bei der Speicherreservierung!\n");
+         return 0;
+     }
+     for (int i = 0; i < anzahlAusleihen; i++) {
+         datensaetze[i].isbn = ausleihen[i].isbn;
+         datensaetze[i].ausleihDatum = (long long)ausleihen[i].ausleihDatum;
+         datensaetze[i].leser = ausleihen[i].leser;
+     }
+     size_t laenge = (size_t)anzahlAusleihen * sizeof(AusleihDatensatz);
+
+     AusleihDateiKopf kopf;
+     memset(&kopf, 0, sizeof(kopf));
+     memcpy(kopf.kennung, "BIBAUSL", 8);
+     kopf.version = AUSLEIHDATEI_VERSION;
+     kopf.bytefolge = SCHNAPPSCHUSS_BYTEFOLGE;
+     kopf.eintragGroesse = sizeof(AusleihDatensatz);
+     kopf.anzahl = (unsigned long long)anzahlAusleihen;
+     kopf.datenPruefsumme = datenPruefsumme((const char*)datensaetze, laenge);
+     kopf.kopfPruefsumme = datenPruefsumme((const char*)&kopf, offsetof(AusleihDateiKopf, kopfPruefsumme));
+
+     char temporaer[1024];
+     snprintf(temporaer, sizeof(temporaer), "%s.tmp", AUSLEIHDATEI);
+     FILE* datei = fopen(temporaer, "wb");
 
      // Prüfen, ob die Datei geöffnet werden konnte
      if (datei == NULL) {
          printf("Fehler beim Öffnen der Ausleihdatei zum Schreiben!\n");
-         return;
+         free(datensaetze);
+         return 0;
      }
 
-     // Ausleihen speichern
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         fprintf(datei, "%s\n%ld\n", ausleihen[i].isbn, ausleihen[i].ausleihDatum);
+     // Ausleihen speichern und erst nach dem Schreiben auf die Platte umbenennen
+     int ok = fwrite(&kopf, sizeof(kopf), 1, datei) == 1 && fwrite(datensaetze, 1, laenge, datei) == laenge &&
+              fflush(datei) == 0 && fsync(fileno(datei)) == 0;
+     free(datensaetze);
+     if (fclose(datei) != 0 || !ok || rename(temporaer, AUSLEIHDATEI) != 0) {
+         printf("Fehler beim Schreiben der Ausleihdatei!\n");
+         remove(temporaer);
+         return 0;
      }
 
-     fclose(datei);
+     // Die Ausleihdatei enthält auch alle noch nicht geschriebenen Einträge des Stapels
+     gruppenCommit.anzahl = 0;
+     gruppenCommit.dauerhaft = gruppenCommit.vergeben;
+     if (!ausleihJournalAnlegen(sizeof(kopf) + laenge, kopf.kopfPruefsumme)) {
+         printf("Fehler beim Öffnen des Ausleihjournals!\n");
+         return 0;
+     }
+     return 1;
  }
 
  /* Implementierung der öffentlichen Funktionen */
@@ -406,28 +5070,72 @@ void baumFreigeben(Buch* node) {
  }
 
  /**
-  * Sucht nach Büchern mit einem bestimmten Titel
-  * @param titel Zu suchender Titel (Teil des Titels)
-  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnehmen soll
-  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  * Zeigt die nächste Seite einer Titelsuche an. Titel und ISBN werden direkt
+  * aus den gefundenen Büchern gelesen.
+  * @param cursor Suchposition (siehe titelSucheStarten)
+  * @param isbnListe Array, das die ISBNs der angezeigten Bücher aufnimmt
+  * @param maxResults Maximale Anzahl anzuzeigender Ergebnisse (höchstens MAXRESULTS)
+  * @return Anzahl angezeigter Bücher
   */
- void nachTitelSuchen(char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+ int titelSeiteAnzeigen(TitelCursor* cursor, char isbnListe[][LEN_ISBN], int maxResults) {
+     Buch* treffer[MAXRESULTS];
+     if (maxResults > MAXRESULTS) {
+         maxResults = MAXRESULTS;
+     }
+
      // Alle Einträge in der ISBN-Liste auf leere Strings setzen
      for (int i = 0; i < maxResults; i++) {
          isbnListe[i][0] = '\0';
      }
 
-     // Rekursive Suche im Binärbaum durchführen
-     int gefunden = büchernachTitelSuchenRekursiv(wurzel, titel, isbnListe, maxResults, 0);
+     int bisher = cursor->anzahlGeliefert;
+     int gefunden = titelSucheFortsetzen(cursor, treffer, maxResults);
+     trefferAlsIsbnListe(treffer, gefunden, isbnListe);
 
      // Ausgabe, wie viele Bücher gefunden wurden
-     printf("Es wurden %d Bücher mit dem Titel '%s' gefunden.\n", gefunden, titel);
+     if (bisher == 0) {
+         printf("Es wurden %d Bücher mit dem Titel '%s' gefunden.\n", gefunden, cursor->titel);
+     } else if (gefunden == 0) {
+         printf("Keine weiteren Bücher mit dem Titel '%s'.\n", cursor->titel);
+     }
      for (int i = 0; i < gefunden; i++) {
-         // Buch im Binärbaum finden, um den kompletten Titel auszugeben
-         Buch* buch = buchNachIsbnSuchen(wurzel, isbnListe[i]);
-         if (buch != NULL) {
-             printf("%d. ISBN: %s, Titel: %s\n", i + 1, isbnListe[i], buch->titel);
+         printf("%d. ISBN: %s, Titel: %s\n", bisher + i + 1, isbnListe[i], buchTitel(treffer[i]));
+     }
+
+     return gefunden;
+ }
+
+ /**
+  * Sucht nach Büchern mit einem bestimmten Titel und zeigt die erste Seite an
+  * @param titel Zu suchender Titel
+  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnehmen soll
+  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
+  */
+ void nachTitelSuchen(char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
+     TitelCursor cursor;
+     titelSucheStarten(&cursor, titel);
+     titelSeiteAnzeigen(&cursor, isbnListe, maxResults);
+ }
+
+ /**
+  * Sucht nach Büchern mit einem bestimmten Titel und blättert auf Wunsch des
+  * Benutzers seitenweise durch alle Treffer
+  * @param titel Zu suchender Titel
+  */
+ void nachTitelSuchenSeitenweise(char* titel) {
+     char isbnListe[MAXRESULTS][LEN_ISBN];
+     char antwort[16];
+
+     TitelCursor cursor;
+     titelSucheStarten(&cursor, titel);
+     titelSeiteAnzeigen(&cursor, isbnListe, MAXRESULTS);
+
+     while (!cursor.erschoepft) {
+         printf("\nWeitere Treffer anzeigen? (j/n): ");
+         if (fgets(antwort, sizeof(antwort), stdin) == NULL || (antwort[0] != 'j' && antwort[0] != 'J')) {
+             break;
          }
+         titelSeiteAnzeigen(&cursor, isbnListe, MAXRESULTS);
      }
  }
 
@@ -443,94 +5151,106 @@ void baumFreigeben(Buch* node) {
          isbnListe[i][0] = '\0';
      }
 
-     // Buch im Binärbaum suchen
-     Buch* buch = buchNachIsbnSuchen(wurzel, isbn);
+     // ISBN prüfen und in ihren Zahlenschlüssel umwandeln
+     uint64_t schluessel;
+     if (!isbnLesen(isbn, strlen(isbn), &schluessel)) {
+         printf("Ungültige ISBN: '%s'\n", isbn);
+         return;
+     }
+
+     // Buch im Katalog suchen
+     Buch* buch = katalogBuchSuchen(schluessel);
 
      // Wenn ein Buch gefunden wurde, die ISBN in die Liste eintragen
      if (buch != NULL) {
-         strncpy(isbnListe[0], buch->isbn, LEN_ISBN - 1);
-         isbnListe[0][LEN_ISBN - 1] = '\0';
-         printf("Buch gefunden: ISBN: %s, Titel: %s\n", buch->isbn, buch->titel);
+         isbnFormatieren(buch->isbn, isbnListe[0]);
+         printf("Buch gefunden: ISBN: %s, Titel: %s\n", isbnListe[0], buchTitel(buch));
      } else {
          printf("Kein Buch mit der ISBN '%s' gefunden.\n", isbn);
      }
  }
 
  /**
-  * Leiht ein Buch aus
+  * Leiht ein Buch für den aktuellen Leser aus
   * @param isbn ISBN des auszuleihenden Buches
   * @return 1 bei Erfolg, 0 bei Misserfolg
   */
  int buchAusleihen(char* isbn) {
+     // ISBN prüfen; ausgeliehen wird immer unter der ISBN-13 des Buches
+     uint64_t schluessel;
+     if (!isbnLesen(isbn, strlen(isbn), &schluessel)) {
+         printf("Fehler: Ungültige ISBN '%s'!\n", isbn);
+         return 0;
+     }
+
      // Prüfen, ob das Buch existiert
-     Buch* buch = buchNachIsbnSuchen(wurzel, isbn);
+     Buch* buch = katalogBuchSuchen(schluessel);
      if (buch == NULL) {
          printf("Fehler: Das Buch mit der ISBN '%s' existiert nicht!\n", isbn);
          return 0;
      }
 
-     // Prüfen, ob noch Platz für weitere Ausleihen ist
-     if (anzahlAusleihen >= MAX_AUSLEIHEN) {
-         printf("Fehler: Maximale Anzahl an Ausleihen erreicht!\n");
-         return 0;
+     // Prüfen, ob das Buch bereits ausgeliehen ist (obwohl laut Aufgabe unbegrenzt viele Exemplare vorhanden sind);
+     // der Ausleih-Index wird wie von den schreibenden Threads nur unter der Sperre gelesen
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     int ausgeliehen = ausleiheSuchen(schluessel) >= 0;
+     pthread_mutex_unlock(&gruppenCommit.sperre);
+     if (ausgeliehen) {
+         printf("Hinweis: Das Buch ist bereits ausgeliehen, aber da unbegrenzt viele Exemplare vorhanden sind, wird es erneut ausgeliehen.\n");
      }
 
-     // Prüfen, ob das Buch bereits ausgeliehen ist (obwohl laut Aufgabe unbegrenzt viele Exemplare vorhanden sind)
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         if (strcmp(ausleihen[i].isbn, isbn) == 0) {
-             printf("Hinweis: Das Buch ist bereits ausgeliehen, aber da unbegrenzt viele Exemplare vorhanden sind, wird es erneut ausgeliehen.\n");
-             break;
-         }
+     // Buch mit dem aktuellen Datum ausleihen; die Ausleihe wird dabei im
+     // Ausleihjournal gespeichert
+     if (!ausleiheAnlegen(schluessel, time(NULL), aktuellerLeser)) {
+         return 0;
      }
 
-     // Buch ausleihen
-     strncpy(ausleihen[anzahlAusleihen].isbn, isbn, LEN_ISBN - 1);
-     ausleihen[anzahlAusleihen].isbn[LEN_ISBN - 1] = '\0';
-
-     strncpy(ausleihen[anzahlAusleihen].titel, buch->titel, MAX_TITEL_LAENGE - 1);
-     ausleihen[anzahlAusleihen].titel[MAX_TITEL_LAENGE - 1] = '\0';
-
-     // Aktuelles Datum als Ausleihdatum festlegen
-     ausleihen[anzahlAusleihen].ausleihDatum = time(NULL);
-
-     anzahlAusleihen++;
-
-     // Ausleihdaten speichern
-     ausleihenSpeichern();
-
-     printf("Buch '%s' erfolgreich ausgeliehen.\n", buch->titel);
+     printf("Buch '%s' erfolgreich ausgeliehen.\n", buchTitel(buch));
      return 1;
  }
 
  /**
-  * Zeigt das Ausleihkonto an
-  * @return Anzahl der ausgeliehenen Bücher
+  * Zeigt das Ausleihkonto des aktuellen Lesers an; über den Leser-Index werden
+  * nur dessen Ausleihen durchlaufen. Ausleihen und Index werden unter
+  * gruppenCommit.sperre gelesen, da andere Threads sie gleichzeitig ändern
+  * (und ausleihen dabei verschieben) können.
+  * @return Anzahl der vom aktuellen Leser ausgeliehenen Bücher
   */
  int kontoAnzeigen() {
      // Aktuelle Zeit für Vergleich mit Ausleihdatum
      time_t jetzt = time(NULL);
 
-     printf("\n=== Ihr Ausleihkonto ===\n");
-     printf("Anzahl ausgeliehener Bücher: %d\n\n", anzahlAusleihen);
+     // Ausleihen des Lesers zählen
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     int anzahl = 0;
+     for (int i = leserAusleiheErste(aktuellerLeser); i >= 0; i = leserAusleiheNaechste(i)) {
+         anzahl++;
+     }
+
+     printf("\n=== Ihr Ausleihkonto (Leser %u) ===\n", aktuellerLeser);
+     printf("Anzahl ausgeliehener Bücher: %d\n\n", anzahl);
 
-     if (anzahlAusleihen == 0) {
+     if (anzahl == 0) {
          printf("Sie haben derzeit keine Bücher ausgeliehen.\n");
      } else {
          printf("%-14s %-50s %-20s\n", "ISBN", "Titel", "Restliche Ausleihdauer");
          printf("---------------------------------------------------------------------------------\n");
 
-         for (int i = 0; i < anzahlAusleihen; i++) {
-             // Berechnen der verstrichenen Zeit seit der Ausleihe in Tagen
-             double verstricheneTage = difftime(jetzt, ausleihen[i].ausleihDatum) / (60 * 60 * 24);
+         // In Ausleihreihenfolge, die älteste Ausleihe zuerst
+         for (int i = leserAusleiheErste(aktuellerLeser); i >= 0; i = leserAusleiheNaechste(i)) {
+             // Überfällig wie in der Mahnliste, sobald die Fälligkeit überschritten ist
+             time_t faellig = ausleiheFaelligkeit(&ausleihen[i]);
 
-             // Berechnen der verbleibenden Ausleihdauer
-             int restlicheTage = AUSLEIHDAUER - (int)verstricheneTage;
+             // Berechnen der verbleibenden Ausleihdauer (negativ: Tage seit der Fälligkeit)
+             int restlicheTage = (int)(difftime(faellig, jetzt) / (60 * 60 * 24));
 
              // Anzeigen der Buch-Informationen
-             printf("%-14s %-50s ", ausleihen[i].isbn, ausleihen[i].titel);
+             char isbnText[LEN_ISBN];
+             isbnFormatieren(ausleihen[i].isbn, isbnText);
+             printf("%-14s %-50s ", isbnText, ausleiheTitel(&ausleihen[i]));
 
              // Warnung, wenn die Ausleihdauer überschritten wurde
-             if (restlicheTage < 0) {
+             if (faellig < jetzt) {
                  printf("ÜBERFÄLLIG seit %d Tagen!\n", -restlicheTage);
              } else {
                  printf("Noch %d Tage\n", restlicheTage);
@@ -539,51 +5259,151 @@ void baumFreigeben(Buch* node) {
      }
 
      printf("\n======================\n");
+     pthread_mutex_unlock(&gruppenCommit.sperre);
 
-     return anzahlAusleihen;
+     return anzahl;
  }
 
  /**
-  * Gibt ein ausgeliehenes Buch zurück
+  * Gibt ein vom aktuellen Leser ausgeliehenes Buch zurück
   * @param isbn ISBN des zurückzugebenden Buches
   * @return 1 bei Erfolg, 0 bei Misserfolg
   */
  int buchZurueckgeben(char* isbn) {
-     // Index des zurückzugebenden Buches suchen
+     // Wie beim Ausleihen als ISBN-13 im Konto des aktuellen Lesers suchen;
+     // zurückgegeben wird seine älteste Ausleihe dieser ISBN
      int index = -1;
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         if (strcmp(ausleihen[i].isbn, isbn) == 0) {
-             index = i;
-             break;
-         }
+     const char* titel = NULL;
+     uint64_t schluessel;
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     if (isbnLesen(isbn, strlen(isbn), &schluessel)) {
+         index = leserAusleiheSuchen(aktuellerLeser, schluessel);
+     }
+
+     // Buchname für die Ausgabemeldung nachschlagen (der Titel-Pool bleibt
+     // unverändert, der Titel gilt daher auch nach dem Freigeben der Sperre)
+     if (index >= 0) {
+         titel = ausleiheTitel(&ausleihen[index]);
      }
+     pthread_mutex_unlock(&gruppenCommit.sperre);
 
      // Wenn das Buch nicht gefunden wurde
      if (index == -1) {
-         printf("Fehler: Das Buch mit der ISBN '%s' ist nicht ausgeliehen!\n", isbn);
+         printf("Fehler: Das Buch mit der ISBN '%s' ist in Ihrem Konto nicht ausgeliehen!\n", isbn);
          return 0;
      }
 
-     // Buchname für die Ausgabemeldung speichern
-     char titelKopie[MAX_TITEL_LAENGE];
-     strncpy(titelKopie, ausleihen[index].titel, MAX_TITEL_LAENGE - 1);
-     titelKopie[MAX_TITEL_LAENGE - 1] = '\0';
+     // Die Ausleihe entfernen und die Rückgabe im Ausleihjournal speichern
+     if (!rueckgabeBuchen(aktuellerLeser, schluessel)) {
+         return 0;
+     }
+
+     printf("Buch '%s' erfolgreich zurückgegeben.\n", titel);
+     return 1;
+ }
 
-     // Die Ausleihe an der gefundenen Position durch die letzte Ausleihe ersetzen
-     if (index < anzahlAusleihen - 1) {
-         ausleihen[index] = ausleihen[anzahlAusleihen - 1];
+ /**
+  * Wechselt das Ausleihkonto, für das ausgeliehen, zurückgegeben und angezeigt wird
+  * @param nummer Lesernummer als Text (Dezimalzahl)
+  * @return 1 bei Erfolg, 0 bei ungültiger Lesernummer
+  */
+ int leserWechseln(const char* nummer) {
+     char* ende;
+     errno = 0;
+     unsigned long long leser = strtoull(nummer, &ende, 10);
+     if (ende == nummer || *ende != '\0' || errno != 0 || nummer[0] == '-' || leser > UINT_MAX) {
+         printf("Fehler: Ungültige Lesernummer '%s'!\n", nummer);
+         return 0;
      }
 
-     // Anzahl der Ausleihen verringern
-     anzahlAusleihen--;
+     aktuellerLeser = (unsigned int)leser;
+     printf("Angemeldet als Leser %u.\n", aktuellerLeser);
+     return 1;
+ }
 
-     // Ausleihdaten speichern
-     ausleihenSpeichern();
+ /**
+  * Liest ein Datum im Format TT.MM.JJJJ
+  * @param text Das Datum als Text
+  * @param zeit Erhält den Beginn des Tages (0:00 Uhr Ortszeit)
+  * @return 1 bei Erfolg, 0 bei ungültigem Datum
+  */
+ int datumLesen(const char* text, time_t* zeit) {
+     int tag;
+     int monat;
+     int jahr;
+     char rest;
+     if (sscanf(text, "%d.%d.%d%c", &tag, &monat, &jahr, &rest) != 3) {
+         return 0;
+     }
 
-     printf("Buch '%s' erfolgreich zurückgegeben.\n", titelKopie);
+     struct tm datum;
+     memset(&datum, 0, sizeof(datum));
+     datum.tm_mday = tag;
+     datum.tm_mon = monat - 1;
+     datum.tm_year = jahr - 1900;
+     datum.tm_isdst = -1;
+     time_t ergebnis = mktime(&datum);
+     // mktime normalisiert z. B. den 31.02. zum 03.03.; solche Daten ablehnen
+     if (ergebnis == (time_t)-1 || datum.tm_mday != tag || datum.tm_mon != monat - 1 || datum.tm_year != jahr - 1900) {
+         return 0;
+     }
+     *zeit = ergebnis;
      return 1;
  }
 
+ /**
+  * Gibt die Mahnliste aus: alle zum Stichtag überfälligen Ausleihen aller Leser,
+  * die am längsten überfällige zuerst. Die Ausleihen werden über den
+  * Fälligkeits-Heap gefunden, ohne alle Ausleihen zu durchsuchen. Wie beim
+  * Ausleihkonto wird unter gruppenCommit.sperre gelesen.
+  * @param stichtag Zeitpunkt, zu dem die Fälligkeit überschritten sein muss
+  * @return Anzahl überfälliger Ausleihen oder -1 bei Speichermangel
+  */
+ int mahnlisteAusgeben(time_t stichtag) {
+     int* positionen;
+     pthread_mutex_lock(&gruppenCommit.sperre);
+     int anzahl = ueberfaelligeSuchen(stichtag, &positionen);
+     if (anzahl < 0) {
+         pthread_mutex_unlock(&gruppenCommit.sperre);
+         printf("Fehler: Zu wenig Speicher für die Mahnliste!\n");
+         return -1;
+     }
+
+     char datumText[32];
+     strftime(datumText, sizeof(datumText), "%d.%m.%Y %H:%M", localtime(&stichtag));
+     printf("\n=== Mahnliste zum %s ===\n", datumText);
+     printf("Überfällige Ausleihen: %d von %d\n\n", anzahl, anzahlAusleihen);
+
+     if (anzahl == 0) {
+         printf("Keine Ausleihe ist überfällig.\n");
+         int naechste = naechsteFaelligkeit();
+         if (naechste >= 0) {
+             char isbnText[LEN_ISBN];
+             time_t faellig = ausleiheFaelligkeit(&ausleihen[naechste]);
+             isbnFormatieren(ausleihen[naechste].isbn, isbnText);
+             strftime(datumText, sizeof(datumText), "%d.%m.%Y %H:%M", localtime(&faellig));
+             printf("Nächste Fälligkeit: %s (Leser %u) am %s\n", isbnText, ausleihen[naechste].leser, datumText);
+         }
+     } else {
+         printf("%-10s %-14s %-50s %s\n", "Leser", "ISBN", "Titel", "Überfällig");
+         printf("--------------------------------------------------------------------------------------------\n");
+
+         for (int i = 0; i < anzahl; i++) {
+             Ausleihe* ausleihe = &ausleihen[positionen[i]];
+             int tage = (int)(difftime(stichtag, ausleiheFaelligkeit(ausleihe)) / (60 * 60 * 24));
+             char isbnText[LEN_ISBN];
+             isbnFormatieren(ausleihe->isbn, isbnText);
+             printf("%-10u %-14s %-50s seit %d Tagen\n", ausleihe->leser, isbnText, ausleiheTitel(ausleihe), tage);
+         }
+     }
+
+     printf("\n======================\n");
+     pthread_mutex_unlock(&gruppenCommit.sperre);
+
+     free(positionen);
+     return anzahl;
+ }
+
  /**
   * Löscht den Eingabepuffer
   */
@@ -605,9 +5425,11 @@ void baumFreigeben(Buch* node) {
      printf("3. Buch ausleihen\n");
      printf("4. Buch zurückgeben\n");
      printf("5. Ausleihkonto anzeigen\n");
-     printf("6. Programm beenden\n");
+     printf("6. Leserkonto wechseln\n");
+     printf("7. Mahnliste (überfällige Ausleihen aller Leser)\n");
+     printf("8. Programm beenden\n");
      printf("==========================================\n");
-     printf("Bitte wählen Sie eine Option (1-6): ");
+     printf("Bitte wählen Sie eine Option (1-8): ");
 
      scanf("%d", &auswahl);
      eingabePufferLeeren();
@@ -615,12 +5437,30 @@ void baumFreigeben(Buch* node) {
      return auswahl;
  }
 
- #endif /* Endet den Bereich der im Testmodus auskommentiert wird */
+ #ifndef TEST_MODE
 
  /**
-  * Hauptfunktion des Programms
+  * Hauptfunktion des Programms. Mit "mahnliste [TT.MM.JJJJ]" wird ohne Menü nur
+  * die Mahnliste zum angegebenen Tag (sonst zum aktuellen Zeitpunkt) ausgegeben,
+  * z. B. für einen nächtlichen Lauf.
+  * @return 0 bei Erfolg, 1 bei fehlerhaftem Aufruf der Mahnliste
   */
- int main() {
+ int main(int argc, char* argv[]) {
+     // Stapelbetrieb: nur die Mahnliste ausgeben
+     if (argc > 1 && strcmp(argv[1], "mahnliste") == 0) {
+         time_t stichtag = time(NULL);
+         if (argc > 2 && !datumLesen(argv[2], &stichtag)) {
+             printf("Fehler: Ungültiges Datum '%s' (erwartet TT.MM.JJJJ)!\n", argv[2]);
+             return 1;
+         }
+         init();
+         int anzahl = mahnlisteAusgeben(stichtag);
+         suchPoolBeenden();
+         katalogFreigeben();
+         ausleihenFreigeben();
+         return anzahl < 0 ? 1 : 0;
+     }
+
      // Initialisierung
      init();
 
@@ -639,7 +5479,7 @@ void baumFreigeben(Buch* node) {
                  // Newline am Ende entfernen
                  eingabe[strcspn(eingabe, "\n")] = 0;
 
-                 nachTitelSuchen(eingabe, results, MAXRESULTS);
+                 nachTitelSuchenSeitenweise(eingabe);
 
                  // Warten auf Benutzer, bevor es weitergeht
                  printf("\nDrücken Sie Enter, um fortzufahren...");
@@ -693,21 +5533,56 @@ void baumFreigeben(Buch* node) {
                  getchar();
                  break;
 
-             case 6: // Programm beenden
+             case 6: // Leserkonto wechseln
+                 printf("\nBitte geben Sie Ihre Lesernummer ein: ");
+                 fgets(eingabe, sizeof(eingabe), stdin);
+                 // Newline am Ende entfernen
+                 eingabe[strcspn(eingabe, "\n")] = 0;
+
+                 leserWechseln(eingabe);
+
+                 // Warten auf Benutzer, bevor es weitergeht
+                 printf("\nDrücken Sie Enter, um fortzufahren...");
+                 getchar();
+                 break;
+
+             case 7: { // Mahnliste
+                 printf("\nBitte geben Sie den Stichtag ein (TT.MM.JJJJ, leer für jetzt): ");
+                 fgets(eingabe, sizeof(eingabe), stdin);
+                 // Newline am Ende entfernen
+                 eingabe[strcspn(eingabe, "\n")] = 0;
+
+                 time_t stichtag = time(NULL);
+                 if (eingabe[0] != '\0' && !datumLesen(eingabe, &stichtag)) {
+                     printf("Fehler: Ungültiges Datum '%s'!\n", eingabe);
+                 } else {
+                     mahnlisteAusgeben(stichtag);
+                 }
+
+                 // Warten auf Benutzer, bevor es weitergeht
+                 printf("\nDrücken Sie Enter, um fortzufahren...");
+                 getchar();
+                 break;
+             }
+
+             case 8: // Programm beenden
                  printf("\nVielen Dank für die Nutzung der Bibliotheksverwaltung. Auf Wiedersehen!\n");
                  break;
 
              default:
-                 printf("\nUngültige Eingabe. Bitte wählen Sie eine Option zwischen 1 und 6.\n");
+                 printf("\nUngültige Eingabe. Bitte wählen Sie eine Option zwischen 1 und 8.\n");
                  printf("\nDrücken Sie Enter, um fortzufahren...");
                  getchar();
          }
 
-     } while (auswahl != 6);
+     } while (auswahl != 8);
 
     // Speicher freigeben
-    baumFreigeben(wurzel);
-    wurzel = NULL;
+    suchPoolBeenden();
+    katalogFreigeben();
+    ausleihenFreigeben();
 
      return 0;
- }
\ No newline at end of file
+ }
+
+ #endif /* Endet den Bereich der im Testmodus auskommentiert wird */
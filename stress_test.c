@@ -0,0 +1,111 @@
+/**
+ * stress_test.c
+ * Stresstest für die Baumoperationen der Bibliotheksverwaltung
+ *
+ * Baut einen Katalog aus sehr vielen sortiert eingefügten ISBNs auf, durchsucht
+ * ihn und gibt ihn wieder frei. Zusätzlich werden dieselben Knoten zu einer
+ * entarteten Liste verkettet, um zu prüfen, dass keine Suche rekursiv arbeitet
+ * und damit den Aufrufstapel sprengen kann.
+ *
+ * Aufruf: ./library_stress [anzahl]   (Standard: 5000000 Bücher)
+ */
+
+#define TEST_MODE
+#include "main.c"
+
+#define STRESS_ANZAHL 5000000
+
+/**
+ * Erzeugt den Schlüssel der ISBN Nummer i. Der Baum prüft keine Prüfziffern
+ * und führt ISBNs als Zahl (uint64_t), daher genügt die Nummer selbst.
+ */
+uint64_t stressIsbn(long i) {
+    return (uint64_t)i;
+}
+
+/**
+ * Prüft Suche nach ISBN und Titel auf einem (Teil-)Baum
+ * @return 1 wenn alle Prüfungen erfolgreich waren, sonst 0
+ */
+int baumPruefen(Buch* baum, long anzahl) {
+    char isbn[LEN_ISBN];
+    char isbnListe[MAXRESULTS][LEN_ISBN];
+
+    // Erste, mittlere und letzte ISBN müssen gefunden werden
+    long stichproben[] = { 0, anzahl / 2, anzahl - 1 };
+    for (int i = 0; i < 3; i++) {
+        if (buchNachIsbnSuchen(baum, stressIsbn(stichproben[i])) == NULL) {
+            printf("FEHLER: ISBN Nummer %ld nicht gefunden!\n", stichproben[i]);
+            return 0;
+        }
+    }
+
+    // Eine nicht vorhandene ISBN darf nicht gefunden werden
+    if (buchNachIsbnSuchen(baum, stressIsbn(anzahl)) != NULL) {
+        printf("FEHLER: Nicht vorhandene ISBN Nummer %ld gefunden!\n", anzahl);
+        return 0;
+    }
+
+    // Die Titelsuche nach dem letzten Buch muss den gesamten Baum durchlaufen
+    char titel[64];
+    snprintf(titel, sizeof(titel), "Band %ld.", anzahl - 1);
+    int gefunden = büchernachTitelSuchenIterativ(baum, titel, isbnListe, MAXRESULTS);
+    isbnFormatieren(stressIsbn(anzahl - 1), isbn);
+    if (gefunden != 1 || strcmp(isbnListe[0], isbn) != 0) {
+        printf("FEHLER: Titelsuche nach '%s' lieferte %d Treffer!\n", titel, gefunden);
+        return 0;
+    }
+
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    long anzahl = argc > 1 ? atol(argv[1]) : STRESS_ANZAHL;
+    if (anzahl < 1) {
+        anzahl = STRESS_ANZAHL;
+    }
+
+    printf("\n--- Stresstest mit %ld Büchern ---\n\n", anzahl);
+
+    // 1. Sortiert einfügen (schlechtester Fall für einen unbalancierten Baum)
+    printf("1. %ld ISBNs sortiert einfügen\n", anzahl);
+    char titel[64];
+    for (long i = 0; i < anzahl; i++) {
+        snprintf(titel, sizeof(titel), "Stresstest Band %ld.", i);
+        wurzel = buchEinfuegen(wurzel, stressIsbn(i), titel);
+    }
+    printf("   Baumhöhe: %d\n", knotenHoehe(wurzel));
+
+    printf("2. Ausbalancierten Baum durchsuchen\n");
+    if (!baumPruefen(wurzel, anzahl)) {
+        return 1;
+    }
+
+    // 3. Knoten in ISBN-Reihenfolge zu einer Liste über die linken Zeiger verketten
+    printf("3. Baum zu einer entarteten Liste umbauen\n");
+    Buch** knoten = (Buch**)malloc(anzahl * sizeof(Buch*));
+    if (knoten == NULL) {
+        printf("FEHLER: Zu wenig Speicher!\n");
+        return 1;
+    }
+    for (long i = 0; i < anzahl; i++) {
+        knoten[i] = buchNachIsbnSuchen(wurzel, stressIsbn(i));
+    }
+    for (long i = 0; i < anzahl; i++) {
+        knoten[i]->links = i > 0 ? knoten[i - 1]->nummer : KEIN_KNOTEN;
+        knoten[i]->rechts = KEIN_KNOTEN;
+    }
+    wurzel = knoten[anzahl - 1];
+    free(knoten);
+
+    printf("4. Entartete Liste durchsuchen\n");
+    if (!baumPruefen(wurzel, anzahl)) {
+        return 1;
+    }
+
+    printf("5. Katalog freigeben\n");
+    katalogFreigeben();
+
+    printf("\n--- Stresstest erfolgreich ---\n\n");
+    return 0;
+}
@@ -1,679 +1,1356 @@
 /**
- * main.c
- * Hauptprogramm für die Bibliotheksverwaltung mit Benutzerinteraktion
- * (Enthält alle Funktionen, die zuvor auf bibliothek.h und bibliothek.c aufgeteilt waren)
- * 
- * Bei der Kompilierung für Tests wird die main-Funktion durch die Definition des
- * Makros TEST_MODE auskommentiert, damit die test.c ihre eigene main-Funktion verwenden kann.
+ * test_standalone.c
+ * Testprogramm für die Bibliotheksverwaltung
+ *
+ * Bindet main.c mit gesetztem TEST_MODE ein, sodass die Tests die Funktionen
+ * des Hauptprogramms verwenden und nur die main-Funktion ersetzt wird.
  */
 
- #include <stdio.h>
- #include <stdlib.h>
- #include <string.h>
- #include <ctype.h>
- #include <time.h>
-
- /* Konstanten */
- #define LEN_ISBN 14          // Maximale Länge einer ISBN
- #define MAXRESULTS 10        // Maximale Anzahl von Suchergebnissen
- #define MAX_TITEL_LAENGE 256 // Maximale Länge eines Buchtitels
- #define MAX_AUSLEIHEN 100    // Maximale Anzahl von ausgeliehenen Büchern
- #define AUSLEIHDAUER 28      // Ausleihdauer in Tagen
- #define CSV_DATEI "attached_assets/books.csv" // Pfad zur CSV-Datei
- #define AUSLEIHDATEI "ausleihen.txt"          // Datei zum Speichern der Ausleihvorgänge
-
- /* Datenstrukturen */
-
- // Struktur für ein Buch
- typedef struct Buch {
-     char isbn[LEN_ISBN];        // ISBN des Buches
-     char titel[MAX_TITEL_LAENGE]; // Titel des Buches
-     struct Buch* links;         // Zeiger auf linken Teilbaum (kleinere ISBN)
-     struct Buch* rechts;        // Zeiger auf rechten Teilbaum (größere ISBN)
- } Buch;
-
- // Struktur für ein ausgeliehenes Buch
- typedef struct Ausleihe {
-     char isbn[LEN_ISBN];          // ISBN des ausgeliehenen Buches
-     char titel[MAX_TITEL_LAENGE]; // Titel des ausgeliehenen Buches
-     time_t ausleihDatum;         // Datum der Ausleihe
- } Ausleihe;
-
- /* Globale Variablen */
- Buch* wurzel = NULL;                // Wurzel des Binärbaums
- Ausleihe ausleihen[MAX_AUSLEIHEN];  // Array der ausgeliehenen Bücher
- int anzahlAusleihen = 0;            // Anzahl der aktuellen Ausleihen
-
- /* Funktionen */
- void init();
- void nachTitelSuchen(char* titel, char isbnListe[][LEN_ISBN], int maxResults);
- void nachIsbnSuchen(char* isbn, char isbnListe[][LEN_ISBN], int maxResults);
- int buchAusleihen(char* isbn);
- int kontoAnzeigen();
- int buchZurueckgeben(char* isbn);
-
- /* Hilfsfunktionen */
- Buch* neuesBuchErstellen(const char* isbn, const char* titel);
- Buch* buchEinfuegen(Buch* wurzelKnoten, const char* isbn, const char* titel);
- Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, const char* isbn);
- void zuKleinbuchstaben(char* str);
- int enthältTeilstring(const char* quelle, const char* teilstring);
- int büchernachTitelSuchenRekursiv(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults, int aktuelleAnzahl);
- void csvDateiEinlesen();
- void ausleihenLaden();
- void ausleihenSpeichern();
- void eingabePufferLeeren();
- int menüAnzeigen();
- void baumFreigeben(Buch* node);
-
- #ifndef TEST_MODE
-
- /* Hilfsfunktionen für Binärbaum-Operationen */
+ #define TEST_MODE
+ #include "main.c"
 
  /**
-  * Erstellt ein neues Buch mit den gegebenen Daten
-  * @param isbn ISBN des Buches
-  * @param titel Titel des Buches
-  * @return Zeiger auf das neue Buch oder NULL bei Fehler
+  * Prüft rekursiv Sortierung und AVL-Bedingung eines Teilbaums
+  * @param knoten Wurzel des Teilbaums
+  * @param anzahl Wird um die Anzahl der geprüften Knoten erhöht
+  * @return Höhe des Teilbaums oder -1, wenn eine Bedingung verletzt ist
   */
- Buch* neuesBuchErstellen(const char* isbn, const char* titel) {
-     // Speicher für das neue Buch reservieren
-     Buch* neuesBuch = (Buch*)malloc(sizeof(Buch));
-
-     // Prüfen, ob die Speicherreservierung erfolgreich war
-     if (neuesBuch == NULL) {
-         printf("Fehler bei der Speicherreservierung!\n");
-         return NULL;
+ int avlBaumPruefen(Buch* knoten, int* anzahl) {
+     if (knoten == NULL) {
+         return 0;
      }
 
-     // Daten in das neue Buch kopieren
-     strncpy(neuesBuch->isbn, isbn, LEN_ISBN - 1);
-     neuesBuch->isbn[LEN_ISBN - 1] = '\0'; // Sicherstellen, dass die ISBN nullterminiert ist
-
-     strncpy(neuesBuch->titel, titel, MAX_TITEL_LAENGE - 1);
-     neuesBuch->titel[MAX_TITEL_LAENGE - 1] = '\0'; // Sicherstellen, dass der Titel nullterminiert ist
+     Buch* linkerKnoten = knotenZeiger(knoten->links);
+     Buch* rechterKnoten = knotenZeiger(knoten->rechts);
+     int hoeheLinks = avlBaumPruefen(linkerKnoten, anzahl);
+     int hoeheRechts = avlBaumPruefen(rechterKnoten, anzahl);
+     if (hoeheLinks < 0 || hoeheRechts < 0 || abs(hoeheLinks - hoeheRechts) > 1) {
+         return -1;
+     }
+     if ((linkerKnoten != NULL && linkerKnoten->isbn >= knoten->isbn) ||
+         (rechterKnoten != NULL && rechterKnoten->isbn <= knoten->isbn)) {
+         return -1;
+     }
 
-     // Teilbäume initialisieren
-     neuesBuch->links = NULL;
-     neuesBuch->rechts = NULL;
+     int hoehe = 1 + (hoeheLinks > hoeheRechts ? hoeheLinks : hoeheRechts);
+     if (hoehe != knoten->hoehe) {
+         return -1;
+     }
 
-     return neuesBuch;
+     (*anzahl)++;
+     return hoehe;
  }
 
  /**
-  * Fügt ein Buch in den Binärbaum ein
-  * @param wurzelKnoten Zeiger auf die Wurzel des Baums
-  * @param isbn ISBN des einzufügenden Buches
-  * @param titel Titel des einzufügenden Buches
-  * @return Zeiger auf die (möglicherweise neue) Wurzel des Baums
+  * Prüfsumme (FNV-1a) über alle ISBNs und Titel des Titel-Index in ISBN-Reihenfolge
   */
- Buch* buchEinfuegen(Buch* wurzelKnoten, const char* isbn, const char* titel) {
-     // Wenn der Baum leer ist, neues Buch als Wurzel einfügen
-     if (wurzelKnoten == NULL) {
-         return neuesBuchErstellen(isbn, titel);
-     }
-
-     // Vergleichen der ISBNs, um die richtige Position im Baum zu finden
-     int vergleich = strcmp(isbn, wurzelKnoten->isbn);
-
-     // Wenn die ISBN kleiner ist, im linken Teilbaum einfügen
-     if (vergleich < 0) {
-         wurzelKnoten->links = buchEinfuegen(wurzelKnoten->links, isbn, titel);
-     }
-     // Wenn die ISBN größer ist, im rechten Teilbaum einfügen
-     else if (vergleich > 0) {
-         wurzelKnoten->rechts = buchEinfuegen(wurzelKnoten->rechts, isbn, titel);
+ unsigned long katalogPruefsumme() {
+     unsigned long pruefsumme = 14695981039346656037UL;
+     for (unsigned int i = 0; i < titelIndex.anzahlBuecher; i++) {
+         char isbn[LEN_ISBN];
+         isbnFormatieren(titelIndex.buecher[i]->isbn, isbn);
+         const char* teile[] = { isbn, buchTitel(titelIndex.buecher[i]) };
+         for (int k = 0; k < 2; k++) {
+             for (const char* c = teile[k]; ; c++) {
+                 pruefsumme = (pruefsumme ^ (unsigned char)*c) * 1099511628211UL;
+                 if (*c == '\0') {
+                     break;
+                 }
+             }
+         }
      }
-     // Wenn die ISBN bereits existiert, nichts tun (Duplikate vermeiden)
-     // Alternativ könnte man hier den Titel aktualisieren, falls sich dieser geändert hat
-
-     return wurzelKnoten;
+     return pruefsumme;
  }
 
  /**
- * Gibt den Speicher des Binärbaums rekursiv frei
- */
-void baumFreigeben(Buch* node) {
-    if (node != NULL) {
-        baumFreigeben(node->links);
-        baumFreigeben(node->rechts);
-        free(node);
-    }
-}
+  * Erzeugt die gültige ISBN-13 978-000-nummer mit passender Prüfziffer
+  * @param nummer Laufende Nummer (höchstens 9 Stellen)
+  * @return Die ISBN als Zahl
+  */
+ uint64_t testIsbn(unsigned long nummer) {
+     uint64_t ersteZwoelf = 978000000000ULL + nummer;
+     return ersteZwoelf * 10 + (uint64_t)isbn13Pruefziffer(ersteZwoelf);
+ }
+
+ #define GRUPPEN_TEST_THREADS 8     // Threads im Group-Commit-Test
+ #define GRUPPEN_TEST_AUSLEIHEN 200 // Ausleihen je Thread im Group-Commit-Test
+ #define LESER_TEST_LESER 40        // Leser im Test der Leserkonten
+ #define LESER_TEST_ISBNS 10        // Verschiedene ISBNs im Test der Leserkonten
 
  /**
-  * Sucht ein Buch im Binärbaum anhand der ISBN
-  * @param wurzelKnoten Wurzel des (Teil-)Baums, in dem gesucht wird
-  * @param isbn Zu suchende ISBN
-  * @return Zeiger auf das gefundene Buch oder NULL, wenn nicht gefunden
+  * Vergleicht die ersten Ausleihen feldweise mit einem gesicherten Stand
+  * (memcmp ginge fehl, da die Füllbytes von Ausleihe nicht festgelegt sind)
+  * @param stand Gesicherter Stand
+  * @param anzahl Anzahl der zu vergleichenden Ausleihen
+  * @return 1 wenn sie übereinstimmen, sonst 0
   */
- Buch* buchNachIsbnSuchen(Buch* wurzelKnoten, const char* isbn) {
-     // Wenn der Baum leer ist oder wir am Ende eines Pfades sind, Buch nicht gefunden
-     if (wurzelKnoten == NULL) {
-         return NULL;
+ int ausleihenGleich(const Ausleihe* stand, int anzahl) {
+     for (int i = 0; i < anzahl; i++) {
+         if (ausleihen[i].isbn != stand[i].isbn || ausleihen[i].ausleihDatum != stand[i].ausleihDatum ||
+             ausleihen[i].leser != stand[i].leser) {
+             return 0;
+         }
      }
+     return 1;
+ }
 
-     // ISBNs vergleichen
-     int vergleich = strcmp(isbn, wurzelKnoten->isbn);
-
-     // Wenn die gesuchte ISBN kleiner ist, im linken Teilbaum suchen
-     if (vergleich < 0) {
-         return buchNachIsbnSuchen(wurzelKnoten->links, isbn);
+ /**
+  * Thread für den Group-Commit-Test: Leiht GRUPPEN_TEST_AUSLEIHEN eigene Bücher
+  * unter seiner Nummer als Leser aus und gibt die erste Hälfte davon wieder zurück
+  * @param argument Zeiger auf die Nummer des Threads; erhält 1 bei Erfolg, sonst 0
+  */
+ void* gruppenTestThread(void* argument) {
+     int* nummer = (int*)argument;
+     int ok = 1;
+     for (int i = 0; i < GRUPPEN_TEST_AUSLEIHEN; i++) {
+         ok &= ausleiheAnlegen(testIsbn((unsigned long)(10000 + *nummer * 1000 + i)), 1700000000 + i, (unsigned int)*nummer);
      }
-     // Wenn die gesuchte ISBN größer ist, im rechten Teilbaum suchen
-     else if (vergleich > 0) {
-         return buchNachIsbnSuchen(wurzelKnoten->rechts, isbn);
+     for (int i = 0; i < GRUPPEN_TEST_AUSLEIHEN / 2; i++) {
+         ok &= rueckgabeBuchen((unsigned int)*nummer, testIsbn((unsigned long)(10000 + *nummer * 1000 + i)));
      }
-     // Wenn die ISBNs übereinstimmen, Buch gefunden
-     else {
-         return wurzelKnoten;
+     *nummer = ok;
+     return NULL;
+ }
+
+ /**
+  * Leitet die Standardausgabe in eine Datei um, um sie danach zu prüfen
+  * @param pfad Pfad der Datei (wird überschrieben)
+  * @return Gesicherte Standardausgabe für ausgabeWiederherstellen
+  */
+ int ausgabeUmleiten(const char* pfad) {
+     fflush(stdout);
+     int gesichert = dup(STDOUT_FILENO);
+     int datei = open(pfad, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+     if (datei >= 0) {
+         dup2(datei, STDOUT_FILENO);
+         close(datei);
      }
+     return gesichert;
+ }
+
+ /**
+  * Leitet die Standardausgabe nach /dev/null um (für Schleifen, deren Hinweise
+  * die Testausgabe überfluten würden)
+  * @return Gesicherte Standardausgabe für ausgabeWiederherstellen
+  */
+ int ausgabeUnterdruecken() {
+     return ausgabeUmleiten("/dev/null");
  }
 
  /**
-  * Konvertiert einen String zu Kleinbuchstaben
-  * @param str Der zu konvertierende String
+  * Stellt die mit ausgabeUnterdruecken umgeleitete Standardausgabe wieder her
+  * @param gesichert Rückgabewert von ausgabeUnterdruecken
   */
- void zuKleinbuchstaben(char* str) {
-     // Jeden Buchstaben zu Kleinbuchstaben konvertieren
-     for (int i = 0; str[i]; i++) {
-         str[i] = tolower(str[i]);
+ void ausgabeWiederherstellen(int gesichert) {
+     fflush(stdout);
+     if (gesichert >= 0) {
+         dup2(gesichert, STDOUT_FILENO);
+         close(gesichert);
      }
  }
 
  /**
-  * Prüft, ob ein Teilstring in einem String enthalten ist (case-insensitiv)
-  * @param quelle Der zu durchsuchende String
-  * @param teilstring Der zu suchende Teilstring
-  * @return 1 wenn der Teilstring gefunden wurde, sonst 0
+  * Prüft die Leserkonten gegen die erwarteten Ausleihen: Jede Kette des
+  * Leser-Index enthält genau die Ausleihen ihres Lesers, zusammen alle Ausleihen
+  * @param erwartet Erwartete Anzahl Ausleihen je Leser und ISBN (testIsbn(0..LESER_TEST_ISBNS-1))
+  * @param reihenfolge 1, wenn die Ketten nach Ausleihdatum aufsteigend sein müssen
+  * @return 1 wenn alle Konten stimmen, sonst 0
   */
- int enthältTeilstring(const char* quelle, const char* teilstring) {
-     // Wenn der Teilstring leer ist, geben wir true zurück - leerer Suchbegriff passt zu allem
-     if (teilstring == NULL || teilstring[0] == '\0') {
-         return 1;
+ int leserKontenPruefen(int erwartet[LESER_TEST_LESER][LESER_TEST_ISBNS], int reihenfolge) {
+     int gesamt = 0;
+     size_t leserMitAusleihen = 0;
+     for (unsigned int leser = 0; leser < LESER_TEST_LESER; leser++) {
+         int gezaehlt[LESER_TEST_ISBNS] = { 0 };
+         int anzahl = 0;
+         time_t vorher = 0;
+         for (int i = leserAusleiheErste(leser); i >= 0; i = leserAusleiheNaechste(i)) {
+             if (ausleihen[i].leser != leser || (reihenfolge && ausleihen[i].ausleihDatum < vorher)) {
+                 return 0;
+             }
+             int nummer = -1;
+             for (int j = 0; j < LESER_TEST_ISBNS; j++) {
+                 if (ausleihen[i].isbn == testIsbn((unsigned long)j)) {
+                     nummer = j;
+                 }
+             }
+             if (nummer < 0 || anzahl++ > anzahlAusleihen) {
+                 return 0;
+             }
+             gezaehlt[nummer]++;
+             vorher = ausleihen[i].ausleihDatum;
+         }
+         for (int j = 0; j < LESER_TEST_ISBNS; j++) {
+             if (gezaehlt[j] != erwartet[leser][j]) {
+                 return 0;
+             }
+         }
+         gesamt += anzahl;
+         leserMitAusleihen += anzahl > 0;
      }
+     return gesamt == anzahlAusleihen && leserIndex.anzahl == leserMitAusleihen;
+ }
 
-     // Wenn die Quelle leer ist, geben wir false zurück
-     if (quelle == NULL || quelle[0] == '\0') {
+ /**
+  * Prüft den Fälligkeits-Heap: enthält jede Ausleihe genau einmal, kein Platz
+  * ist früher fällig als sein Elternplatz, und platz verweist zurück
+  * @return 1 wenn der Heap stimmt, sonst 0
+  */
+ int faelligkeitenPruefen() {
+     if (faelligkeiten.anzahl != anzahlAusleihen) {
          return 0;
      }
-
-     // Kopien der Strings erstellen, um sie zu Kleinbuchstaben zu konvertieren
-     char quelleKlein[MAX_TITEL_LAENGE];
-     char teilstringKlein[MAX_TITEL_LAENGE];
-
-     // Strings kopieren
-     strncpy(quelleKlein, quelle, MAX_TITEL_LAENGE - 1);
-     quelleKlein[MAX_TITEL_LAENGE - 1] = '\0';
-
-     strncpy(teilstringKlein, teilstring, MAX_TITEL_LAENGE - 1);
-     teilstringKlein[MAX_TITEL_LAENGE - 1] = '\0';
-
-     // Zu Kleinbuchstaben konvertieren
-     zuKleinbuchstaben(quelleKlein);
-     zuKleinbuchstaben(teilstringKlein);
-
-     // Prüfen, ob der Teilstring in der Quelle enthalten ist
-     return strstr(quelleKlein, teilstringKlein) != NULL;
+     for (int platz = 0; platz < faelligkeiten.anzahl; platz++) {
+         int position = faelligkeiten.eintraege[platz];
+         if (position < 0 || position >= anzahlAusleihen || faelligkeiten.platz[position] != platz) {
+             return 0;
+         }
+         if (platz > 0 && faelligkeitFrueher(position, faelligkeiten.eintraege[(platz - 1) / 2])) {
+             return 0;
+         }
+     }
+     return 1;
  }
 
  /**
-  * Rekursive Suche nach Büchern mit einem bestimmten Titel (case-insensitiv)
-  * @param wurzelKnoten Wurzel des zu durchsuchenden (Teil-)Baums
-  * @param titel Zu suchender Titel (Teil des Titels)
-  * @param gefundeneISBNs Array, das die ISBNs der gefundenen Bücher aufnimmt
-  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
-  * @param aktuelleAnzahl Aktuelle Anzahl gefundener Bücher
-  * @return Aktualisierte Anzahl gefundener Bücher
+  * Vergleicht die überfälligen Ausleihen aus dem Fälligkeits-Heap mit dem
+  * Durchsuchen aller Ausleihen
+  * @param stichtag Zeitpunkt, zu dem die Fälligkeit überschritten sein muss
+  * @return Anzahl überfälliger Ausleihen oder -1, wenn das Ergebnis falsch ist
   */
- int büchernachTitelSuchenRekursiv(Buch* wurzelKnoten, const char* titel, char isbnListe[][LEN_ISBN], int maxResults, int aktuelleAnzahl) {
-     // Wenn der Baum leer ist oder die maximale Anzahl erreicht wurde, beenden
-     if (wurzelKnoten == NULL || aktuelleAnzahl >= maxResults) {
-         return aktuelleAnzahl;
+ int ueberfaelligePruefen(time_t stichtag) {
+     int erwartet = 0;
+     for (int i = 0; i < anzahlAusleihen; i++) {
+         erwartet += ausleiheFaelligkeit(&ausleihen[i]) < stichtag;
      }
 
-     // Zuerst im linken Teilbaum suchen
-     aktuelleAnzahl = büchernachTitelSuchenRekursiv(wurzelKnoten->links, titel, isbnListe, maxResults, aktuelleAnzahl);
-
-     // Prüfen, ob der aktuelle Knoten dem Suchkriterium entspricht
-     if (aktuelleAnzahl < maxResults && enthältTeilstring(wurzelKnoten->titel, titel)) {
-         // Wenn ja, ISBN in die Liste aufnehmen
-         strncpy(isbnListe[aktuelleAnzahl], wurzelKnoten->isbn, LEN_ISBN - 1);
-         isbnListe[aktuelleAnzahl][LEN_ISBN - 1] = '\0';
-         aktuelleAnzahl++;
+     int* positionen;
+     int anzahl = ueberfaelligeSuchen(stichtag, &positionen);
+     int ok = anzahl == erwartet;
+     for (int i = 0; ok && i < anzahl; i++) {
+         ok = positionen[i] >= 0 && positionen[i] < anzahlAusleihen &&
+              ausleiheFaelligkeit(&ausleihen[positionen[i]]) < stichtag &&
+              (i == 0 || faelligkeitVergleichen(&positionen[i - 1], &positionen[i]) < 0);
      }
-
-     // Dann im rechten Teilbaum suchen
-     aktuelleAnzahl = büchernachTitelSuchenRekursiv(wurzelKnoten->rechts, titel, isbnListe, maxResults, aktuelleAnzahl);
-
-     return aktuelleAnzahl;
+     free(positionen);
+     return ok ? anzahl : -1;
  }
 
  /**
-  * Liest die CSV-Datei ein und baut den Binärbaum auf
+  * Hauptfunktion des Programms
   */
- void csvDateiEinlesen() {
-     FILE* datei = fopen(CSV_DATEI, "r");
+ int main() {
+     init();
 
-     // Prüfen, ob die Datei geöffnet werden konnte
-     if (datei == NULL) {
-         printf("Fehler beim Öffnen der CSV-Datei: %s\n", CSV_DATEI);
-         return;
-     }
+     char results[MAXRESULTS][LEN_ISBN];
 
-     char zeile[1024];  // Puffer für eine Zeile aus der CSV-Datei
+     printf("\n\n--- Bibliothek Verwaltungssystem Test ---\n\n");
 
-     // Die erste Zeile (Header) überspringen
-     if (fgets(zeile, sizeof(zeile), datei) == NULL) {
-         printf("CSV-Datei ist leer oder fehlerhaft\n");
-         fclose(datei);
-         return;
-     }
+     // Ausleihkonto anzeigen
+     printf("1. Ausleihkonto anzeigen:\n");
+     kontoAnzeigen();
 
-     int anzahlBücher = 0; // Zähler für erfolgreiche Einträge
+     // Nach Titel suchen
+     printf("\n2. Nach Titel 'science' suchen:\n");
+     nachTitelSuchen("science", results, MAXRESULTS);
 
-     // Zeile für Zeile einlesen
-     while (fgets(zeile, sizeof(zeile), datei) != NULL) {
-         char isbn[LEN_ISBN] = "";
-         char titel[MAX_TITEL_LAENGE] = "";
+     // Wenn keine Bücher mit "science" gefunden, nach "fiction" suchen
+     if (results[0][0] == '\0') {
+         printf("\nAlternativ nach 'fiction' suchen:\n");
+         nachTitelSuchen("fiction", results, MAXRESULTS);
+     }
 
-         // CSV-Format verarbeiten: "isbn","titel",...
-         // Die ISBN ist das erste Feld, der Titel das zweite
+     // Wenn immer noch keine Bücher gefunden, nach leeren String suchen (alle Bücher)
+     if (results[0][0] == '\0') {
+         printf("\nZeige alle verfügbaren Bücher:\n");
+         nachTitelSuchen("", results, MAXRESULTS);
+     }
 
-         // Verbesserter CSV-Parser zur korrekten Extraktion der Felder
-         char* pos = zeile;
-         int feldNummer = 0;
-         int inAnführungszeichen = 0;
+     // Wenn Bücher gefunden wurden, zwei davon ausleihen
+     if (results[0][0] != '\0') {
+         printf("\n3. Bücher ausleihen:\n");
+         buchAusleihen(results[0]);
 
-         char tempFeld[MAX_TITEL_LAENGE] = ""; // Temporärer Puffer für das aktuelle Feld
-         int tempIndex = 0;
+         if (results[1][0] != '\0') {
+             buchAusleihen(results[1]);
+         }
 
-         // Zeichen für Zeichen verarbeiten
-         for (int i = 0; zeile[i] != '\0' && zeile[i] != '\n'; i++) {
-             char c = zeile[i];
+         // Ausleihkonto anzeigen
+         printf("\n4. Ausleihkonto nach dem Ausleihen:\n");
+         kontoAnzeigen();
 
-             if (c == '"') {
-                 // Anfang oder Ende von Anführungszeichen
-                 inAnführungszeichen = !inAnführungszeichen;
+         // Ein Buch zurückgeben
+         printf("\n5. Ein Buch zurückgeben:\n");
+         buchZurueckgeben(results[0]);
+
+         // Ausleihkonto nach Rückgabe anzeigen
+         printf("\n6. Ausleihkonto nach der Rückgabe:\n");
+         kontoAnzeigen();
+     }
 
-                 // Wenn Anführungszeichen geschlossen werden, feld könnte vollständig sein
-                 if (!inAnführungszeichen) {
-                     tempFeld[tempIndex] = '\0';
+     // Balance des Katalogbaums prüfen
+     printf("\n7. AVL-Bedingung des Katalogbaums prüfen:\n");
+     int anzahlKnoten = 0;
+     int hoehe = avlBaumPruefen(wurzel, &anzahlKnoten);
+     if (hoehe < 0) {
+         printf("FEHLER: Der Katalogbaum ist nicht ausbalanciert oder falsch sortiert!\n");
+         return 1;
+     }
+     printf("%d Bücher, Baumhöhe %d\n", anzahlKnoten, hoehe);
+
+     // Titelsuche über den Trigramm-Index mit der vollständigen Traversierung vergleichen
+     printf("\n8. Titelsuche mit Trigramm-Index gegen Baumtraversierung prüfen:\n");
+     const char* suchbegriffe[] = { "science", "SCIENCE", "Harry Potter", "the", "öl", "e d", "xyzzy", "de l'" };
+     for (int i = 0; i < (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0])); i++) {
+         char erwartet[MAXRESULTS][LEN_ISBN];
+         char mitIndex[MAXRESULTS][LEN_ISBN];
+         int anzahlErwartet = büchernachTitelSuchenIterativ(wurzel, suchbegriffe[i], erwartet, MAXRESULTS);
+         int anzahlIndex = trigrammTitelSuchen(suchbegriffe[i], mitIndex, MAXRESULTS);
+         if (anzahlIndex < 0) {
+             anzahlIndex = büchernachTitelSuchenIterativ(wurzel, suchbegriffe[i], mitIndex, MAXRESULTS);
+         }
 
-                     if (feldNummer == 0) {
-                         // ISBN speichern
-                         strncpy(isbn, tempFeld, LEN_ISBN - 1);
-                         isbn[LEN_ISBN - 1] = '\0';
-                     } else if (feldNummer == 1) {
-                         // Titel speichern
-                         strncpy(titel, tempFeld, MAX_TITEL_LAENGE - 1);
-                         titel[MAX_TITEL_LAENGE - 1] = '\0';
+         int gleich = anzahlErwartet == anzahlIndex;
+         for (int j = 0; gleich && j < anzahlErwartet; j++) {
+             gleich = strcmp(erwartet[j], mitIndex[j]) == 0;
+         }
+         printf("'%s': %d Treffer %s\n", suchbegriffe[i], anzahlIndex, gleich ? "(identisch)" : "");
+         if (!gleich) {
+             printf("FEHLER: Der Trigramm-Index liefert andere Treffer als die Traversierung!\n");
+             return 1;
+         }
+     }
 
-                         // Nach dem Titel können wir aufhören, wir benötigen keine weiteren Felder
-                         break;
-                     }
+     printf("\n9. Vektorisierte Suche im flachen Titelpuffer prüfen:\n");
+     const char* flachBegriffe[] = { "", "a", "science", "SCIENCE", "Harry Potter", "the", "öl", "e d", "xyzzy", "de l'", "Z" };
+     const char* stufenNamen[] = { "skalar", "SSE2", "AVX2" };
+     SimdStufe hoechsteStufe = simdStufeErmitteln();
+     for (int stufe = SIMD_SKALAR; stufe <= (int)hoechsteStufe; stufe++) {
+         simdStufeSetzen((SimdStufe)stufe);
+         for (int i = 0; i < (int)(sizeof(flachBegriffe) / sizeof(flachBegriffe[0])); i++) {
+             char erwartet[MAXRESULTS][LEN_ISBN];
+             char flach[MAXRESULTS][LEN_ISBN];
+             int anzahlErwartet = büchernachTitelSuchenIterativ(wurzel, flachBegriffe[i], erwartet, MAXRESULTS);
+             int anzahlFlach = flachTitelSuchen(flachBegriffe[i], flach, MAXRESULTS);
+
+             int gleich = anzahlErwartet == anzahlFlach;
+             for (int j = 0; gleich && j < anzahlErwartet; j++) {
+                 gleich = strcmp(erwartet[j], flach[j]) == 0;
+             }
+             if (!gleich) {
+                 printf("FEHLER: Flache Suche (%s) nach '%s' liefert andere Treffer als die Traversierung!\n",
+                        stufenNamen[stufe], flachBegriffe[i]);
+                 return 1;
+             }
+         }
 
-                     // Nächstes Feld vorbereiten
-                     feldNummer++;
-                     tempIndex = 0;
-                     tempFeld[0] = '\0';
+         // Treffer an jeder Position relativ zu den Blockgrenzen der Suchkerne
+         Suchmuster muster;
+         musterVorbereiten(&muster, "AbC");
+         char puffer[100];
+         for (size_t position = 0; position + 3 <= sizeof(puffer); position++) {
+             memset(puffer, 'x', sizeof(puffer));
+             memcpy(puffer + position, "aBc", 3);
+             if (musterFindenVektor(&muster, puffer, sizeof(puffer)) != position) {
+                 printf("FEHLER: Suchkern %s findet Treffer an Position %zu nicht!\n", stufenNamen[stufe], position);
+                 return 1;
+             }
+         }
+         printf("Suchkern %s: identisch\n", stufenNamen[stufe]);
+     }
+     simdStufeSetzen(hoechsteStufe);
+
+     printf("\n10. Parallele Titelsuche gegen serielle Suche prüfen:\n");
+     int threadAnzahlen[] = { 1, 2, 3, 4, 8, 16 };
+     int maxResultsWerte[] = { 1, 3, MAXRESULTS };
+     for (int t = 0; t < (int)(sizeof(threadAnzahlen) / sizeof(threadAnzahlen[0])); t++) {
+         suchThreadsSetzen(threadAnzahlen[t]);
+         for (int m = 0; m < (int)(sizeof(maxResultsWerte) / sizeof(maxResultsWerte[0])); m++) {
+             for (int i = 0; i < (int)(sizeof(flachBegriffe) / sizeof(flachBegriffe[0])); i++) {
+                 char erwartet[MAXRESULTS][LEN_ISBN];
+                 char parallel[MAXRESULTS][LEN_ISBN];
+                 int anzahlErwartet = büchernachTitelSuchenIterativ(wurzel, flachBegriffe[i], erwartet, maxResultsWerte[m]);
+                 int anzahlParallel = flachTitelSuchen(flachBegriffe[i], parallel, maxResultsWerte[m]);
+
+                 int gleich = anzahlErwartet == anzahlParallel;
+                 for (int j = 0; gleich && j < anzahlErwartet; j++) {
+                     gleich = strcmp(erwartet[j], parallel[j]) == 0;
                  }
-             } else if (inAnführungszeichen) {
-                 // Zeichen innerhalb von Anführungszeichen zum temporären Feld hinzufügen
-                 if (tempIndex < MAX_TITEL_LAENGE - 1) {
-                     tempFeld[tempIndex++] = c;
+                 if (!gleich) {
+                     printf("FEHLER: Parallele Suche (%d Threads, %d Ergebnisse) nach '%s' weicht ab!\n",
+                            threadAnzahlen[t], maxResultsWerte[m], flachBegriffe[i]);
+                     return 1;
                  }
              }
          }
-
-         // Buch in den Binärbaum einfügen, wenn ISBN und Titel nicht leer sind
-         if (strlen(isbn) > 0 && strlen(titel) > 0) {
-             wurzel = buchEinfuegen(wurzel, isbn, titel);
-             anzahlBücher++;
+         printf("%d Threads: identisch\n", threadAnzahlen[t]);
+     }
+     suchPoolBeenden();
+
+     printf("\n11. Seitenweise Titelsuche gegen einmalige Suche prüfen:\n");
+     const char* seitenBegriffe[] = { "science", "a", "the", "xyzzy" };
+     const char* verfahren[] = { "Index", "Baum" };
+     for (int v = 0; v < 2; v++) {
+         // Beim zweiten Durchlauf ist der Index veraltet und der Baum wird durchlaufen
+         titelIndex.gueltig = v == 0;
+         for (int i = 0; i < (int)(sizeof(seitenBegriffe) / sizeof(seitenBegriffe[0])); i++) {
+             char erwartet[40][LEN_ISBN];
+             int anzahlErwartet = büchernachTitelSuchenIterativ(wurzel, seitenBegriffe[i], erwartet, 40);
+
+             TitelCursor cursor;
+             titelSucheStarten(&cursor, seitenBegriffe[i]);
+             Buch* seite[3];
+             int anzahl = 0;
+             int gleich = 1;
+             while (gleich && anzahl < 40) {
+                 int gefunden = titelSucheFortsetzen(&cursor, seite, 3);
+                 for (int j = 0; j < gefunden && anzahl < 40; j++, anzahl++) {
+                     char isbn[LEN_ISBN];
+                     isbnFormatieren(seite[j]->isbn, isbn);
+                     gleich = gleich && anzahl < anzahlErwartet && strcmp(isbn, erwartet[anzahl]) == 0;
+                 }
+                 if (gefunden < 3) {
+                     break;
+                 }
+             }
+             if (!gleich || anzahl != anzahlErwartet) {
+                 printf("FEHLER: Seitenweise Suche (%s) nach '%s' weicht ab!\n", verfahren[v], seitenBegriffe[i]);
+                 return 1;
+             }
          }
+         printf("%s: identisch\n", verfahren[v]);
      }
-
-     printf("Bibliotheksdaten geladen: %d Bücher eingelesen.\n", anzahlBücher);
-     fclose(datei);
- }
-
- /**
-  * Lädt die Ausleihdaten aus der Datei
-  */
- void ausleihenLaden() {
-     FILE* datei = fopen(AUSLEIHDATEI, "r");
-
-     // Wenn die Datei nicht existiert, gibt es noch keine Ausleihen
-     if (datei == NULL) {
-         return;
+     titelIndex.gueltig = 1;
+
+     printf("\n12. CSV-Sonderfälle einlesen (lange Zeilen, \"\", Zeilenumbrüche):\n");
+     katalogFreigeben();
+     const char* testDatei = "/tmp/library_test.csv";
+     FILE* csv = fopen(testDatei, "w");
+     if (csv == NULL) {
+         printf("FEHLER: Testdatei %s kann nicht angelegt werden!\n", testDatei);
+         return 1;
+     }
+     char langerTitel[3001];
+     for (int i = 0; i < 3000; i++) {
+         langerTitel[i] = (char)('a' + i % 26);
+     }
+     langerTitel[3000] = '\0';
+     char csvIsbn[6][LEN_ISBN];
+     for (int i = 0; i < 5; i++) {
+         isbnFormatieren(testIsbn((unsigned long)i + 1), csvIsbn[i]);
+     }
+     // Prüfziffer verfälscht: Der Datensatz wird übersprungen
+     isbnFormatieren(testIsbn(6) / 10 * 10 + (testIsbn(6) % 10 + 1) % 10, csvIsbn[5]);
+     fprintf(csv, "\"isbn\",\"title\",\"last_updated\"\n");
+     fprintf(csv, "\"%s\",\"%s\",\"1\"\n", csvIsbn[0], langerTitel);
+     fprintf(csv, "\"%s\",\"ein \"\"zitierter\"\" Titel\",\"2\"\n", csvIsbn[1]);
+     fprintf(csv, "\"%s\",\"zwei\nZeilen\",\"mit, \"\"Komma\"\"\nund Umbruch\",,\n", csvIsbn[2]);
+     fprintf(csv, "%s,ohne Anführungszeichen\r\n", csvIsbn[3]);
+     fprintf(csv, "\"\",\"ohne ISBN\"\n");
+     fprintf(csv, "\"%s\",\"falsche Prüfziffer\"\n", csvIsbn[5]);
+     fprintf(csv, "\"%s\",\"letzte Zeile ohne Umbruch\"", csvIsbn[4]);
+     fclose(csv);
+
+     // Mit mehreren Threads fallen Abschnittsgrenzen in Felder mit "" und Zeilenumbrüchen
+     const char* erwarteteTitel[] = { langerTitel, "ein \"zitierter\" Titel", "zwei\nZeilen",
+                                      "ohne Anführungszeichen", "letzte Zeile ohne Umbruch" };
+     int ladeThreads[] = { 1, 2, 3, 5, 8, 16, 64 };
+     for (int t = 0; t < (int)(sizeof(ladeThreads) / sizeof(ladeThreads[0])); t++) {
+         katalogFreigeben();
+         int eingelesen = csvDatenEinlesenParallel(testDatei, ladeThreads[t]);
+         if (eingelesen != 5) {
+             printf("FEHLER: %d statt 5 Bücher mit %d Threads eingelesen!\n", eingelesen, ladeThreads[t]);
+             return 1;
+         }
+         for (int i = 0; i < 5; i++) {
+             Buch* buch = buchNachIsbnSuchen(wurzel, testIsbn((unsigned long)i + 1));
+             if (buch == NULL || strcmp(buchTitel(buch), erwarteteTitel[i]) != 0) {
+                 printf("FEHLER: Buch %s fehlt oder hat mit %d Threads einen falschen Titel!\n", csvIsbn[i], ladeThreads[t]);
+                 return 1;
+             }
+         }
+     }
+     remove(testDatei);
+     printf("5 Bücher mit 1 bis 64 Threads korrekt eingelesen\n");
+
+     printf("\n13. books.csv mit mehreren Threads einlesen:\n");
+     unsigned long pruefsummeSeriell = 0;
+     for (int t = 0; t < (int)(sizeof(ladeThreads) / sizeof(ladeThreads[0])); t++) {
+         katalogFreigeben();
+         int eingelesen = csvDatenEinlesenParallel(CSV_DATEI, ladeThreads[t]);
+         titelIndexAufbauen();
+
+         unsigned long pruefsumme = katalogPruefsumme();
+         if (t == 0) {
+             pruefsummeSeriell = pruefsumme;
+         }
+         printf("%d Threads: %d Zeilen, %u Bücher, Prüfsumme %016lx\n", ladeThreads[t], eingelesen,
+                titelIndex.anzahlBuecher, pruefsumme);
+         if (pruefsumme != pruefsummeSeriell) {
+             printf("FEHLER: Der parallel eingelesene Katalog weicht vom seriellen ab!\n");
+             return 1;
+         }
      }
 
-     // Ausleihen einlesen
-     anzahlAusleihen = 0;
-
-     while (anzahlAusleihen < MAX_AUSLEIHEN && 
-             fscanf(datei, "%13s\n", ausleihen[anzahlAusleihen].isbn) == 1) {
+     printf("\n14. Katalog aus sortierten und gemischten Zeilen in einem Schritt aufbauen:\n");
+     const char* reihenfolgen[] = { "sortiert", "gemischt" };
+     for (int r = 0; r < 2; r++) {
+         katalogFreigeben();
+         csv = fopen(testDatei, "w");
+         if (csv == NULL) {
+             printf("FEHLER: Testdatei %s kann nicht angelegt werden!\n", testDatei);
+             return 1;
+         }
+         // 3000 Zeilen mit 1000 verschiedenen ISBNs, jede ISBN kommt dreimal vor
+         fprintf(csv, "isbn,title\n");
+         for (int i = 0; i < 3000; i++) {
+             int nummer = r == 0 ? i / 3 : (i * 7) % 1000;
+             char isbn[LEN_ISBN];
+             isbnFormatieren(testIsbn((unsigned long)nummer), isbn);
+             fprintf(csv, "\"%s\",\"Band %d \"\"Zeile %d\"\"\"\n", isbn, nummer, i);
+         }
+         fclose(csv);
+
+         int eingelesen = csvDatenEinlesenParallel(testDatei, 4);
+         int anzahlMassen = 0;
+         int hoeheMassen = avlBaumPruefen(wurzel, &anzahlMassen);
+
+         // Vergleichsbaum durch einzelnes Einfügen in Dateireihenfolge (erster Eintrag gilt)
+         Buch* vergleich = NULL;
+         for (int i = 0; i < 3000; i++) {
+             int nummer = r == 0 ? i / 3 : (i * 7) % 1000;
+             char vergleichsTitel[64];
+             snprintf(vergleichsTitel, sizeof(vergleichsTitel), "Band %d \"Zeile %d\"", nummer, i);
+             vergleich = buchEinfuegen(vergleich, testIsbn((unsigned long)nummer), vergleichsTitel);
+         }
 
-         // Titel aus dem Binärbaum abrufen
-         Buch* buch = buchNachIsbnSuchen(wurzel, ausleihen[anzahlAusleihen].isbn);
-         if (buch != NULL) {
-             strncpy(ausleihen[anzahlAusleihen].titel, buch->titel, MAX_TITEL_LAENGE - 1);
-             ausleihen[anzahlAusleihen].titel[MAX_TITEL_LAENGE - 1] = '\0';
+         if (eingelesen != 3000 || hoeheMassen < 0 || anzahlMassen != 1000 || hoeheMassen != hoeheFuerAnzahl(1000)) {
+             printf("FEHLER: %s: %d Zeilen, %d Knoten, Höhe %d!\n", reihenfolgen[r], eingelesen, anzahlMassen, hoeheMassen);
+             return 1;
+         }
+         for (int nummer = 0; nummer < 1000; nummer++) {
+             Buch* buch = buchNachIsbnSuchen(wurzel, testIsbn((unsigned long)nummer));
+             Buch* erwartet = buchNachIsbnSuchen(vergleich, testIsbn((unsigned long)nummer));
+             if (buch == NULL || erwartet == NULL || strcmp(buchTitel(buch), buchTitel(erwartet)) != 0) {
+                 printf("FEHLER: %s: Buch Nummer %d fehlt oder hat nicht den Titel der ersten Zeile!\n", reihenfolgen[r], nummer);
+                 return 1;
+             }
+         }
+         printf("%s: %d Zeilen, %d Bücher, Baumhöhe %d, erster Eintrag gilt\n", reihenfolgen[r], eingelesen,
+                anzahlMassen, hoeheMassen);
+     }
+     remove(testDatei);
+
+     printf("\n15. Katalog-Schnappschuss schreiben, laden und verwerfen:\n");
+     const char* kopieCsv = "/tmp/library_test_katalog.csv";
+     const char* schnappschuss = "/tmp/library_test_katalog.snap";
+     DateiAbbild original;
+     csv = fopen(kopieCsv, "wb");
+     if (csv == NULL || !dateiAbbilden(CSV_DATEI, &original)) {
+         printf("FEHLER: Kopie von %s kann nicht angelegt werden!\n", CSV_DATEI);
+         return 1;
+     }
+     fwrite(original.daten, 1, original.groesse, csv);
+     fclose(csv);
+     dateiAbbildFreigeben(&original);
+     remove(schnappschuss);
+
+     katalogFreigeben();
+     katalogLaden(kopieCsv, schnappschuss);
+     unsigned long pruefsummeCsv = katalogPruefsumme();
+     katalogFreigeben();
+     if (!schnappschussLaden(schnappschuss, kopieCsv)) {
+         printf("FEHLER: Der gerade geschriebene Schnappschuss wird nicht geladen!\n");
+         return 1;
+     }
+     anzahlKnoten = 0;
+     if (katalogPruefsumme() != pruefsummeCsv || avlBaumPruefen(wurzel, &anzahlKnoten) < 0 ||
+         (unsigned int)anzahlKnoten != titelIndex.anzahlBuecher) {
+         printf("FEHLER: Der Katalog aus dem Schnappschuss weicht vom eingelesenen ab!\n");
+         return 1;
+     }
+     for (int i = 0; i < (int)(sizeof(suchbegriffe) / sizeof(suchbegriffe[0])); i++) {
+         char erwartet[MAXRESULTS][LEN_ISBN];
+         char mitIndex[MAXRESULTS][LEN_ISBN];
+         int anzahlErwartet = büchernachTitelSuchenIterativ(wurzel, suchbegriffe[i], erwartet, MAXRESULTS);
+         int anzahlIndex = katalogTitelSuchen(suchbegriffe[i], mitIndex, MAXRESULTS);
+         int gleich = anzahlErwartet == anzahlIndex;
+         for (int j = 0; gleich && j < anzahlErwartet; j++) {
+             gleich = strcmp(erwartet[j], mitIndex[j]) == 0;
+         }
+         if (!gleich) {
+             printf("FEHLER: Titelsuche nach '%s' im Schnappschuss weicht ab!\n", suchbegriffe[i]);
+             return 1;
+         }
+     }
+     printf("%u Bücher aus dem Schnappschuss, identisch zur CSV-Datei\n", titelIndex.anzahlBuecher);
+
+     // Titel-Pool und Index verlassen beim Verändern die Abbildung
+     wurzel = buchEinfuegen(wurzel, testIsbn(0), "Nachgetragenes Buch");
+     titelIndexAufbauen();
+     Buch* nachgetragen = buchNachIsbnSuchen(wurzel, testIsbn(0));
+     if (nachgetragen == NULL || strcmp(buchTitel(nachgetragen), "Nachgetragenes Buch") != 0 ||
+         titelIndex.anzahlBuecher != (unsigned int)anzahlKnoten + 1 || imKatalogAbbild(titelPool.daten)) {
+         printf("FEHLER: Einfügen nach dem Laden des Schnappschusses fehlgeschlagen!\n");
+         return 1;
+     }
+     printf("Einfügen nach dem Laden: Titel-Pool und Index in eigenem Speicher\n");
+
+     // Neue Änderungszeit bei gleichem Inhalt: Prüfsumme entscheidet
+     katalogFreigeben();
+     struct timespec zeiten[2] = { { 0, UTIME_OMIT }, { 1000000000, 0 } };
+     utimensat(AT_FDCWD, kopieCsv, zeiten, 0);
+     int geladenNachTouch = schnappschussLaden(schnappschuss, kopieCsv);
+     katalogFreigeben();
+
+     // Gleiche Größe, anderer Inhalt
+     csv = fopen(kopieCsv, "r+b");
+     fseek(csv, -2, SEEK_END);
+     int zeichen = fgetc(csv);
+     fseek(csv, -2, SEEK_END);
+     fputc(zeichen == 'x' ? 'y' : 'x', csv);
+     fclose(csv);
+     int geladenNachAenderung = schnappschussLaden(schnappschuss, kopieCsv);
+     katalogFreigeben();
+
+     // Abgeschnittener Schnappschuss (zur CSV-Datei passend neu geschrieben)
+     katalogLaden(kopieCsv, schnappschuss);
+     katalogFreigeben();
+     struct stat info;
+     stat(schnappschuss, &info);
+     truncate(schnappschuss, info.st_size / 2);
+     int geladenNachKuerzen = schnappschussLaden(schnappschuss, kopieCsv);
+     katalogFreigeben();
+
+     // Beschädigter Inhalt bei intaktem Kopf: je ein Byte in einem Posting, im
+     // Abschluss eines Titels und in einem Titel-Offset verändert
+     int geladenNachBeschaedigung = 0;
+     for (int fall = 0; fall < 3; fall++) {
+         katalogLaden(kopieCsv, schnappschuss);
+         katalogFreigeben();
+         SchnappschussKopf snapKopf;
+         unsigned long long snapOffset = 0;
+         int datei = open(schnappschuss, O_RDWR);
+         if (datei < 0 || pread(datei, &snapKopf, sizeof(snapKopf), 0) != (ssize_t)sizeof(snapKopf) ||
+             pread(datei, &snapOffset, sizeof(snapOffset), (off_t)(snapKopf.offsetsAnfang + sizeof(snapOffset))) !=
+                 (ssize_t)sizeof(snapOffset)) {
+             printf("FEHLER: Schnappschuss kann nicht gelesen werden!\n");
+             return 1;
+         }
+         off_t stelle;
+         if (fall == 0) {
+             stelle = (off_t)(snapKopf.postingsAnfang + 3); // höchstes Byte des ersten Postings
+         } else if (fall == 1) {
+             stelle = (off_t)(snapKopf.poolAnfang + snapOffset - 1); // '\0' am Ende des ersten Titels
          } else {
-             strcpy(ausleihen[anzahlAusleihen].titel, "Unbekanntes Buch");
+             stelle = (off_t)(snapKopf.offsetsAnfang + sizeof(snapOffset) + 3); // Offset des zweiten Titels
          }
-
-         // Ausleihdatum einlesen
-         fscanf(datei, "%ld\n", &ausleihen[anzahlAusleihen].ausleihDatum);
-
-         anzahlAusleihen++;
+         unsigned char byte = 0;
+         pread(datei, &byte, 1, stelle);
+         byte ^= 0x40;
+         pwrite(datei, &byte, 1, stelle);
+         close(datei);
+         geladenNachBeschaedigung |= schnappschussLaden(schnappschuss, kopieCsv);
+         katalogFreigeben();
      }
 
-     fclose(datei);
- }
-
- /**
-  * Speichert die Ausleihdaten in der Datei
-  */
- void ausleihenSpeichern() {
-     FILE* datei = fopen(AUSLEIHDATEI, "w");
-
-     // Prüfen, ob die Datei geöffnet werden konnte
-     if (datei == NULL) {
-         printf("Fehler beim Öffnen der Ausleihdatei zum Schreiben!\n");
-         return;
+     printf("Neue Änderungszeit, gleicher Inhalt: %s\n", geladenNachTouch ? "geladen" : "verworfen");
+     printf("Geänderter Inhalt: %s\n", geladenNachAenderung ? "geladen" : "verworfen");
+     printf("Abgeschnittene Datei: %s\n", geladenNachKuerzen ? "geladen" : "verworfen");
+     printf("Beschädigte Postings, Titel und Offsets: %s\n", geladenNachBeschaedigung ? "geladen" : "verworfen");
+     remove(kopieCsv);
+     remove(schnappschuss);
+     if (!geladenNachTouch || geladenNachAenderung || geladenNachKuerzen || geladenNachBeschaedigung || wurzel != NULL) {
+         printf("FEHLER: Schnappschuss falsch als gültig oder veraltet erkannt!\n");
+         return 1;
      }
 
-     // Ausleihen speichern
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         fprintf(datei, "%s\n%ld\n", ausleihen[i].isbn, ausleihen[i].ausleihDatum);
+     printf("\n16. ISBNs prüfen und in ISBN-13 umwandeln:\n");
+     struct {
+         const char* text;
+         uint64_t erwartet;      // 0 = ungültig
+     } isbnFaelle[] = {
+         { "9783161484100", 9783161484100ULL },
+         { "978-3-16-148410-0", 9783161484100ULL },
+         { "3-16-148410-X", 9783161484100ULL },  // ISBN-10 derselben Ausgabe
+         { "316148410x", 9783161484100ULL },
+         { "3161484100", 0 },                    // Prüfziffer passt nicht
+         { "080442957X", 9780804429573ULL },     // ISBN-10 mit Prüfziffer X
+         { "0-8044-2957-x", 9780804429573ULL },
+         { "9783161484101", 0 },                 // falsche Prüfziffer
+         { "9773161484105", 0 },                 // weder 978 noch 979
+         { "97831614841000", 0 },                // 14 Ziffern
+         { "X804429570", 0 },                    // X nur als letzte Ziffer
+         { "1714562059", 0 },
+         { "", 0 },
+     };
+     for (int i = 0; i < (int)(sizeof(isbnFaelle) / sizeof(isbnFaelle[0])); i++) {
+         uint64_t isbn = 0;
+         int gueltig = isbnLesen(isbnFaelle[i].text, strlen(isbnFaelle[i].text), &isbn);
+         if (gueltig != (isbnFaelle[i].erwartet != 0) || (gueltig && isbn != isbnFaelle[i].erwartet)) {
+             printf("FEHLER: ISBN '%s' falsch gelesen!\n", isbnFaelle[i].text);
+             return 1;
+         }
      }
+     printf("%d Fälle korrekt\n", (int)(sizeof(isbnFaelle) / sizeof(isbnFaelle[0])));
 
-     fclose(datei);
- }
-
- /* Implementierung der öffentlichen Funktionen */
-
- /**
-  * Initialisiert die Bibliothek: Lädt die Bücher und Ausleihdaten
-  */
- void init() {
-     // Bücher aus CSV-Datei laden
-     csvDateiEinlesen();
+     printf("\n17. ISBN-Hashindex gegen Baumsuche prüfen:\n");
+     katalogLaden(CSV_DATEI, SCHNAPPSCHUSS_DATEI);
+     if (!isbnHash.gueltig || isbnHash.anzahl != titelIndex.anzahlBuecher) {
+         printf("FEHLER: Der ISBN-Hashindex wurde nicht aufgebaut!\n");
+         return 1;
+     }
+     size_t laengsteSuche = 0;
+     for (size_t platz = 0; platz <= isbnHash.maske; platz++) {
+         if (isbnHash.eintraege[platz].buch != NULL) {
+             size_t abstand = (platz - isbnHashPlatz(isbnHash.eintraege[platz].isbn)) & isbnHash.maske;
+             laengsteSuche = abstand > laengsteSuche ? abstand : laengsteSuche;
+         }
+     }
+     for (unsigned int i = 0; i < titelIndex.anzahlBuecher; i++) {
+         uint64_t isbn = titelIndex.buecher[i]->isbn;
+         // Treffer sowie die Nachbarn jeder ISBN, die meist nicht im Katalog sind
+         for (uint64_t probe = isbn - 1; probe <= isbn + 1; probe++) {
+             if (isbnHashSuchen(probe) != buchNachIsbnSuchen(wurzel, probe)) {
+                 printf("FEHLER: Hashindex und Baum liefern für ISBN %llu verschiedene Bücher!\n", (unsigned long long)probe);
+                 return 1;
+             }
+         }
+     }
+     // Kleine, zu 7/8 gefüllte Tabellen: Ketten reichen oft über das Tabellenende hinaus
+     size_t gesamtPlaetze = isbnHash.maske + 1;
+     size_t gesamtAnzahl = isbnHash.anzahl;
+     for (int durchlauf = 0; durchlauf < 200; durchlauf++) {
+         katalogFreigeben();
+         for (int i = 0; i < 112; i++) {
+             wurzel = buchEinfuegen(wurzel, testIsbn((unsigned long)(rand() % 1000000)), "Klein");
+         }
+         isbnHashAufbauen();
+         for (uint64_t probe = testIsbn(0) - 10; probe < testIsbn(1000000); probe += 10) {
+             if (isbnHashSuchen(probe) != buchNachIsbnSuchen(wurzel, probe)) {
+                 printf("FEHLER: Hashindex eines kleinen Katalogs weicht für ISBN %llu ab!\n", (unsigned long long)probe);
+                 return 1;
+             }
+         }
+     }
+     katalogFreigeben();
+     katalogLaden(CSV_DATEI, SCHNAPPSCHUSS_DATEI);
 
-     // Ausleihdaten laden
+     wurzel = buchEinfuegen(wurzel, testIsbn(0), "Nachgetragenes Buch");
+     if (isbnHash.gueltig || katalogBuchSuchen(testIsbn(0)) == NULL) {
+         printf("FEHLER: Nach dem Einfügen wird der veraltete Hashindex verwendet!\n");
+         return 1;
+     }
+     printf("%zu Bücher auf %zu Plätzen, längste Verschiebung %zu, identisch zur Baumsuche\n",
+            gesamtAnzahl, gesamtPlaetze, laengsteSuche);
+     printf("200 kleine Kataloge mit 112 Büchern auf 128 Plätzen: identisch zur Baumsuche\n");
+
+     printf("\n18. ISBN-Folge (Eytzinger-Reihenfolge) gegen binäre Suche prüfen:\n");
+     // Kataloge mit 0 bis 70 Büchern decken volle und unvollständige letzte Ebenen ab
+     for (int groesse = 0; groesse <= 70; groesse++) {
+         katalogFreigeben();
+         for (int i = 0; i < groesse; i++) {
+             wurzel = buchEinfuegen(wurzel, testIsbn((unsigned long)i * 3 + 1), "Folge");
+         }
+         titelIndexAufbauen();
+         for (int i = 0; i <= groesse * 3 + 2; i++) {
+             // Anzahl der Bücher j mit j * 3 + 1 < i
+             unsigned int erwartet = (unsigned int)((i + 1) / 3 < groesse ? (i + 1) / 3 : groesse);
+             if (!isbnFolge.gueltig || isbnFolgeUntergrenze(testIsbn((unsigned long)i)) != erwartet) {
+                 printf("FEHLER: ISBN-Folge mit %d Büchern liefert für Nummer %d eine falsche Position!\n", groesse, i);
+                 return 1;
+             }
+         }
+     }
+     katalogFreigeben();
+     katalogLaden(CSV_DATEI, SCHNAPPSCHUSS_DATEI);
+     isbnHash.gueltig = 0;   // katalogBuchSuchen verwendet dann die ISBN-Folge
+     for (unsigned int i = 0; i < titelIndex.anzahlBuecher; i++) {
+         uint64_t isbn = titelIndex.buecher[i]->isbn;
+         for (uint64_t probe = isbn - 1; probe <= isbn + 1; probe++) {
+             unsigned int unten = 0;
+             unsigned int oben = titelIndex.anzahlBuecher;
+             while (unten < oben) {
+                 unsigned int mitte = unten + (oben - unten) / 2;
+                 if (titelIndex.buecher[mitte]->isbn < probe) {
+                     unten = mitte + 1;
+                 } else {
+                     oben = mitte;
+                 }
+             }
+             if (isbnFolgeUntergrenze(probe) != unten || katalogBuchSuchen(probe) != buchNachIsbnSuchen(wurzel, probe)) {
+                 printf("FEHLER: ISBN-Folge weicht für ISBN %llu von der binären Suche ab!\n", (unsigned long long)probe);
+                 return 1;
+             }
+         }
+     }
+     printf("Kataloge mit 0 bis 70 Büchern und %u Bücher aus books.csv: identisch\n", titelIndex.anzahlBuecher);
+
+     printf("\n19. Ausleih-Index beim Ausleihen und Zurückgeben prüfen:\n");
+     // Ab hier liegen die Ausleihdateien in einem temporären Verzeichnis, damit
+     // die Ausleihen des Benutzers auch bei einem Fehler unverändert bleiben
+     char ausleihVerzeichnis[] = "/tmp/bib_testXXXXXX";
+     char bisher[4096];
+     if (getcwd(bisher, sizeof(bisher)) == NULL || mkdtemp(ausleihVerzeichnis) == NULL ||
+         chdir(ausleihVerzeichnis) != 0) {
+         printf("FEHLER: Temporäres Verzeichnis konnte nicht angelegt werden!\n");
+         return 1;
+     }
      ausleihenLaden();
- }
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     int offenJe[20] = { 0 };
+     for (int schritt = 0; schritt < 20000; schritt++) {
+         int nummer = rand() % 20;
+         uint64_t isbn = testIsbn((unsigned long)nummer);
+         // Bis zu 300 offene Ausleihen, damit der Speicher über die Anfangskapazität wächst
+         if (anzahlAusleihen < 300 && (anzahlAusleihen == 0 || rand() % 2 == 0)) {
+             if (!ausleihenReservieren(anzahlAusleihen + 1)) {
+                 printf("FEHLER: Zu wenig Speicher!\n");
+                 return 1;
+             }
+             Ausleihe* ausleihe = &ausleihen[anzahlAusleihen];
+             ausleihe->isbn = isbn;
+             ausleihe->ausleihDatum = schritt;
+             ausleihe->leser = 0;
+             if (!ausleiheIndizieren(anzahlAusleihen)) {
+                 printf("FEHLER: Ausleihe konnte nicht eingetragen werden!\n");
+                 return 1;
+             }
+             anzahlAusleihen++;
+             offenJe[nummer]++;
+         } else {
+             int position = ausleiheSuchen(isbn);
+             if ((position >= 0) != (offenJe[nummer] > 0)) {
+                 printf("FEHLER: Ausleih-Index findet ISBN %llu falsch!\n", (unsigned long long)isbn);
+                 return 1;
+             }
+             if (position >= 0) {
+                 ausleiheEntfernen(position);
+                 offenJe[nummer]--;
+             }
+         }
 
- /**
-  * Sucht nach Büchern mit einem bestimmten Titel
-  * @param titel Zu suchender Titel (Teil des Titels)
-  * @param isbnListe Array, das die ISBNs der gefundenen Bücher aufnehmen soll
-  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse
-  */
- void nachTitelSuchen(char* titel, char isbnListe[][LEN_ISBN], int maxResults) {
-     // Alle Einträge in der ISBN-Liste auf leere Strings setzen
-     for (int i = 0; i < maxResults; i++) {
-         isbnListe[i][0] = '\0';
+         // Jede Kette enthält alle Ausleihen ihrer ISBN in Ausleihreihenfolge
+         size_t isbnsImIndex = 0;
+         for (int j = 0; j < 20; j++) {
+             AusleihIndexEintrag* eintrag = ausleihIndexFinden(&ausleihIndex, testIsbn((unsigned long)j));
+             int laenge = 0;
+             int letzte = -1;
+             for (int i = eintrag != NULL ? eintrag->erste : -1; i >= 0; i = ausleihIndex.naechste[i]) {
+                 if (ausleihen[i].isbn != testIsbn((unsigned long)j) || ausleihIndex.vorherige[i] != letzte ||
+                     (letzte >= 0 && ausleihen[letzte].ausleihDatum >= ausleihen[i].ausleihDatum)) {
+                     laenge = -1;
+                     break;
+                 }
+                 letzte = i;
+                 laenge++;
+             }
+             if (laenge != offenJe[j] || (eintrag != NULL && eintrag->letzte != letzte)) {
+                 printf("FEHLER: Ausleih-Index nach Schritt %d für ISBN %llu inkonsistent!\n",
+                        schritt, (unsigned long long)testIsbn((unsigned long)j));
+                 return 1;
+             }
+             isbnsImIndex += eintrag != NULL;
+         }
+         if (isbnsImIndex != ausleihIndex.anzahl) {
+             printf("FEHLER: Ausleih-Index enthält %zu statt %zu ISBNs!\n", ausleihIndex.anzahl, isbnsImIndex);
+             return 1;
+         }
      }
+     printf("20000 zufällige Ausleihen und Rückgaben: Index stimmt mit den Ausleihen überein\n");
 
-     // Rekursive Suche im Binärbaum durchführen
-     int gefunden = büchernachTitelSuchenRekursiv(wurzel, titel, isbnListe, maxResults, 0);
-
-     // Ausgabe, wie viele Bücher gefunden wurden
-     printf("Es wurden %d Bücher mit dem Titel '%s' gefunden.\n", gefunden, titel);
-     for (int i = 0; i < gefunden; i++) {
-         // Buch im Binärbaum finden, um den kompletten Titel auszugeben
-         Buch* buch = buchNachIsbnSuchen(wurzel, isbnListe[i]);
-         if (buch != NULL) {
-             printf("%d. ISBN: %s, Titel: %s\n", i + 1, isbnListe[i], buch->titel);
+     // Mehr Ausleihen als die früheren 100 Plätze speichern und wieder laden
+     anzahlAusleihen = 0;
+     for (int i = 0; i < 1000; i++) {
+         if (!ausleihenReservieren(anzahlAusleihen + 1)) {
+             printf("FEHLER: Zu wenig Speicher!\n");
+             return 1;
          }
+         ausleihen[i].isbn = testIsbn((unsigned long)(i % 700));
+         ausleihen[i].ausleihDatum = 1700000000 + i;
+         ausleihen[i].leser = 0;
+         anzahlAusleihen++;
      }
- }
-
- /**
-  * Sucht nach einem Buch mit einer bestimmten ISBN
-  * @param isbn Zu suchende ISBN
-  * @param isbnListe Array, das die ISBN des gefundenen Buches aufnehmen soll
-  * @param maxResults Maximale Anzahl zurückzugebender Ergebnisse (hier immer 1)
-  */
- void nachIsbnSuchen(char* isbn, char isbnListe[][LEN_ISBN], int maxResults) {
-     // Alle Einträge in der ISBN-Liste auf leere Strings setzen
-     for (int i = 0; i < maxResults; i++) {
-         isbnListe[i][0] = '\0';
+     ausleihenSpeichern();
+     ausleihenLaden();
+     int geladenOk = anzahlAusleihen == 1000;
+     for (int i = 0; geladenOk && i < 1000; i++) {
+         geladenOk = ausleihen[i].isbn == testIsbn((unsigned long)(i % 700)) &&
+                     ausleihen[i].ausleihDatum == 1700000000 + i &&
+                     ausleiheSuchen(ausleihen[i].isbn) == i % 700;
      }
-
-     // Buch im Binärbaum suchen
-     Buch* buch = buchNachIsbnSuchen(wurzel, isbn);
-
-     // Wenn ein Buch gefunden wurde, die ISBN in die Liste eintragen
-     if (buch != NULL) {
-         strncpy(isbnListe[0], buch->isbn, LEN_ISBN - 1);
-         isbnListe[0][LEN_ISBN - 1] = '\0';
-         printf("Buch gefunden: ISBN: %s, Titel: %s\n", buch->isbn, buch->titel);
-     } else {
-         printf("Kein Buch mit der ISBN '%s' gefunden.\n", isbn);
+     if (!geladenOk) {
+         printf("FEHLER: 1000 gespeicherte Ausleihen wurden nicht unverändert geladen!\n");
+         return 1;
      }
- }
+     printf("1000 Ausleihen gespeichert und geladen: identisch\n");
 
- /**
-  * Leiht ein Buch aus
-  * @param isbn ISBN des auszuleihenden Buches
-  * @return 1 bei Erfolg, 0 bei Misserfolg
-  */
- int buchAusleihen(char* isbn) {
-     // Prüfen, ob das Buch existiert
-     Buch* buch = buchNachIsbnSuchen(wurzel, isbn);
-     if (buch == NULL) {
-         printf("Fehler: Das Buch mit der ISBN '%s' existiert nicht!\n", isbn);
-         return 0;
+     printf("\n20. Ausleihjournal nach abgebrochenem Schreiben wiederherstellen:\n");
+     // Stand nach jedem der 200 Journaleinträge (Stand 0: leere Ausleihdatei)
+     Ausleihe* staende[201];
+     int standAnzahl[201];
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     if (!ausleihenSpeichern()) {
+         printf("FEHLER: Ausleihdatei konnte nicht geschrieben werden!\n");
+         return 1;
      }
-
-     // Prüfen, ob noch Platz für weitere Ausleihen ist
-     if (anzahlAusleihen >= MAX_AUSLEIHEN) {
-         printf("Fehler: Maximale Anzahl an Ausleihen erreicht!\n");
-         return 0;
+     for (int schritt = 0; schritt <= 200; schritt++) {
+         if (schritt > 0) {
+             uint64_t isbn = testIsbn((unsigned long)(rand() % 15));
+             int position = ausleiheSuchen(isbn);
+             int ok = position >= 0 && rand() % 3 == 0 ? rueckgabeBuchen(0, isbn)
+                                                       : ausleiheAnlegen(isbn, 1700000000 + schritt, 0);
+             if (!ok) {
+                 printf("FEHLER: Ausleihe oder Rückgabe konnte nicht protokolliert werden!\n");
+                 return 1;
+             }
+         }
+         staende[schritt] = (Ausleihe*)malloc((size_t)(anzahlAusleihen + 1) * sizeof(Ausleihe));
+         if (staende[schritt] == NULL) {
+             printf("FEHLER: Zu wenig Speicher!\n");
+             return 1;
+         }
+         memcpy(staende[schritt], ausleihen, (size_t)anzahlAusleihen * sizeof(Ausleihe));
+         standAnzahl[schritt] = anzahlAusleihen;
      }
 
-     // Prüfen, ob das Buch bereits ausgeliehen ist (obwohl laut Aufgabe unbegrenzt viele Exemplare vorhanden sind)
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         if (strcmp(ausleihen[i].isbn, isbn) == 0) {
-             printf("Hinweis: Das Buch ist bereits ausgeliehen, aber da unbegrenzt viele Exemplare vorhanden sind, wird es erneut ausgeliehen.\n");
-             break;
+     DateiAbbild journalAbbild;
+     if (!dateiAbbilden(AUSLEIHJOURNAL, &journalAbbild) ||
+         journalAbbild.groesse != sizeof(JournalKopf) + 200 * sizeof(JournalEintrag)) {
+         printf("FEHLER: Das Ausleihjournal hat nicht 200 Einträge!\n");
+         return 1;
+     }
+     char* journalInhalt = (char*)malloc(journalAbbild.groesse);
+     size_t journalGroesse = journalAbbild.groesse;
+     memcpy(journalInhalt, journalAbbild.daten, journalGroesse);
+     dateiAbbildFreigeben(&journalAbbild);
+
+     // Journal nach jedem Eintrag und mitten in Einträgen abschneiden, dann laden
+     const size_t schnitte[] = { 0, 1, 13, sizeof(JournalEintrag) - 1 };
+     int ausgabe = ausgabeUnterdruecken();
+     for (int eintraege = 0; eintraege <= 200; eintraege++) {
+         for (int s = 0; s < (int)(sizeof(schnitte) / sizeof(schnitte[0])); s++) {
+             size_t laenge = sizeof(JournalKopf) + (size_t)eintraege * sizeof(JournalEintrag) + schnitte[s];
+             if (eintraege == 200 && schnitte[s] > 0) {
+                 break;
+             }
+             FILE* datei = fopen(AUSLEIHJOURNAL, "wb");
+             if (datei == NULL || fwrite(journalInhalt, 1, laenge, datei) != laenge || fclose(datei) != 0) {
+                 printf("FEHLER: Ausleihjournal konnte nicht geschrieben werden!\n");
+                 return 1;
+             }
+             ausleihenLaden();
+             struct stat info;
+             if (anzahlAusleihen != standAnzahl[eintraege] || !ausleihenGleich(staende[eintraege], anzahlAusleihen) ||
+                 stat(AUSLEIHJOURNAL, &info) != 0 ||
+                 (size_t)info.st_size != sizeof(JournalKopf) + (size_t)eintraege * sizeof(JournalEintrag)) {
+                 ausgabeWiederherstellen(ausgabe);
+                 printf("FEHLER: Journal mit %d Einträgen und %zu Bytes Rest falsch wiederhergestellt!\n",
+                        eintraege, schnitte[s]);
+                 return 1;
+             }
          }
      }
 
-     // Buch ausleihen
-     strncpy(ausleihen[anzahlAusleihen].isbn, isbn, LEN_ISBN - 1);
-     ausleihen[anzahlAusleihen].isbn[LEN_ISBN - 1] = '\0';
-
-     strncpy(ausleihen[anzahlAusleihen].titel, buch->titel, MAX_TITEL_LAENGE - 1);
-     ausleihen[anzahlAusleihen].titel[MAX_TITEL_LAENGE - 1] = '\0';
+     ausgabeWiederherstellen(ausgabe);
 
-     // Aktuelles Datum als Ausleihdatum festlegen
-     ausleihen[anzahlAusleihen].ausleihDatum = time(NULL);
+     // Nach dem Abschneiden eines halben Eintrags schließen neue Einträge direkt an
+     FILE* teilJournal = fopen(AUSLEIHJOURNAL, "wb");
+     fwrite(journalInhalt, 1, sizeof(JournalKopf) + 100 * sizeof(JournalEintrag) + 7, teilJournal);
+     fclose(teilJournal);
+     ausleihenLaden();
+     ausleiheAnlegen(testIsbn(99), 1800000000, 0);
+     ausleihenLaden();
+     if (anzahlAusleihen != standAnzahl[100] + 1 || ausleihen[anzahlAusleihen - 1].isbn != testIsbn(99) ||
+         !ausleihenGleich(staende[100], standAnzahl[100])) {
+         printf("FEHLER: Eintrag nach wiederhergestelltem Journal ging verloren!\n");
+         return 1;
+     }
 
-     anzahlAusleihen++;
+     // Ein beschädigter Eintrag beendet das Einspielen
+     journalInhalt[sizeof(JournalKopf) + 50 * sizeof(JournalEintrag) + 3] ^= 0x40;
+     teilJournal = fopen(AUSLEIHJOURNAL, "wb");
+     fwrite(journalInhalt, 1, journalGroesse, teilJournal);
+     fclose(teilJournal);
+     ausleihenLaden();
+     journalInhalt[sizeof(JournalKopf) + 50 * sizeof(JournalEintrag) + 3] ^= 0x40;
+     if (anzahlAusleihen != standAnzahl[50] ||
+         !ausleihenGleich(staende[50], anzahlAusleihen)) {
+         printf("FEHLER: Beschädigter Journaleintrag wurde übernommen!\n");
+         return 1;
+     }
 
-     // Ausleihdaten speichern
+     // Absturz nach dem Verdichten, bevor das Journal erneuert wurde: Das alte
+     // Journal passt nicht mehr zur Ausleihdatei und wird nicht erneut eingespielt
+     teilJournal = fopen(AUSLEIHJOURNAL, "wb");
+     fwrite(journalInhalt, 1, journalGroesse, teilJournal);
+     fclose(teilJournal);
+     ausleihenLaden();
      ausleihenSpeichern();
+     teilJournal = fopen(AUSLEIHJOURNAL, "wb");
+     fwrite(journalInhalt, 1, journalGroesse, teilJournal);
+     fclose(teilJournal);
+     ausleihenLaden();
+     if (anzahlAusleihen != standAnzahl[200] ||
+         !ausleihenGleich(staende[200], anzahlAusleihen) || journalEintraege != 0) {
+         printf("FEHLER: Veraltetes Journal wurde nach dem Verdichten erneut eingespielt!\n");
+         return 1;
+     }
 
-     printf("Buch '%s' erfolgreich ausgeliehen.\n", buch->titel);
-     return 1;
- }
-
- /**
-  * Zeigt das Ausleihkonto an
-  * @return Anzahl der ausgeliehenen Bücher
-  */
- int kontoAnzeigen() {
-     // Aktuelle Zeit für Vergleich mit Ausleihdatum
-     time_t jetzt = time(NULL);
-
-     printf("\n=== Ihr Ausleihkonto ===\n");
-     printf("Anzahl ausgeliehener Bücher: %d\n\n", anzahlAusleihen);
-
-     if (anzahlAusleihen == 0) {
-         printf("Sie haben derzeit keine Bücher ausgeliehen.\n");
-     } else {
-         printf("%-14s %-50s %-20s\n", "ISBN", "Titel", "Restliche Ausleihdauer");
-         printf("---------------------------------------------------------------------------------\n");
-
-         for (int i = 0; i < anzahlAusleihen; i++) {
-             // Berechnen der verstrichenen Zeit seit der Ausleihe in Tagen
-             double verstricheneTage = difftime(jetzt, ausleihen[i].ausleihDatum) / (60 * 60 * 24);
-
-             // Berechnen der verbleibenden Ausleihdauer
-             int restlicheTage = AUSLEIHDAUER - (int)verstricheneTage;
-
-             // Anzeigen der Buch-Informationen
-             printf("%-14s %-50s ", ausleihen[i].isbn, ausleihen[i].titel);
-
-             // Warnung, wenn die Ausleihdauer überschritten wurde
-             if (restlicheTage < 0) {
-                 printf("ÜBERFÄLLIG seit %d Tagen!\n", -restlicheTage);
-             } else {
-                 printf("Noch %d Tage\n", restlicheTage);
-             }
+     // Langes Journal wird beim Ausleihen selbständig verdichtet
+     for (int i = 0; i < JOURNAL_VERDICHTEN_AB + 10; i++) {
+         int position = ausleiheSuchen(testIsbn((unsigned long)(i % 15)));
+         if (position >= 0 && i % 2 == 1) {
+             rueckgabeBuchen(0, testIsbn((unsigned long)(i % 15)));
+         } else {
+             ausleiheAnlegen(testIsbn((unsigned long)(i % 15)), 1700000000 + i, 0);
          }
      }
+     int vorLaden = anzahlAusleihen;
+     size_t eintraegeVorLaden = journalEintraege;
+     ausleihenLaden();
+     if (eintraegeVorLaden >= JOURNAL_VERDICHTEN_AB || anzahlAusleihen != vorLaden) {
+         printf("FEHLER: Ausleihjournal wurde nicht verdichtet!\n");
+         return 1;
+     }
+     printf("200 Einträge, an 801 Stellen abgeschnitten, beschädigt und veraltet: korrekt wiederhergestellt\n");
 
-     printf("\n======================\n");
-
-     return anzahlAusleihen;
- }
-
- /**
-  * Gibt ein ausgeliehenes Buch zurück
-  * @param isbn ISBN des zurückzugebenden Buches
-  * @return 1 bei Erfolg, 0 bei Misserfolg
-  */
- int buchZurueckgeben(char* isbn) {
-     // Index des zurückzugebenden Buches suchen
-     int index = -1;
-     for (int i = 0; i < anzahlAusleihen; i++) {
-         if (strcmp(ausleihen[i].isbn, isbn) == 0) {
-             index = i;
-             break;
+     printf("\n21. Gleichzeitige Ausleihen gemeinsam speichern (Group Commit):\n");
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     ausleihenSpeichern();
+     journalFensterSetzen(200);
+     unsigned long long schreibvorgaengeVorher = gruppenCommit.schreibvorgaenge;
+     pthread_t gruppenThreads[GRUPPEN_TEST_THREADS];
+     int gruppenErgebnis[GRUPPEN_TEST_THREADS];
+     for (int t = 0; t < GRUPPEN_TEST_THREADS; t++) {
+         gruppenErgebnis[t] = t;
+         if (pthread_create(&gruppenThreads[t], NULL, gruppenTestThread, &gruppenErgebnis[t]) != 0) {
+             printf("FEHLER: Thread konnte nicht gestartet werden!\n");
+             return 1;
          }
      }
-
-     // Wenn das Buch nicht gefunden wurde
-     if (index == -1) {
-         printf("Fehler: Das Buch mit der ISBN '%s' ist nicht ausgeliehen!\n", isbn);
-         return 0;
+     int gruppenOk = 1;
+     for (int t = 0; t < GRUPPEN_TEST_THREADS; t++) {
+         pthread_join(gruppenThreads[t], NULL);
+         gruppenOk &= gruppenErgebnis[t];
      }
-
-     // Buchname für die Ausgabemeldung speichern
-     char titelKopie[MAX_TITEL_LAENGE];
-     strncpy(titelKopie, ausleihen[index].titel, MAX_TITEL_LAENGE - 1);
-     titelKopie[MAX_TITEL_LAENGE - 1] = '\0';
-
-     // Die Ausleihe an der gefundenen Position durch die letzte Ausleihe ersetzen
-     if (index < anzahlAusleihen - 1) {
-         ausleihen[index] = ausleihen[anzahlAusleihen - 1];
+     journalFensterSetzen(0);
+     int gruppenVorgaenge = GRUPPEN_TEST_THREADS * (GRUPPEN_TEST_AUSLEIHEN + GRUPPEN_TEST_AUSLEIHEN / 2);
+     unsigned long long schreibvorgaenge = gruppenCommit.schreibvorgaenge - schreibvorgaengeVorher;
+     if (!gruppenOk || schreibvorgaenge >= (unsigned long long)gruppenVorgaenge) {
+         printf("FEHLER: Gleichzeitige Ausleihen wurden nicht gemeinsam gespeichert!\n");
+         return 1;
      }
 
-     // Anzahl der Ausleihen verringern
-     anzahlAusleihen--;
+     // Alle bestätigten Ausleihen und Rückgaben müssen nach dem Laden vorhanden sein
+     ausleihenLaden();
+     gruppenOk = anzahlAusleihen == GRUPPEN_TEST_THREADS * (GRUPPEN_TEST_AUSLEIHEN / 2);
+     for (int t = 0; gruppenOk && t < GRUPPEN_TEST_THREADS; t++) {
+         for (int i = 0; gruppenOk && i < GRUPPEN_TEST_AUSLEIHEN; i++) {
+             int position = ausleiheSuchen(testIsbn((unsigned long)(10000 + t * 1000 + i)));
+             gruppenOk = (position >= 0) == (i >= GRUPPEN_TEST_AUSLEIHEN / 2) &&
+                         (position < 0 || ausleihen[position].ausleihDatum == 1700000000 + i);
+         }
+     }
+     if (!gruppenOk) {
+         printf("FEHLER: Gemeinsam gespeicherte Ausleihen wurden nicht korrekt geladen!\n");
+         return 1;
+     }
+     printf("%d Vorgänge aus %d Threads mit %llu fsync-Aufrufen gespeichert und korrekt geladen\n",
+            gruppenVorgaenge, GRUPPEN_TEST_THREADS, schreibvorgaenge);
+
+     // Schlägt das Schreiben des Journals fehl, bleibt weder die Ausleihe noch die
+     // Rückgabe im Speicher (das Journal wird dazu durch eine nur lesbare Datei ersetzt)
+     uint64_t offeneIsbn = testIsbn((unsigned long)(10000 + GRUPPEN_TEST_AUSLEIHEN - 1)); // von Leser 0
+     int journalFehlerOk = 1;
+     for (int fall = 0; fall < 2 && journalFehlerOk; fall++) {
+         ausleihenSpeichern(); // Neues Journal, Fehlerzustand zurückgesetzt
+         int vorher = anzahlAusleihen;
+         int nurLesen = open(AUSLEIHJOURNAL, O_RDONLY);
+         journalFehlerOk = nurLesen >= 0 && ausleihJournal >= 0 && dup2(nurLesen, ausleihJournal) >= 0;
+         close(nurLesen);
+         int fehlerAusgabe = ausgabeUnterdruecken();
+         int gebucht = fall == 0 ? ausleiheAnlegen(testIsbn(99999), 1800000000, 3) : rueckgabeBuchen(0, offeneIsbn);
+         ausgabeWiederherstellen(fehlerAusgabe);
+         journalFehlerOk = journalFehlerOk && !gebucht && anzahlAusleihen == vorher && faelligkeitenPruefen() &&
+                           ausleiheSuchen(testIsbn(99999)) < 0 && leserAusleiheSuchen(0, offeneIsbn) >= 0;
+     }
+     ausleihenSpeichern();
+     if (!journalFehlerOk) {
+         printf("FEHLER: Nicht gespeicherte Ausleihe oder Rückgabe blieb im Speicher!\n");
+         return 1;
+     }
+     printf("Nicht gespeicherte Ausleihe und Rückgabe im Speicher zurückgenommen\n");
+
+     printf("\n22. Binäre Ausleihdatei schreiben, laden und aus der Textdatei übernehmen:\n");
+     // Übernahme der früheren Textdatei; eine ungültige Ausleihe verhindert die Übernahme, statt sie zu verwerfen
+     struct stat dateiInfo;
+     FILE* textDatei = fopen(AUSLEIHTEXTDATEI, "w");
+     fprintf(textDatei, "9780073337975\n1743460680\n123\n1743460681\n9780571273577\n-5\n");
+     fclose(textDatei);
+     remove(AUSLEIHDATEI);
+     remove(AUSLEIHJOURNAL);
+     ausgabe = ausgabeUnterdruecken();
+     ausleihenLaden();
+     int abgelehnt = anzahlAusleihen == 0 && stat(AUSLEIHDATEI, &dateiInfo) != 0 &&
+                     !ausleiheAnlegen(9780073337975ULL, 1743460680, 0) && stat(AUSLEIHDATEI, &dateiInfo) != 0;
+     textDatei = fopen(AUSLEIHTEXTDATEI, "w");
+     fprintf(textDatei, "9780073337975\n1743460680\n9780571273577\n-5\n");
+     fclose(textDatei);
+     ausleihenLaden();
+     ausgabeWiederherstellen(ausgabe);
+     int binaerOk = abgelehnt && anzahlAusleihen == 2 && ausleihen[0].isbn == 9780073337975ULL &&
+                    ausleihen[0].ausleihDatum == 1743460680 && ausleihen[1].isbn == 9780571273577ULL &&
+                    ausleihen[1].ausleihDatum == -5 && stat(AUSLEIHDATEI, &dateiInfo) == 0 &&
+                    (size_t)dateiInfo.st_size == sizeof(AusleihDateiKopf) + 2 * sizeof(AusleihDatensatz);
+     remove(AUSLEIHTEXTDATEI);
+     if (!binaerOk) {
+         printf("FEHLER: Textdatei wurde nicht korrekt in die binäre Ausleihdatei übernommen!\n");
+         return 1;
+     }
 
-     // Ausleihdaten speichern
+     // 5000 Ausleihen mit Lesern und Daten aus dem ganzen Wertebereich speichern und laden
+     anzahlAusleihen = 0;
+     for (int i = 0; i < 5000; i++) {
+         ausleihenReservieren(anzahlAusleihen + 1);
+         ausleihen[i].isbn = testIsbn((unsigned long)(i % 1234));
+         ausleihen[i].ausleihDatum = (time_t)((long long)i * 987654321LL - 2000000000000LL);
+         ausleihen[i].leser = (unsigned int)i * 2654435761u;
+         anzahlAusleihen++;
+     }
+     Ausleihe* binaerStand = (Ausleihe*)malloc(5000 * sizeof(Ausleihe));
+     memcpy(binaerStand, ausleihen, 5000 * sizeof(Ausleihe));
+     ausleihIndexAufbauen();
      ausleihenSpeichern();
+     ausleihenLaden();
+     binaerOk = anzahlAusleihen == 5000 && ausleihenGleich(binaerStand, 5000) && stat(AUSLEIHDATEI, &dateiInfo) == 0 &&
+                (size_t)dateiInfo.st_size == sizeof(AusleihDateiKopf) + 5000 * sizeof(AusleihDatensatz) &&
+                ausleiheSuchen(testIsbn(1233)) == 1233;
+     if (!binaerOk) {
+         printf("FEHLER: 5000 Ausleihen wurden nicht unverändert gespeichert und geladen!\n");
+         return 1;
+     }
 
-     printf("Buch '%s' erfolgreich zurückgegeben.\n", titelKopie);
-     return 1;
- }
+     // Beschädigte und abgeschnittene Dateien werden erkannt und beiseitegelegt
+     DateiAbbild binaerAbbild;
+     dateiAbbilden(AUSLEIHDATEI, &binaerAbbild);
+     size_t binaerGroesse = binaerAbbild.groesse;
+     char* binaerInhalt = (char*)malloc(binaerGroesse);
+     memcpy(binaerInhalt, binaerAbbild.daten, binaerGroesse);
+     dateiAbbildFreigeben(&binaerAbbild);
+     const size_t stellen[] = { 0, 9, offsetof(AusleihDateiKopf, anzahl), sizeof(AusleihDateiKopf) + 5,
+                                binaerGroesse - 1 };
+     char defektPfad[1024];
+     snprintf(defektPfad, sizeof(defektPfad), "%s.defekt", AUSLEIHDATEI);
+     for (int fall = 0; fall <= (int)(sizeof(stellen) / sizeof(stellen[0])); fall++) {
+         int abschneiden = fall == (int)(sizeof(stellen) / sizeof(stellen[0]));
+         if (!abschneiden) {
+             binaerInhalt[stellen[fall]] ^= 0x10;
+         }
+         FILE* binaerDatei = fopen(AUSLEIHDATEI, "wb");
+         fwrite(binaerInhalt, 1, abschneiden ? binaerGroesse - 7 : binaerGroesse, binaerDatei);
+         fclose(binaerDatei);
+         if (!abschneiden) {
+             binaerInhalt[stellen[fall]] ^= 0x10;
+         }
+         ausgabe = ausgabeUnterdruecken();
+         ausleihenLaden();
+         ausgabeWiederherstellen(ausgabe);
+         if (anzahlAusleihen != 0 || stat(defektPfad, &dateiInfo) != 0 || stat(AUSLEIHDATEI, &dateiInfo) == 0) {
+             printf("FEHLER: Beschädigte Ausleihdatei (Fall %d) wurde nicht erkannt!\n", fall);
+             return 1;
+         }
+         remove(defektPfad);
+     }
+     free(binaerInhalt);
+     free(binaerStand);
+     printf("Textdatei übernommen, 5000 Ausleihen identisch geladen, 6 beschädigte Dateien erkannt\n");
 
- /**
-  * Löscht den Eingabepuffer
-  */
- void eingabePufferLeeren() {
-     int c;
-     while ((c = getchar()) != '\n' && c != EOF);
- }
+     printf("\n23. Titel der Ausleihen erst bei der Anzeige nachschlagen:\n");
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     Buch* titelBuch = katalogBuchSuchen(9780073337975ULL);
+     Buch* anderesBuch = katalogBuchSuchen(9780571273577ULL);
+     ausleiheAnhaengen(9780073337975ULL, 1700000000, 0);
+     ausleiheAnhaengen(testIsbn(77), 1700000000, 0);
+     int titelOk = titelBuch != NULL && anderesBuch != NULL && ausleihen[0].buch == KEIN_KNOTEN &&
+                   strcmp(ausleiheTitel(&ausleihen[0]), buchTitel(titelBuch)) == 0 &&
+                   ausleihen[0].buch == knotenNummer(titelBuch);
+     // Ein veralteter Verweis (z. B. nach erneutem Laden des Katalogs) wird erkannt
+     ausleihen[0].buch = titelOk ? knotenNummer(anderesBuch) : KEIN_KNOTEN;
+     titelOk = titelOk && strcmp(ausleiheTitel(&ausleihen[0]), buchTitel(titelBuch)) == 0 &&
+               ausleihen[0].buch == knotenNummer(titelBuch);
+     ausleihen[0].buch = 0xFFFFFFF0u;
+     titelOk = titelOk && strcmp(ausleiheTitel(&ausleihen[0]), buchTitel(titelBuch)) == 0 &&
+               strcmp(ausleiheTitel(&ausleihen[1]), "Unbekanntes Buch") == 0 && ausleihen[1].buch == KEIN_KNOTEN;
+     if (!titelOk) {
+         printf("FEHLER: Titel der Ausleihen wurden falsch nachgeschlagen!\n");
+         return 1;
+     }
+     printf("Verweis erst bei der Anzeige gesetzt, veraltete Verweise und unbekannte Bücher erkannt\n");
 
- /**
-  * Zeigt das Hauptmenü an und gibt die ausgewählte Option zurück
-  * @return ausgewählte Menüoption
-  */
- int menüAnzeigen() {
-     int auswahl = 0;
-
-     printf("\n========== Bibliotheksverwaltung ==========\n");
-     printf("1. Nach Büchern suchen (Titel)\n");
-     printf("2. Nach Büchern suchen (ISBN)\n");
-     printf("3. Buch ausleihen\n");
-     printf("4. Buch zurückgeben\n");
-     printf("5. Ausleihkonto anzeigen\n");
-     printf("6. Programm beenden\n");
-     printf("==========================================\n");
-     printf("Bitte wählen Sie eine Option (1-6): ");
-
-     scanf("%d", &auswahl);
-     eingabePufferLeeren();
-
-     return auswahl;
- }
+     printf("\n24. Ausleihkonten mehrerer Leser getrennt führen:\n");
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     if (!ausleihenSpeichern()) {
+         printf("FEHLER: Ausleihdatei konnte nicht geschrieben werden!\n");
+         return 1;
+     }
+     int leserErwartet[LESER_TEST_LESER][LESER_TEST_ISBNS];
+     memset(leserErwartet, 0, sizeof(leserErwartet));
+     int leserOk = 1;
+     for (int schritt = 0; schritt < 3000 && leserOk; schritt++) {
+         unsigned int leser = (unsigned int)(rand() % LESER_TEST_LESER);
+         int nummer = rand() % LESER_TEST_ISBNS;
+         uint64_t isbn = testIsbn((unsigned long)nummer);
+         if (rand() % 2 == 0 && leserErwartet[leser][nummer] > 0) {
+             leserOk = rueckgabeBuchen(leser, isbn);
+             leserErwartet[leser][nummer]--;
+         } else if (rand() % 4 == 0 && leserErwartet[leser][nummer] == 0) {
+             // Das Buch hat höchstens ein anderer Leser ausgeliehen: Rückgabe wird abgelehnt
+             leserOk = !rueckgabeBuchen(leser, isbn);
+         } else {
+             leserOk = ausleiheAnlegen(isbn, 1700000000 + schritt, leser);
+             leserErwartet[leser][nummer]++;
+         }
+     }
+     leserOk = leserOk && leserKontenPruefen(leserErwartet, 1);
 
- #endif /* Endet den Bereich der im Testmodus auskommentiert wird */
+     // Das Konto zeigt nur die Ausleihen des gewählten Lesers
+     int kontoAusgabe = ausgabeUnterdruecken();
+     int kontoSumme = 0;
+     for (aktuellerLeser = 0; aktuellerLeser < LESER_TEST_LESER; aktuellerLeser++) {
+         kontoSumme += kontoAnzeigen();
+     }
+     aktuellerLeser = 0;
+     int wechselOk = leserWechseln("17") && aktuellerLeser == 17 && !leserWechseln("-1") &&
+                     !leserWechseln("4294967296") && !leserWechseln("3a") && !leserWechseln("") &&
+                     aktuellerLeser == 17;
+     aktuellerLeser = 0;
+     ausgabeWiederherstellen(kontoAusgabe);
+     leserOk = leserOk && kontoSumme == anzahlAusleihen && wechselOk;
+
+     // Nach dem Einspielen des Journals und nach dem Verdichten gehören alle
+     // Ausleihen weiter ihren Lesern
+     int leserVorher = anzahlAusleihen;
+     ausleihenLaden();
+     leserOk = leserOk && anzahlAusleihen == leserVorher && leserKontenPruefen(leserErwartet, 1);
+     ausleihenSpeichern();
+     ausleihenLaden();
+     leserOk = leserOk && anzahlAusleihen == leserVorher && leserKontenPruefen(leserErwartet, 0);
+     if (!leserOk) {
+         printf("FEHLER: Ausleihkonten der Leser sind inkonsistent!\n");
+         return 1;
+     }
+     printf("%d Ausleihen von %zu Lesern, Rückgaben nur aus dem eigenen Konto, nach Laden unverändert\n",
+            anzahlAusleihen, leserIndex.anzahl);
 
- /**
-  * Hauptfunktion des Programms
-  */
- int main() {
-     init();
+     printf("\n25. Überfällige Ausleihen über den Fälligkeits-Heap finden:\n");
+     anzahlAusleihen = 0;
+     ausleihIndexAufbauen();
+     int* keineUeberfaelligen;
+     int faelligOk = naechsteFaelligkeit() < 0 && ueberfaelligeSuchen(2000000000, &keineUeberfaelligen) == 0 &&
+                     keineUeberfaelligen == NULL && ausleihenSpeichern();
+     // Ausleihen in zufälliger Datumsreihenfolge über 100 Tage, Rückgaben an beliebigen Stellen
+     time_t faelligBasis = 1700000000;
+     for (int schritt = 0; schritt < 4000 && faelligOk; schritt++) {
+         if (anzahlAusleihen > 0 && rand() % 3 == 0) {
+             Ausleihe rueckgabe = ausleihen[rand() % anzahlAusleihen];
+             faelligOk = rueckgabeBuchen(rueckgabe.leser, rueckgabe.isbn);
+         } else {
+             faelligOk = ausleiheAnlegen(testIsbn((unsigned long)(rand() % 50)),
+                                         faelligBasis + (time_t)(rand() % (100 * 24 * 60 * 60)),
+                                         (unsigned int)(rand() % 30));
+         }
+         if (schritt % 500 == 0) {
+             faelligOk = faelligOk && faelligkeitenPruefen();
+         }
+     }
+     // Eine Ausleihe ist genau zum zweiten Stichtag fällig und erst danach überfällig
+     faelligOk = faelligOk && ausleiheAnlegen(testIsbn(0), faelligBasis, 0) && faelligkeitenPruefen();
+
+     // Stichtage vor allen, zwischen und nach allen Fälligkeiten
+     time_t faelligTag = (time_t)AUSLEIHDAUER * 24 * 60 * 60;
+     time_t stichtage[] = { faelligBasis, faelligBasis + faelligTag, faelligBasis + faelligTag + 1,
+                            faelligBasis + faelligTag + 30 * 24 * 60 * 60, faelligBasis + faelligTag + 200 * 24 * 60 * 60 };
+     int ueberfaelligAnzahl[5];
+     for (int i = 0; i < 5; i++) {
+         ueberfaelligAnzahl[i] = ueberfaelligePruefen(stichtage[i]);
+         faelligOk = faelligOk && ueberfaelligAnzahl[i] >= 0;
+     }
+     faelligOk = faelligOk && ueberfaelligAnzahl[0] == 0 && ueberfaelligAnzahl[1] == 0 && ueberfaelligAnzahl[2] >= 1 &&
+                 ueberfaelligAnzahl[4] == anzahlAusleihen;
 
-     char results[MAXRESULTS][LEN_ISBN];
+     // Die Wurzel ist die früheste Fälligkeit
+     int naechste = naechsteFaelligkeit();
+     for (int i = 0; faelligOk && i < anzahlAusleihen; i++) {
+         faelligOk = !faelligkeitFrueher(i, naechste);
+     }
 
-     printf("\n\n--- Bibliothek Verwaltungssystem Test ---\n\n");
+     // Nach dem Laden (Aufbau in einem Schritt) gleiche Ergebnisse
+     ausleihenLaden();
+     faelligOk = faelligOk && faelligkeitenPruefen();
+     for (int i = 0; i < 5; i++) {
+         faelligOk = faelligOk && ueberfaelligePruefen(stichtage[i]) == ueberfaelligAnzahl[i];
+     }
 
-     // Ausleihkonto anzeigen
-     printf("1. Ausleihkonto anzeigen:\n");
+     int mahnAusgabe = ausgabeUnterdruecken();
+     int mahnAnzahl = mahnlisteAusgeben(stichtage[3]);
+     int mahnLeer = mahnlisteAusgeben(stichtage[0]);
+     ausgabeWiederherstellen(mahnAusgabe);
+     time_t datum = 0;
+     int datumOk = datumLesen("29.02.2024", &datum) && localtime(&datum)->tm_mday == 29 &&
+                   !datumLesen("30.02.2024", &datum) && !datumLesen("1.13.2024", &datum) &&
+                   !datumLesen("01.01.2024x", &datum) && !datumLesen("", &datum);
+     faelligOk = faelligOk && mahnAnzahl == ueberfaelligAnzahl[3] && mahnLeer == 0 && datumOk;
+
+     // Das Konto meldet eine Ausleihe ab demselben Zeitpunkt als überfällig wie die Mahnliste
+     time_t jetzt = time(NULL);
+     aktuellerLeser = 999;
+     int kontoOk = ausleiheAnlegen(testIsbn(3), jetzt - faelligTag - 60, aktuellerLeser) &&
+                   ueberfaelligePruefen(jetzt) >= 1;
+     int faelligAusgabe = ausgabeUmleiten("konto.txt");
      kontoAnzeigen();
-
-     // Nach Titel suchen
-     printf("\n2. Nach Titel 'science' suchen:\n");
-     nachTitelSuchen("science", results, MAXRESULTS);
-
-     // Wenn keine Bücher mit "science" gefunden, nach "fiction" suchen
-     if (results[0][0] == '\0') {
-         printf("\nAlternativ nach 'fiction' suchen:\n");
-         nachTitelSuchen("fiction", results, MAXRESULTS);
+     ausgabeWiederherstellen(faelligAusgabe);
+     char kontoText[4096] = "";
+     FILE* kontoDatei = fopen("konto.txt", "r");
+     if (kontoDatei != NULL) {
+         kontoText[fread(kontoText, 1, sizeof(kontoText) - 1, kontoDatei)] = '\0';
+         fclose(kontoDatei);
      }
-
-     // Wenn immer noch keine Bücher gefunden, nach leeren String suchen (alle Bücher)
-     if (results[0][0] == '\0') {
-         printf("\nZeige alle verfügbaren Bücher:\n");
-         nachTitelSuchen("", results, MAXRESULTS);
+     kontoOk = kontoOk && strstr(kontoText, "ÜBERFÄLLIG seit 0 Tagen") != NULL &&
+               rueckgabeBuchen(aktuellerLeser, testIsbn(3));
+     aktuellerLeser = 0;
+     remove("konto.txt");
+     faelligOk = faelligOk && kontoOk;
+     if (!faelligOk) {
+         printf("FEHLER: Fälligkeits-Heap liefert falsche überfällige Ausleihen!\n");
+         return 1;
      }
+     printf("%d Ausleihen, Heap nach Rückgaben und Laden gültig, überfällig je Stichtag: %d/%d/%d/%d/%d\n",
+            anzahlAusleihen, ueberfaelligAnzahl[0], ueberfaelligAnzahl[1], ueberfaelligAnzahl[2],
+            ueberfaelligAnzahl[3], ueberfaelligAnzahl[4]);
 
-     // Wenn Bücher gefunden wurden, zwei davon ausleihen
-     if (results[0][0] != '\0') {
-         printf("\n3. Bücher ausleihen:\n");
-         buchAusleihen(results[0]);
-
-         if (results[1][0] != '\0') {
-             buchAusleihen(results[1]);
-         }
-
-         // Ausleihkonto anzeigen
-         printf("\n4. Ausleihkonto nach dem Ausleihen:\n");
-         kontoAnzeigen();
-
-         // Ein Buch zurückgeben
-         printf("\n5. Ein Buch zurückgeben:\n");
-         buchZurueckgeben(results[0]);
-
-         // Ausleihkonto nach Rückgabe anzeigen
-         printf("\n6. Ausleihkonto nach der Rückgabe:\n");
-         kontoAnzeigen();
+     for (int schritt = 0; schritt <= 200; schritt++) {
+         free(staende[schritt]);
+     }
+     free(journalInhalt);
+
+     // Temporäres Verzeichnis der Ausleihdateien entfernen
+     ausleihJournalSchliessen();
+     remove(AUSLEIHDATEI);
+     remove(AUSLEIHJOURNAL);
+     if (chdir(bisher) != 0 || rmdir(ausleihVerzeichnis) != 0) {
+         printf("Hinweis: Temporäres Verzeichnis %s wurde nicht entfernt.\n", ausleihVerzeichnis);
      }
 
      printf("\n--- Test abgeschlossen ---\n\n");
 
     // Speicher freigeben
-    baumFreigeben(wurzel);
-    wurzel = NULL;
+    katalogFreigeben();
+    ausleihenFreigeben();
 
      return 0;
  }
\ No newline at end of file